@@ -15,6 +15,7 @@
 
 #include <arcane/utils/FatalErrorException.h>
 #include <arcane/utils/NumArray.h>
+#include <arcane/utils/PlatformUtils.h>
 
 #include <arcane/VariableTypes.h>
 #include <arcane/IItemFamily.h>
@@ -23,6 +24,7 @@
 #include <arcane/aleph/Aleph.h>
 
 #include "FemUtils.h"
+#include "CsrTripletAccumulator.h"
 #include "IDoFLinearSystemFactory.h"
 #include "arcane_version.h"
 
@@ -38,8 +40,6 @@ enum class eSolverBackend
 
 #include "AlephDoFLinearSystemFactory_axl.h"
 
-#include <map>
-
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -50,51 +50,21 @@ using namespace Arcane;
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Linear system using Aleph.
+ *
+ * Values given by matrixAddValue() are accumulated in a CSR matrix whose
+ * columns are sorted for each row (see CsrTripletAccumulator). The Aleph
+ * matrix is filled from this CSR matrix in (row,column) order which is
+ * needed if we want to reuse the internal structure of the solver.
+ *
+ * Values given by setCSRValues() are read during solve(). If there is no
+ * other value, the CSR matrix is directly built from them row by row.
+ */
 class AlephDoFLinearSystemImpl
 : public TraceAccessor
 , public DoFLinearSystemImpl
 {
-  static constexpr Byte ELIMINATE_NONE = 0;
-  static constexpr Byte ELIMINATE_ROW = 1;
-  static constexpr Byte ELIMINATE_ROW_COLUMN = 2;
-
-  struct RowColumn
-  {
-    Int32 row_id = 0;
-    Int32 column_id = 0;
-    friend bool operator==(RowColumn rc1, RowColumn rc2)
-    {
-      if (rc1.row_id != rc2.row_id)
-        return false;
-      return rc1.column_id == rc2.column_id;
-    }
-    friend bool operator<(RowColumn rc1, RowColumn rc2)
-    {
-      if (rc1.row_id == rc2.row_id)
-        return rc1.column_id < rc2.column_id;
-      return rc1.row_id < rc2.row_id;
-    }
-  };
-
-  struct RowColumnHash
-  {
-    size_t operator()(const RowColumn& s) const noexcept
-    {
-      std::size_t h1 = std::hash<Int32>{}(s.row_id);
-      std::size_t h2 = std::hash<Int32>{}(s.column_id);
-
-      return h1 ^ (h2 << 1);
-    }
-  };
-
-  /*!
-   * \brief Map to store values by Row/Column.
-   *
-   * This map has to be sorted if we want to reuse the internal structure because
-   * the matrix filled has to be in the same order when we reuse it.
-   */
-  using RowColumnMap = std::map<RowColumn, Real>;
-
  public:
 
   // TODO: do not use subDomain() but we need to modify aleph before
@@ -107,6 +77,8 @@ class AlephDoFLinearSystemImpl
   , m_dof_matrix_indexes(VariableBuildInfo(m_dof_family, solver_name + "DoFMatrixIndexes"))
   , m_dof_elimination_info(VariableBuildInfo(m_dof_family, solver_name + "DoFEliminationInfo"))
   , m_dof_elimination_value(VariableBuildInfo(m_dof_family, solver_name + "DoFEliminationValue"))
+  , m_dof_forced_info(VariableBuildInfo(m_dof_family, solver_name + "DoFForcedInfo"))
+  , m_dof_forced_value(VariableBuildInfo(m_dof_family, solver_name + "DoFForcedValue"))
   {
     info() << "Creating AlephDoFLinearSystemImpl()";
   }
@@ -132,6 +104,8 @@ class AlephDoFLinearSystemImpl
     m_aleph_params = _createAlephParam();
     m_dof_elimination_info.fill(ELIMINATE_NONE);
     m_dof_elimination_info.fill(0.0);
+    m_dof_forced_info.fill(false);
+    m_dof_forced_value.fill(0.0);
   }
 
   AlephParams* params() const { return m_aleph_params; }
@@ -168,6 +142,7 @@ class AlephDoFLinearSystemImpl
     //Int32 nb_node = own_nodes.size();
     //Int32 total_nb_node = m_sub_domain->parallelMng()->reduce(Parallel::ReduceSum, nb_node);
     m_dof_matrix_indexes.fill(-1);
+    _resetCSRMatrix();
     AlephIndexing* indexing = m_aleph_kernel->indexing();
     ENUMERATE_ (DoF, idof, own_dofs) {
       DoF dof = *idof;
@@ -198,12 +173,7 @@ class AlephDoFLinearSystemImpl
     if (value == 0.0)
       return;
     if (m_use_value_map) {
-      RowColumn rc{ row.localId(), column.localId() };
-      auto x = m_values_map.find(rc);
-      if (x == m_values_map.end())
-        m_values_map.insert(std::make_pair(rc, value));
-      else
-        x->second += value;
+      m_matrix.add(row, column, value);
     }
     else {
       ItemInfoListView item_list_view(m_dof_family);
@@ -220,7 +190,9 @@ class AlephDoFLinearSystemImpl
       ARCANE_FATAL("Column is null");
     if (!m_use_value_map)
       ARCANE_FATAL("matrixSetValue() is only allowed if 'm_use_value_map' is true");
-    m_forced_set_values_map[{ row.localId(), column.localId() }] = value;
+    m_set_rows.add(row);
+    m_set_columns.add(column);
+    m_set_values.add(value);
   }
 
   void eliminateRow(DoFLocalId row, Real value) override
@@ -248,6 +220,9 @@ class AlephDoFLinearSystemImpl
   void solve() override
   {
     UniqueArray<Real> aleph_result;
+    m_solve_report = {};
+    m_solve_report.linear_system_name = "Aleph";
+    Real build_begin = platform::getRealTime();
 
     // _fillMatrix() may change the values of RHS vector
     // with row or row-column elimination so we has to fill the RHS vector
@@ -258,6 +233,7 @@ class AlephDoFLinearSystemImpl
     info() << "[AlephFem] Assemble matrix ptr=" << m_aleph_matrix;
     m_aleph_matrix->assemble();
     m_aleph_rhs_vector->assemble();
+    m_solve_report.matrix_build_time = platform::getRealTime() - build_begin;
     auto* aleph_solution_vector = m_aleph_solution_vector;
     DoFGroup own_dofs = m_dof_family->allItems().own();
     const Int32 nb_dof = own_dofs.size();
@@ -270,6 +246,7 @@ class AlephDoFLinearSystemImpl
     Int32 nb_iteration = 0;
     Real residual_norm = 0.0;
     info() << "[AlephFem] BEGIN SOLVING WITH ALEPH solver_backend=" << (int)m_solver_backend;
+    Real solve_begin = platform::getRealTime();
 
     m_aleph_matrix->solve(aleph_solution_vector,
                           m_aleph_rhs_vector,
@@ -279,6 +256,13 @@ class AlephDoFLinearSystemImpl
                           false);
     info() << "[AlephFem] END SOLVING WITH ALEPH r=" << residual_norm
            << " nb_iter=" << nb_iteration;
+    m_solve_report.solve_time = platform::getRealTime() - solve_begin;
+    m_solve_report.nb_iteration = nb_iteration;
+    // The residual given by Aleph depends on the backend and is not always
+    // relative, and Aleph does not tell if the solver has converged.
+    m_solve_report.is_convergence_known = false;
+    // Values and (row,column) indexes of the matrix and the three vectors
+    m_solve_report.nb_transferred_byte = m_matrix.values().size() * (sizeof(Real) + 2 * sizeof(Int32)) + 3 * nb_dof * sizeof(Real);
     auto* rhs_vector = m_aleph_kernel->createSolverVector();
     auto* solution_vector = m_aleph_kernel->createSolverVector();
 
@@ -325,19 +309,40 @@ class AlephDoFLinearSystemImpl
     info() << "[Aleph] Clear values of current solver";
     m_dof_elimination_info.fill(ELIMINATE_NONE);
     m_dof_elimination_info.fill(0.0);
-    m_values_map.clear();
-    m_forced_set_values_map.clear();
+    m_dof_forced_info.fill(false);
+    m_dof_forced_value.fill(0.0);
     _computeMatrixInfo();
   }
 
   void setCSRValues(const CSRFormatView& csr_view) override
   {
-    ARCANE_THROW(NotImplementedException,"");
+    if (!m_use_value_map)
+      ARCANE_FATAL("setCSRValues() is only allowed if 'm_use_value_map' is true");
+    // The values are read during solve()
+    m_csr_view = csr_view;
+    m_has_csr_view = true;
   }
 
-  bool hasSetCSRValues() const { return false; }
+  bool hasSetCSRValues() const override { return true; }
+  void setCSRValues64(const CSRFormatView64&) override
+  {
+    ARCANE_THROW(NotImplementedException, "CSR matrix with 64-bit row offsets");
+  }
+  bool hasSetCSRValues64() const override { return false; }
   void setRunner(Runner* r) override { m_runner = r; }
   Runner* runner() const { return m_runner; }
+  void setBlockSize(Int32) override {}
+  void setLinearOperator(IDoFLinearOperator*) override
+  {
+    ARCANE_THROW(NotImplementedException, "Matrix-free linear operator");
+  }
+  bool hasSetLinearOperator() const override { return false; }
+  void solveMultipleRhs(VariableDoFArrayReal&, VariableDoFArrayReal&) override
+  {
+    ARCANE_THROW(NotImplementedException, "Solve with multiple right hand sides");
+  }
+  bool hasSolveMultipleRhs() const override { return false; }
+  const SolveReport& solveReport() const override { return m_solve_report; }
 
  private:
 
@@ -380,50 +385,51 @@ class AlephDoFLinearSystemImpl
 
   CSRFormatView& getCSRValues() override
   {
-    ARCANE_THROW(NotImplementedException, "");
-  }
-
-  VariableDoFReal& getForcedValue() override
-  {
-    ARCANE_THROW(NotImplementedException, "");
+    return m_csr_view;
   }
 
-  VariableDoFBool& getForcedInfo() override
-  {
-    ARCANE_THROW(NotImplementedException, "");
-  }
-
-  VariableDoFReal& getEliminationValue() override
-  {
-    ARCANE_THROW(NotImplementedException, "");
-  }
-
-  VariableDoFByte& getEliminationInfo() override
-  {
-    ARCANE_THROW(NotImplementedException, "");
-  }
+  VariableDoFReal& getForcedValue() override { return m_dof_forced_value; }
+  VariableDoFBool& getForcedInfo() override { return m_dof_forced_info; }
+  VariableDoFReal& getEliminationValue() override { return m_dof_elimination_value; }
+  VariableDoFByte& getEliminationInfo() override { return m_dof_elimination_info; }
 
  private:
 
   ISubDomain* m_sub_domain = nullptr;
   IItemFamily* m_dof_family = nullptr;
+  SolveReport m_solve_report;
   VariableDoFReal m_rhs_variable;
   VariableDoFReal m_dof_variable;
   VariableDoFInt32 m_dof_matrix_indexes;
   VariableDoFByte m_dof_elimination_info;
   VariableDoFReal m_dof_elimination_value;
+  //! Rows whose diagonal is replaced by the forced value
+  VariableDoFBool m_dof_forced_info;
+  VariableDoFReal m_dof_forced_value;
   AlephKernel* m_aleph_kernel = nullptr;
   AlephMatrix* m_aleph_matrix = nullptr;
   AlephVector* m_aleph_rhs_vector = nullptr;
   AlephVector* m_aleph_solution_vector = nullptr;
   AlephParams* m_aleph_params = nullptr;
   eSolverBackend m_solver_backend = eSolverBackend::Hypre;
-  //! List of (i,j) values added to the matrix
-  RowColumnMap m_values_map;
-  //! List of (i,j) whose value is fixed. This will override added values in m_values_map.
-  RowColumnMap m_forced_set_values_map;
+
+  //! CSR matrix of the values given by matrixAddValue() and setCSRValues()
+  CsrTripletAccumulator m_matrix;
+
+  /*!
+   * \brief Values given by matrixSetValue() in the order of the calls.
+   *
+   * They override the added values for the same (row,column).
+   */
+  UniqueArray<Int32> m_set_rows;
+  UniqueArray<Int32> m_set_columns;
+  UniqueArray<Real> m_set_values;
+
+  CSRFormatView m_csr_view;
+  bool m_has_csr_view = false;
+
   /*!
-   * \brief True is we use 'm_values_map' to mix add and set.
+   * \brief True is we use the CSR matrix to mix add and set.
    *
    * You may set the value to 'false' if you want the old behavior when
    * there is only matrixAddValue() calls.
@@ -442,6 +448,7 @@ class AlephDoFLinearSystemImpl
 
  private:
 
+  void _resetCSRMatrix();
   void _fillMatrix();
   void _fillRHSVector();
   void _setMatrixValue(DoF row, DoF column, Real value)
@@ -498,6 +505,20 @@ createAlephDoFLinearSystemImpl(ISubDomain* sd, IItemFamily* dof_family, const St
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void AlephDoFLinearSystemImpl::
+_resetCSRMatrix()
+{
+  m_matrix.reset(m_dof_family->maxLocalId());
+  m_set_rows.clear();
+  m_set_columns.clear();
+  m_set_values.clear();
+  m_csr_view = {};
+  m_has_csr_view = false;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void AlephDoFLinearSystemImpl::
 _fillMatrix()
 {
@@ -505,68 +526,77 @@ _fillMatrix()
   if (!m_use_value_map)
     return;
 
-  RowColumnMap row_column_elimination_map;
-
-  DoFInfoListView item_list_view(m_dof_family);
-  for (const auto& rc_value : m_values_map) {
-    RowColumn rc = rc_value.first;
-    Real value = rc_value.second;
-    DoF dof_row = item_list_view[rc.row_id];
-    DoF dof_column = item_list_view[rc.column_id];
-
-    Byte row_elimination_info = m_dof_elimination_info[dof_row];
-    Byte column_elimination_info = m_dof_elimination_info[dof_column];
-
-    if (row_elimination_info == ELIMINATE_ROW_COLUMN || column_elimination_info == ELIMINATE_ROW_COLUMN) {
-      row_column_elimination_map[{ rc.row_id, rc.column_id }] = value;
-      continue;
-    }
-
-    if (row_elimination_info == ELIMINATE_ROW)
-      // Will be computed after this loop
+  // Values given by setCSRValues()
+  if (m_has_csr_view) {
+    m_matrix.addCSRView(m_csr_view);
+    m_has_csr_view = false;
+  }
+  // Forced values replace the diagonal so make sure it exists
+  ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
+    if (m_dof_forced_info[idof])
+      m_matrix.add(idof.itemLocalId(), idof.itemLocalId(), 0.0);
+  }
+  m_matrix.merge();
+
+  const Int32 nb_row = m_matrix.nbRow();
+  Span<const Int32> rows_index = m_matrix.rowsIndex();
+  Span<const Int32> columns = m_matrix.columns();
+  Span<const Real> values = m_matrix.values();
+  info() << "[AlephFem] Fill matrix nb_row=" << nb_row << " nb_value=" << values.size();
+
+  // Values given by matrixSetValue() override the added values. They are
+  // only used if (row,column) has been added to the matrix. The last call wins.
+  UniqueArray<Real> matrix_values(values);
+  for (Int32 i = 0, n = m_set_rows.size(); i < n; ++i) {
+    Int32 index = m_matrix.findIndex(m_set_rows[i], m_set_columns[i]);
+    if (index < 0)
       continue;
-
-    // Check if value is forced for current RowColumn
-    auto x = m_forced_set_values_map.find(rc);
-    if (x != m_forced_set_values_map.end()) {
-      info(4) << "FORCED VALUE R=" << rc.row_id << " C=" << rc.column_id
-              << " old=" << value << " new=" << x->second;
-      value = x->second;
-    }
-
-    _setMatrixValue(dof_row, dof_column, value);
+    info(4) << "FORCED VALUE R=" << m_set_rows[i] << " C=" << m_set_columns[i]
+            << " old=" << values[index] << " new=" << m_set_values[i];
+    matrix_values[index] = m_set_values[i];
+  }
+  ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
+    if (m_dof_forced_info[idof])
+      matrix_values[m_matrix.findIndex(idof.itemLocalId(), idof.itemLocalId())] = m_dof_forced_value[idof];
   }
 
-  // Apply Row+Column elimination
-  // Phase 1:
-  // - substract values of the RHS vector if Row+Column elimination
-  for (const auto& rc_value : row_column_elimination_map) {
-    RowColumn rc = rc_value.first;
-    Real matrix_value = rc_value.second;
-    DoF dof_row = item_list_view[rc.row_id];
-    DoF dof_column = item_list_view[rc.column_id];
-    if (dof_row == dof_column)
-      continue;
-    if (!dof_column.isOwn())
+  DoFInfoListView item_list_view(m_dof_family);
+  for (Int32 r = 0; r < nb_row; ++r) {
+    if (rows_index[r] == rows_index[r + 1])
       continue;
+    DoF dof_row = item_list_view[r];
     Byte row_elimination_info = m_dof_elimination_info[dof_row];
     Real elimination_value = m_dof_elimination_value[dof_row];
-    // Substract the value of RHS vector for current column.
-    if (row_elimination_info == ELIMINATE_ROW_COLUMN) {
-      Real v = m_rhs_variable[dof_column];
-      m_rhs_variable[dof_column] = v - matrix_value * elimination_value;
-      if (m_do_print_filling)
-        info() << "EliminateRowColumn (" << std::setw(4) << rc.row_id
-               << "," << std::setw(4) << rc.column_id << ")"
-               << " elimination_value=" << std::setw(25) << elimination_value
-               << "  old_rhs=" << std::setw(25) << v
-               << "  new_rhs=" << std::setw(25) << m_rhs_variable[dof_column];
+    for (Int32 i = rows_index[r], n = rows_index[r + 1]; i < n; ++i) {
+      DoF dof_column = item_list_view[columns[i]];
+      Byte column_elimination_info = m_dof_elimination_info[dof_column];
+
+      if (row_elimination_info == ELIMINATE_ROW_COLUMN || column_elimination_info == ELIMINATE_ROW_COLUMN) {
+        // Substract the value of RHS vector for current column.
+        // The matrix is supposed to be symmetric.
+        if (row_elimination_info != ELIMINATE_ROW_COLUMN || dof_row == dof_column || !dof_column.isOwn())
+          continue;
+        Real v = m_rhs_variable[dof_column];
+        m_rhs_variable[dof_column] = v - values[i] * elimination_value;
+        if (m_do_print_filling)
+          info() << "EliminateRowColumn (" << std::setw(4) << r
+                 << "," << std::setw(4) << dof_column.localId() << ")"
+                 << " elimination_value=" << std::setw(25) << elimination_value
+                 << "  old_rhs=" << std::setw(25) << v
+                 << "  new_rhs=" << std::setw(25) << m_rhs_variable[dof_column];
+        continue;
+      }
+
+      if (row_elimination_info == ELIMINATE_ROW)
+        // Will be computed after this loop
+        continue;
+
+      _setMatrixValue(dof_row, dof_column, matrix_values[i]);
     }
   }
 
   // Apply Row or Row+Column elimination
-  // Phase 2: set the value of the RHS if Row elimination
-  // Phase 2: fill the diagonal with 1.0
+  // Set the value of the RHS and fill the diagonal with 1.0
   ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
     DoF dof = *idof;
     if (!dof.isOwn())
@@ -50,7 +50,9 @@
 
 namespace Arcane::FemUtils::Gpu::Csr
 {
-ARCCORE_HOST_DEVICE static Int32 findIndex(Int32 begin, Int32 end, Int32 column_lid, Span<const Int32> in_csr_columns)
+//! Index in [begin, end[ of the column \a column_lid (-1 if not found)
+template <typename IndexType>
+ARCCORE_HOST_DEVICE static IndexType findIndex(IndexType begin, IndexType end, Int32 column_lid, Span<const Int32> in_csr_columns)
 {
   for (auto i = begin; i < end; ++i)
     if (in_csr_columns[i] == column_lid)
@@ -527,7 +529,6 @@ namespace BoundaryConditions
 
   inline void applyDirichletViaRowEliminationVectorial(const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue, FaceGroup face_group, const UniqueArray<String> u_dirichlet_str)
   {
-    constexpr Byte ELIMINATE_ROW = 1;
     NodeGroup node_group = face_group.nodeGroup();
     for (auto dof_index = 0; dof_index < u_dirichlet_str.size(); ++dof_index) {
       if (u_dirichlet_str[dof_index] != "NULL") {
@@ -537,6 +538,47 @@ namespace BoundaryConditions
     }
   }
 
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Applies Dirichlet boundary conditions via row and column elimination.
+   *
+   * The rows and columns of the Dirichlet DOFs are removed from the matrix
+   * and the known values are moved to the RHS so that the matrix stays
+   * symmetric.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  inline void applyDirichletViaRowColumnEliminationVectorial(const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue, FaceGroup face_group, const UniqueArray<String> u_dirichlet_str)
+  {
+    NodeGroup node_group = face_group.nodeGroup();
+    for (auto dof_index = 0; dof_index < u_dirichlet_str.size(); ++dof_index) {
+      if (u_dirichlet_str[dof_index] != "NULL") {
+        Real u_dirichlet = std::stod(u_dirichlet_str[dof_index].localstr());
+        BoundaryCondtionsHelpers::applyDirichletToNodeGroupViaRowElimination<ELIMINATE_ROW_COLUMN>(u_dirichlet, queue, mesh, linear_system, dofs_on_nodes, node_group, dof_index);
+      }
+    }
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  inline void applyDirichletViaRowElimination(BC::IDirichletBoundaryCondition* bs, const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue)
+  {
+    ARCANE_CHECK_PTR(bs);
+    NodeGroup node_group = bs->getSurface().nodeGroup();
+    BoundaryCondtionsHelpers::applyDirichletToNodeGroupViaRowElimination<ELIMINATE_ROW>(bs->getValue(), queue, mesh, linear_system, dofs_on_nodes, node_group);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  inline void applyDirichletViaRowColumnElimination(BC::IDirichletBoundaryCondition* bs, const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue)
+  {
+    ARCANE_CHECK_PTR(bs);
+    NodeGroup node_group = bs->getSurface().nodeGroup();
+    BoundaryCondtionsHelpers::applyDirichletToNodeGroupViaRowElimination<ELIMINATE_ROW_COLUMN>(bs->getValue(), queue, mesh, linear_system, dofs_on_nodes, node_group);
+  }
+
   /*---------------------------------------------------------------------------*/
   /**
    * @brief Applies Point Dirichlet boundary conditions to RHS and LHS.
@@ -576,7 +618,6 @@ namespace BoundaryConditions
 
   inline void applyPointDirichletViaRowEliminationVectorial(const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue, NodeGroup node_group, const UniqueArray<String> u_dirichlet_str)
   {
-    constexpr Byte ELIMINATE_ROW = 1;
     for (auto dof_index = 0; dof_index < u_dirichlet_str.size(); ++dof_index) {
       if (u_dirichlet_str[dof_index] != "NULL") {
         Real u_dirichlet = std::stod(u_dirichlet_str[dof_index].localstr());
@@ -585,6 +626,39 @@ namespace BoundaryConditions
     }
   }
 
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  inline void applyPointDirichletViaRowColumnEliminationVectorial(const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue, NodeGroup node_group, const UniqueArray<String> u_dirichlet_str)
+  {
+    for (auto dof_index = 0; dof_index < u_dirichlet_str.size(); ++dof_index) {
+      if (u_dirichlet_str[dof_index] != "NULL") {
+        Real u_dirichlet = std::stod(u_dirichlet_str[dof_index].localstr());
+        BoundaryCondtionsHelpers::applyDirichletToNodeGroupViaRowElimination<ELIMINATE_ROW_COLUMN>(u_dirichlet, queue, mesh, linear_system, dofs_on_nodes, node_group, dof_index);
+      }
+    }
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  inline void applyPointDirichletViaRowElimination(BC::IDirichletPointCondition* bs, const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue)
+  {
+    ARCANE_CHECK_PTR(bs);
+    NodeGroup node_group = bs->getNode();
+    BoundaryCondtionsHelpers::applyDirichletToNodeGroupViaRowElimination<ELIMINATE_ROW>(bs->getValue(), queue, mesh, linear_system, dofs_on_nodes, node_group);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  inline void applyPointDirichletViaRowColumnElimination(BC::IDirichletPointCondition* bs, const FemDoFsOnNodes& dofs_on_nodes, DoFLinearSystem& linear_system, IMesh* mesh, Accelerator::RunQueue* queue)
+  {
+    ARCANE_CHECK_PTR(bs);
+    NodeGroup node_group = bs->getNode();
+    BoundaryCondtionsHelpers::applyDirichletToNodeGroupViaRowElimination<ELIMINATE_ROW_COLUMN>(bs->getValue(), queue, mesh, linear_system, dofs_on_nodes, node_group);
+  }
+
 }; // namespace BoundaryConditions
 
 class BoundaryConditions2D
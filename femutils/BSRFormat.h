@@ -19,11 +19,15 @@
 
 #include <ios>
 #include <iomanip>
+#include <algorithm>
+#include <limits>
+#include <type_traits>
 
 #include <arccore/trace/TraceAccessor.h>
 
 #include <arccore/base/NotImplementedException.h>
 #include <arccore/base/ArgumentException.h>
+#include <arccore/base/NotSupportedException.h>
 #include <arccore/base/ArccoreGlobal.h>
 
 #include <arcane/core/IIndexedIncrementalItemConnectivityMng.h>
@@ -31,8 +35,12 @@
 #include <arcane/core/UnstructuredMeshConnectivity.h>
 #include <arcane/core/IIncrementalItemConnectivity.h>
 #include <arcane/core/IndexedItemConnectivityView.h>
+#include <arcane/core/VariableBuildInfo.h>
 #include <arcane/core/VariableTypedef.h>
+#include <arcane/core/VariableTypes.h>
+#include <arcane/core/IParallelMng.h>
 #include <arcane/core/ItemEnumerator.h>
+#include <arcane/core/IItemFamily.h>
 #include <arcane/core/ItemTypes.h>
 #include <arcane/core/MeshUtils.h>
 #include <arcane/core/DataView.h>
@@ -51,6 +59,7 @@
 #include <arcane/accelerator/NumArrayViews.h>
 #include <arcane/accelerator/GenericSorter.h>
 #include <arcane/accelerator/Atomic.h>
+#include <arcane/accelerator/Reduce.h>
 #include <arcane/accelerator/Scan.h>
 #include <arcane/accelerator/Sort.h>
 
@@ -64,6 +73,40 @@
 namespace Arcane::FemUtils
 {
 
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Arrays of the CSR matrix built by `BSRMatrix::toCsr()`.
+ *
+ * The arrays are allocated on the memory ressource given to the
+ * constructor, which is the one of the queue of the matrix. The row offsets
+ * and the arrays indexed by the values use `IndexType`.
+ */
+/*---------------------------------------------------------------------------*/
+
+template <typename IndexType>
+class BSRCsrArrays
+{
+ public:
+
+  using ValueExtents = ExtentsV<IndexType, DynExtent>;
+
+ public:
+
+  explicit BSRCsrArrays(eMemoryRessource mem_ressource)
+  : m_matrix_row(mem_ressource)
+  , m_matrix_rows_nb_column(mem_ressource)
+  , m_matrix_column(mem_ressource)
+  , m_matrix_value(mem_ressource)
+  {}
+
+ public:
+
+  NumArray<IndexType, MDDim1> m_matrix_row;
+  NumArray<Int32, MDDim1> m_matrix_rows_nb_column;
+  NumArray<Int32, ValueExtents> m_matrix_column;
+  NumArray<Real, ValueExtents> m_matrix_value;
+};
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief A class representing a Block Sparse Row (BSR) matrix.
@@ -98,12 +141,24 @@ namespace Arcane::FemUtils
  * stored in per row (which the way CSR format stores matrices) allow us to
  * pass it directly to HYPRE (which support CSR but not BSR), whithout the need
  * for a translation step on it.
+ *
+ * `IndexType` is the type of the row index and of the positions in the
+ * values (Int32 or Int64). With Int64, the matrix may have more than 2^31
+ * values. The columns are node indexes and are always Int32.
  */
 /*---------------------------------------------------------------------------*/
 
-template <int BLOCK_SIZE>
+template <int BLOCK_SIZE, typename IndexType = Int32>
 class BSRMatrix : public TraceAccessor
 {
+  static_assert(std::is_same_v<IndexType, Int32> || std::is_same_v<IndexType, Int64>,
+                "BSRMatrix only supports Int32 or Int64 indexes");
+
+ public:
+
+  //! Extents of the arrays indexed by the blocks or the values of the matrix
+  using ValueExtents = ExtentsV<IndexType, DynExtent>;
+
  public:
 
   BSRMatrix(ITraceMng* tm, const eMemoryRessource& mem_ressource, RunQueue& queue)
@@ -111,12 +166,13 @@ class BSRMatrix : public TraceAccessor
   , m_values(mem_ressource)
   , m_columns(mem_ressource)
   , m_row_index(mem_ressource)
+  , m_nb_nz_per_row(mem_ressource)
   , m_queue(queue) {};
 
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  void initialize(Int32 nb_non_zero_value, Int32 nb_col, Int32 nb_row, bool order_values_per_block)
+  void initialize(IndexType nb_non_zero_value, IndexType nb_col, Int32 nb_row, bool order_values_per_block)
   {
     if (BLOCK_SIZE <= 0 || nb_non_zero_value <= 0 || nb_row <= 0)
       ARCANE_THROW(ArgumentException, "BSRMatrix(initialize): arguments should be positive and not null (block_size={0}, nb_non_zero_value={1} and nb_row={2})", BLOCK_SIZE, nb_non_zero_value, nb_row);
@@ -142,11 +198,15 @@ class BSRMatrix : public TraceAccessor
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  Int32 findValueIndex(DoFLocalId row, DoFLocalId col) const
+  IndexType findValueIndex(DoFLocalId row, DoFLocalId col) const
   {
     auto block_row = row / BLOCK_SIZE;
     auto block_col = col / BLOCK_SIZE;
 
+    // Only the upper blocks of a symmetric matrix are stored
+    if (m_is_symmetric && block_row > block_col)
+      return findValueIndex(col, row);
+
     auto block_start = m_row_index[block_row];
     auto block_end = (block_row == m_nb_row - 1) ? m_nb_col : m_row_index[block_row + 1];
 
@@ -191,68 +251,104 @@ class BSRMatrix : public TraceAccessor
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  void toCsr(CsrFormat* csr_matrix)
+  /**
+   * @brief Returns a CSR view of the matrix.
+   *
+   * The CSR structure is computed on the queue of the matrix. With values
+   * ordered per row, the values of the scalar row `r = block_row * BLOCK_SIZE + i`
+   * start at `row_index[block_row] * BLOCK_SIZE^2 + i * nb_nz_per_row[block_row] * BLOCK_SIZE`
+   * so each row is computed independently, without a scan.
+   *
+   * If the values are ordered per row, the view uses the values of the BSR
+   * matrix (no copy) and if BLOCK_SIZE is 1 it also uses its structure.
+   * Otherwise, the arrays which can not be shared are stored in `csr_arrays`.
+   *
+   * If the matrix is symmetric, the full matrix is always built in
+   * `csr_arrays` (see `_toCsrSymmetric()`).
+   *
+   * @note The linear systems do not modify the values of the view (see
+   * `DoFLinearSystem::setCSRValues()`) so the BSR matrix is still valid after
+   * a solve, for another solve or for `spmv()`.
+   */
+  CSRFormatViewT<IndexType> toCsr(BSRCsrArrays<IndexType>* csr_arrays)
   {
     info() << "BSRMatrix(toCsr): Convert matrix to CSR";
 
     auto startTime = platform::getRealTime();
 
-    auto nb_block_rows = m_row_index.extent0();
-    auto nb_rows = nb_block_rows * BLOCK_SIZE;
-    auto total_non_zero_elements = m_nb_non_zero_value;
-
-    csr_matrix->initialize(nullptr, total_non_zero_elements, nb_rows, m_queue);
+    if (m_is_symmetric) {
+      CSRFormatViewT<IndexType> csr_view = _toCsrSymmetric(csr_arrays);
+      info() << "[ArcaneFem-Timer] Time to translate symmetric BSR to CSR = " << (platform::getRealTime() - startTime);
+      return csr_view;
+    }
 
     if constexpr (BLOCK_SIZE == 1) {
-      csr_matrix->m_matrix_row = m_row_index;
-      csr_matrix->m_matrix_column = m_columns;
-      csr_matrix->m_matrix_rows_nb_column = m_nb_nz_per_row;
+      info() << "[ArcaneFem-Timer] Time to translate BSR to CSR = " << (platform::getRealTime() - startTime);
+      return CSRFormatViewT<IndexType>(m_row_index.to1DSpan(), m_nb_nz_per_row.to1DSpan(), m_columns.to1DSpan(), m_values.to1DSpan());
     }
-    else {
-      // Translate `row_index`
-      csr_matrix->m_matrix_row[0] = 0;
-      auto offset = 1;
-      for (auto i = 0; i < m_row_index.extent0() - 1; ++i) {
-        for (auto j = 0; j < BLOCK_SIZE; ++j) {
-          auto start = m_row_index[i];
-          auto end = i == m_row_index.extent0() - 1 ? m_nb_col : m_row_index[i + 1];
-          auto nombre_de_dof_dans_la_rangee = (end - start) * BLOCK_SIZE;
-          csr_matrix->m_matrix_row[offset] = csr_matrix->m_matrix_row[offset - 1] + nombre_de_dof_dans_la_rangee;
-          offset++;
-        }
-      }
 
-      // Translate `columns`
-      offset = 0;
-      for (auto i = 0; i < m_row_index.extent0(); ++i) {
-        for (auto j = 0; j < BLOCK_SIZE; ++j) {
-          auto start = m_row_index[i];
-          auto end = i == m_row_index.extent0() - 1 ? m_nb_col : m_row_index[i + 1];
-          for (auto block_index = start; block_index < end; ++block_index) {
-            for (auto k = 0; k < BLOCK_SIZE; ++k) {
-              csr_matrix->m_matrix_column[offset] = m_columns[block_index] * BLOCK_SIZE + k;
-              offset++;
-            }
-          }
-        }
-      }
+    constexpr int BLOCK_SIZE_SQ = BLOCK_SIZE * BLOCK_SIZE;
+    Int32 nb_rows = m_nb_row * BLOCK_SIZE;
+    csr_arrays->m_matrix_row.resize(nb_rows);
+    csr_arrays->m_matrix_rows_nb_column.resize(nb_rows);
+    csr_arrays->m_matrix_column.resize(m_nb_non_zero_value);
 
-      // Translate `nb_nz_per_row`
-      offset = 0;
-      for (auto i = 0; i < m_nb_nz_per_row.extent0(); ++i) {
-        for (auto j = 0; j < BLOCK_SIZE; ++j) {
-          csr_matrix->m_matrix_rows_nb_column[offset++] = m_nb_nz_per_row[i] * BLOCK_SIZE;
+    {
+      auto command = makeCommand(m_queue);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_nb_nz_per_row = viewIn(command, m_nb_nz_per_row);
+      auto in_columns = viewIn(command, m_columns);
+      auto out_row = viewOut(command, csr_arrays->m_matrix_row);
+      auto out_rows_nb_column = viewOut(command, csr_arrays->m_matrix_rows_nb_column);
+      auto out_columns = viewOut(command, csr_arrays->m_matrix_column);
+
+      command << RUNCOMMAND_LOOP1(iter, nb_rows)
+      {
+        auto [r] = iter();
+        Int32 block_row = r / BLOCK_SIZE;
+        Int32 row_offset = r % BLOCK_SIZE;
+        IndexType block_start = in_row_index[block_row];
+        Int32 nb_block = in_nb_nz_per_row[block_row];
+        IndexType start = block_start * BLOCK_SIZE_SQ + row_offset * nb_block * BLOCK_SIZE;
+        out_row[r] = start;
+        out_rows_nb_column[r] = nb_block * BLOCK_SIZE;
+        for (Int32 j = 0; j < nb_block; ++j) {
+          Int32 column = in_columns[block_start + j] * BLOCK_SIZE;
+          for (Int32 k = 0; k < BLOCK_SIZE; ++k)
+            out_columns[start + j * BLOCK_SIZE + k] = column + k;
         }
-      }
+      };
+    }
+
+    Span<Real> values = m_values.to1DSpan();
+    if (m_order_values_per_block) {
+      // Values of a block are contiguous: reorder them per row.
+      csr_arrays->m_matrix_value.resize(m_nb_non_zero_value);
+      auto command = makeCommand(m_queue);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_nb_nz_per_row = viewIn(command, m_nb_nz_per_row);
+      auto in_values = viewIn(command, m_values);
+      auto out_values = viewOut(command, csr_arrays->m_matrix_value);
 
-      // Fill last entry of CSR matrix row_index array
-      auto row_index_size = csr_matrix->m_matrix_row.extent0();
-      csr_matrix->m_matrix_row[row_index_size - 1] = csr_matrix->m_matrix_row[row_index_size - 2] + csr_matrix->m_matrix_rows_nb_column[csr_matrix->m_matrix_rows_nb_column.extent0() - 1];
+      command << RUNCOMMAND_LOOP1(iter, nb_rows)
+      {
+        auto [r] = iter();
+        Int32 block_row = r / BLOCK_SIZE;
+        Int32 row_offset = r % BLOCK_SIZE;
+        IndexType block_start = in_row_index[block_row];
+        Int32 nb_block = in_nb_nz_per_row[block_row];
+        IndexType start = block_start * BLOCK_SIZE_SQ + row_offset * nb_block * BLOCK_SIZE;
+        for (Int32 j = 0; j < nb_block; ++j)
+          for (Int32 k = 0; k < BLOCK_SIZE; ++k)
+            out_values[start + j * BLOCK_SIZE + k] = in_values[(block_start + j) * BLOCK_SIZE_SQ + row_offset * BLOCK_SIZE + k];
+      };
+      values = csr_arrays->m_matrix_value.to1DSpan();
     }
+    m_queue.barrier();
 
-    // NOTE: If we don't want to keep bsr matrix coefficients we could move the data instead of copying it.
-    csr_matrix->m_matrix_value = m_values;
     info() << "[ArcaneFem-Timer] Time to translate BSR to CSR = " << (platform::getRealTime() - startTime);
+    return CSRFormatViewT<IndexType>(csr_arrays->m_matrix_row.to1DSpan(), csr_arrays->m_matrix_rows_nb_column.to1DSpan(),
+                                     csr_arrays->m_matrix_column.to1DSpan(), values);
   }
 
   /*---------------------------------------------------------------------------*/
@@ -273,12 +369,201 @@ class BSRMatrix : public TraceAccessor
             auto global_col = (col * BLOCK_SIZE) + j;
             auto value = getValue(DoFLocalId(global_row), DoFLocalId(global_col));
             linear_system.matrixAddValue(DoFLocalId(global_row), DoFLocalId(global_col), value);
+            if (m_is_symmetric && col != row)
+              linear_system.matrixAddValue(DoFLocalId(global_col), DoFLocalId(global_row), value);
           }
         }
       }
     }
   }
 
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Keeps only the blocks of the upper triangle of the matrix.
+   *
+   * After this call the matrix is symmetric: only the blocks `(row, col)`
+   * with `col >= row` are stored and the block `(col, row)` is the transpose
+   * of the block `(row, col)`. The sparsity has to be the full (symmetric)
+   * one and the values have to be ordered per block. The values are reset
+   * to zero.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void keepUpperTriangle()
+  {
+    if (!m_order_values_per_block)
+      ARCANE_THROW(NotSupportedException, "BSRMatrix(keepUpperTriangle): symmetric storage needs values ordered per block");
+
+    info() << "BSRMatrix(keepUpperTriangle): Keep upper triangle of the matrix";
+    auto startTime = platform::getRealTime();
+
+    auto mem_ressource = m_queue.memoryRessource();
+    Int32 nb_row = m_nb_row;
+    IndexType nb_col = m_nb_col;
+
+    NumArray<IndexType, MDDim1> nb_upper_block(mem_ressource);
+    nb_upper_block.resize(nb_row);
+    IndexType nb_upper_col = 0;
+    {
+      auto command = makeCommand(m_queue);
+      Accelerator::ReducerSum2<IndexType> reducer(command);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_columns = viewIn(command, m_columns);
+      auto out_nb_upper_block = viewOut(command, nb_upper_block);
+      command << RUNCOMMAND_LOOP1(iter, nb_row, reducer)
+      {
+        auto [row] = iter();
+        IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+        IndexType nb_block = 0;
+        for (IndexType k = in_row_index[row]; k < end; ++k)
+          if (in_columns[k] >= row)
+            ++nb_block;
+        out_nb_upper_block[row] = nb_block;
+        reducer.combine(nb_block);
+      };
+      // Rows without blocks (ghost rows) have no diagonal block so the
+      // number of upper blocks is not deduced from nb_col and nb_row.
+      nb_upper_col = reducer.reducedValue();
+    }
+
+    NumArray<IndexType, MDDim1> upper_row_index(mem_ressource);
+    upper_row_index.resize(nb_row);
+    Accelerator::Scanner<IndexType> scanner;
+    scanner.exclusiveSum(&m_queue, nb_upper_block.to1DSmallSpan(), upper_row_index.to1DSmallSpan());
+
+    NumArray<Int32, ValueExtents> upper_columns(mem_ressource);
+    upper_columns.resize(nb_upper_col);
+    {
+      auto command = makeCommand(m_queue);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_columns = viewIn(command, m_columns);
+      auto in_upper_row_index = viewIn(command, upper_row_index);
+      auto out_upper_columns = viewOut(command, upper_columns);
+      command << RUNCOMMAND_LOOP1(iter, nb_row)
+      {
+        auto [row] = iter();
+        IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+        IndexType offset = in_upper_row_index[row];
+        for (IndexType k = in_row_index[row]; k < end; ++k) {
+          Int32 col = in_columns[k];
+          if (col >= row) {
+            out_upper_columns[offset] = col;
+            ++offset;
+          }
+        }
+      };
+    }
+    m_queue.barrier();
+
+    m_row_index.copy(upper_row_index);
+    m_columns.copy(upper_columns);
+    m_nb_col = nb_upper_col;
+    m_nb_non_zero_value = nb_upper_col * BLOCK_SIZE * BLOCK_SIZE;
+    m_values.resize(m_nb_non_zero_value);
+    m_values.fill(0, &m_queue);
+    m_is_symmetric = true;
+
+    info() << "BSRMatrix(keepUpperTriangle): nb_col=" << m_nb_col << ", nb_non_zero_value=" << m_nb_non_zero_value;
+    info() << "[ArcaneFem-Timer] Time to keep upper triangle of BSR matrix = " << (platform::getRealTime() - startTime);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes y = A.x.
+   *
+   * \a x and \a y are indexed by the DoFs (`node * BLOCK_SIZE + i`) and
+   * have to be accessible on the queue of the matrix. One thread computes
+   * one block row. The kernels are specialized with the block size known at
+   * compile time: with values ordered per block each block is read as a
+   * contiguous chunk of `BLOCK_SIZE * BLOCK_SIZE` values, and the scalar
+   * case (`BLOCK_SIZE == 1`) is a plain CSR product.
+   *
+   * For a symmetric matrix, each stored off-diagonal block is also applied
+   * transposed to the row of its column, so the contributions are
+   * accumulated in \a y with atomic operations.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void spmv(Span<const Real> x, Span<Real> y)
+  {
+    if (m_is_symmetric)
+      _spmvSymmetric(x, y);
+    else if (m_order_values_per_block)
+      _spmvOrderedPerBlock(x, y);
+    else
+      _spmvOrderedPerRow(x, y);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Fills \a diagonal with the diagonal of the matrix.
+   *
+   * \a diagonal is indexed by the DoFs like the vectors of spmv(). The
+   * values of the rows without diagonal block (e.g. the rows of the ghost
+   * nodes in parallel) are zero.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void computeDiagonal(Span<Real> diagonal)
+  {
+    constexpr int BLOCK_SIZE_SQ = BLOCK_SIZE * BLOCK_SIZE;
+    Int32 nb_row = m_nb_row;
+    IndexType nb_col = m_nb_col;
+    bool order_values_per_block = m_order_values_per_block;
+
+    {
+      auto command = makeCommand(m_queue);
+      command << RUNCOMMAND_LOOP1(iter, diagonal.size())
+      {
+        auto [i] = iter();
+        diagonal[i] = 0.0;
+      };
+    }
+
+    auto command = makeCommand(m_queue);
+    auto in_row_index = viewIn(command, m_row_index);
+    auto in_columns = viewIn(command, m_columns);
+    auto in_values = viewIn(command, m_values);
+
+    command << RUNCOMMAND_LOOP1(iter, nb_row)
+    {
+      auto [row] = iter();
+      IndexType begin = in_row_index[row];
+      IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+      for (IndexType k = begin; k < end; ++k) {
+        if (in_columns[k] != row)
+          continue;
+        for (Int32 i = 0; i < BLOCK_SIZE; ++i) {
+          IndexType value_index = (order_values_per_block)
+          ? k * BLOCK_SIZE_SQ + i * BLOCK_SIZE + i
+          : begin * BLOCK_SIZE_SQ + i * (end - begin) * BLOCK_SIZE + (k - begin) * BLOCK_SIZE + i;
+          diagonal[row * BLOCK_SIZE + i] = in_values[value_index];
+        }
+        break;
+      }
+    };
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Minimum number of bytes read and written by spmv().
+   *
+   * Each value, column and row index of the matrix is read once and each
+   * value of `x` and `y` is accessed once. It is used to compute the
+   * bandwidth reached by the product.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  Int64 spmvNbTransferredByte() const
+  {
+    Int64 nb_byte = static_cast<Int64>(m_nb_non_zero_value) * sizeof(Real);
+    nb_byte += static_cast<Int64>(m_nb_col) * sizeof(Int32) + static_cast<Int64>(m_nb_row) * sizeof(IndexType);
+    if (!m_order_values_per_block)
+      nb_byte += static_cast<Int64>(m_nb_row) * sizeof(Int32);
+    nb_byte += 2 * static_cast<Int64>(m_nb_row) * BLOCK_SIZE * sizeof(Real);
+    return nb_byte;
+  }
+
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
@@ -290,16 +575,16 @@ class BSRMatrix : public TraceAccessor
     file << "size :" << nbNz() << "\n";
     for (auto i = 0; i < nbRow(); ++i) {
       file << m_row_index(i) << " ";
-      for (Int32 j = m_row_index(i) + 1; (i + 1 < m_row_index.dim1Size() && j < m_row_index(i + 1)) || (i + 1 == m_row_index.dim1Size() && j < m_columns.dim1Size()); j++)
+      for (IndexType j = m_row_index(i) + 1; (i + 1 < m_row_index.dim1Size() && j < m_row_index(i + 1)) || (i + 1 == m_row_index.dim1Size() && j < m_columns.dim1Size()); j++)
         file << "  ";
     }
     file << "\n";
 
-    for (auto i = 0; i < m_columns.extent0(); ++i)
+    for (IndexType i = 0; i < m_columns.extent0(); ++i)
       file << m_columns(i) << " ";
     file << "\n";
 
-    for (auto i = 0; i < nbNz(); ++i)
+    for (IndexType i = 0; i < nbNz(); ++i)
       file << m_values(i) << " ";
     file << "\n";
 
@@ -310,181 +595,626 @@ class BSRMatrix : public TraceAccessor
   /*---------------------------------------------------------------------------*/
 
   bool orderValuePerBlock() { return m_order_values_per_block; }
-  Int32 nbNz() { return m_nb_non_zero_value; };
-  Int32 nbCol() { return m_nb_col; };
+  bool isSymmetric() { return m_is_symmetric; }
+  IndexType nbNz() { return m_nb_non_zero_value; };
+  IndexType nbCol() { return m_nb_col; };
   Int32 nbRow() { return m_nb_row; };
 
-  NumArray<Real, MDDim1>& values() { return m_values; }
-  NumArray<Int32, MDDim1>& columns() { return m_columns; }
-  NumArray<Int32, MDDim1>& rowIndex() { return m_row_index; }
+  NumArray<Real, ValueExtents>& values() { return m_values; }
+  NumArray<Int32, ValueExtents>& columns() { return m_columns; }
+  NumArray<IndexType, MDDim1>& rowIndex() { return m_row_index; }
   NumArray<Int32, MDDim1>& nbNzPerRow() { return m_nb_nz_per_row; }
 
  private:
 
   bool m_order_values_per_block = true;
+  //! True if only the upper blocks are stored (see keepUpperTriangle())
+  bool m_is_symmetric = false;
 
-  Int32 m_nb_non_zero_value;
-  Int32 m_nb_col;
+  IndexType m_nb_non_zero_value;
+  IndexType m_nb_col;
   Int32 m_nb_row;
 
-  NumArray<Real, MDDim1> m_values;
-  NumArray<Int32, MDDim1> m_columns;
-  NumArray<Int32, MDDim1> m_row_index;
+  NumArray<Real, ValueExtents> m_values;
+  NumArray<Int32, ValueExtents> m_columns;
+  NumArray<IndexType, MDDim1> m_row_index;
   NumArray<Int32, MDDim1> m_nb_nz_per_row;
 
   RunQueue& m_queue;
-};
-
-/*---------------------------------------------------------------------------*/
-/**
- * @brief A class for assembling Block Sparse Row (BSR) matrices from mesh data.
- *
- * The `BSRFormat` class is designed to construct and manage BSR matrices using 
- * mesh connectivity and degree-of-freedom (DoF) information.
- *
- * In 2D, the sparsity is computed based on node-face connectivity, while in 3D, 
- * node-node connectivity is used.
- *
- * @note This class uses Arcane's accelerator api and will use GPU is possible.
- * It uses a `BSRMatrix` under the hood for representation and operations.
- */
-/*---------------------------------------------------------------------------*/
-
-template <int NB_DOF>
-class BSRFormat : public TraceAccessor
-{
- public:
-
-  BSRFormat(ITraceMng* tm, RunQueue& queue, const FemDoFsOnNodes& dofs_on_nodes)
-  : TraceAccessor(tm)
-  , m_dofs_on_nodes(dofs_on_nodes)
-  , m_queue(queue)
-  , m_bsr_matrix(tm, queue.memoryRessource(), queue)
-  , m_csr_matrix(tm) {};
-
-  /*---------------------------------------------------------------------------*/
-  /*---------------------------------------------------------------------------*/
 
  private:
 
-  Int64 computeNbEdge(IMesh* mesh)
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Builds the full CSR matrix of a symmetric matrix.
+   *
+   * Each block row of the CSR matrix contains the transposes of the blocks
+   * of the previous rows whose column is this row, sorted by their row,
+   * followed by the stored blocks of the row. The transposed blocks are
+   * first gathered per row (in any order) and each row then sorts its own
+   * ones, so the columns of a row do not depend on the scheduling of the
+   * threads.
+   */
+  CSRFormatViewT<IndexType> _toCsrSymmetric(BSRCsrArrays<IndexType>* csr_arrays)
   {
-    Int64 nb_edge = 0;
-    if (mesh->dimension() == 2)
-      nb_edge = mesh->nbFace();
-    else {
-      auto nn_via_edge_cv = MeshUtils::computeNodeNodeViaEdgeConnectivity(mesh, "NodeNodeViaEdge");
-      IndexedNodeNodeConnectivityView nn_cv = nn_via_edge_cv->view();
-      ENUMERATE_NODE (inode, mesh->allNodes()) {
-        Node node = *inode;
-        nb_edge += nn_cv.nbNode(node);
-      }
-      nb_edge /= 2;
+    constexpr int BLOCK_SIZE_SQ = BLOCK_SIZE * BLOCK_SIZE;
+    auto mem_ressource = m_queue.memoryRessource();
+    Int32 nb_row = m_nb_row;
+    IndexType nb_col = m_nb_col;
+
+    // Number of blocks in each row of the full matrix
+    NumArray<IndexType, MDDim1> nb_full_block(mem_ressource);
+    nb_full_block.resize(nb_row);
+    // Number of transposed blocks already gathered in each row
+    NumArray<IndexType, MDDim1> nb_transposed_block(mem_ressource);
+    nb_transposed_block.resize(nb_row);
+    // Rows without blocks (ghost rows) have no diagonal block
+    IndexType nb_diagonal_block = 0;
+    {
+      auto command = makeCommand(m_queue);
+      Accelerator::ReducerSum2<IndexType> reducer(command);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_columns = viewIn(command, m_columns);
+      auto out_nb_full_block = viewOut(command, nb_full_block);
+      auto out_nb_transposed_block = viewOut(command, nb_transposed_block);
+      command << RUNCOMMAND_LOOP1(iter, nb_row, reducer)
+      {
+        auto [row] = iter();
+        IndexType begin = in_row_index[row];
+        IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+        out_nb_full_block[row] = end - begin;
+        out_nb_transposed_block[row] = 0;
+        for (IndexType k = begin; k < end; ++k)
+          if (in_columns[k] == row)
+            reducer.combine(1);
+      };
+      nb_diagonal_block = reducer.reducedValue();
+    }
+    {
+      auto command = makeCommand(m_queue);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_columns = viewIn(command, m_columns);
+      auto inout_nb_full_block = viewInOut(command, nb_full_block);
+      command << RUNCOMMAND_LOOP1(iter, nb_row)
+      {
+        auto [row] = iter();
+        IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+        for (IndexType k = in_row_index[row]; k < end; ++k) {
+          Int32 col = in_columns[k];
+          if (col != row)
+            Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_nb_full_block[col], 1);
+        }
+      };
     }
-    return nb_edge;
-  }
 
- public:
+    NumArray<IndexType, MDDim1> full_row_index(mem_ressource);
+    full_row_index.resize(nb_row);
+    Accelerator::Scanner<IndexType> scanner;
+    scanner.exclusiveSum(&m_queue, nb_full_block.to1DSmallSpan(), full_row_index.to1DSmallSpan());
+
+    // Row and index of the stored block of each transposed block. The
+    // transposed blocks of a row start at 'full_row_index[row] - row_index[row]'.
+    IndexType nb_transposed_total = nb_col - nb_diagonal_block;
+    NumArray<Int32, ValueExtents> transposed_row(mem_ressource);
+    transposed_row.resize(nb_transposed_total);
+    NumArray<IndexType, ValueExtents> transposed_block(mem_ressource);
+    transposed_block.resize(nb_transposed_total);
+    {
+      auto command = makeCommand(m_queue);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_columns = viewIn(command, m_columns);
+      auto in_full_row_index = viewIn(command, full_row_index);
+      auto inout_nb_transposed_block = viewInOut(command, nb_transposed_block);
+      auto out_transposed_row = viewOut(command, transposed_row);
+      auto out_transposed_block = viewOut(command, transposed_block);
+      command << RUNCOMMAND_LOOP1(iter, nb_row)
+      {
+        auto [row] = iter();
+        IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+        for (IndexType k = in_row_index[row]; k < end; ++k) {
+          Int32 col = in_columns[k];
+          if (col != row) {
+            IndexType position = Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_nb_transposed_block[col], 1);
+            IndexType index = in_full_row_index[col] - in_row_index[col] + position;
+            out_transposed_row[index] = row;
+            out_transposed_block[index] = k;
+          }
+        }
+      };
+    }
 
-  void initialize(IMesh* mesh, bool does_linear_system_use_csr, bool use_atomic_free = false)
-  {
-    ARCANE_CHECK_POINTER(mesh);
+    IndexType nb_full_value = (2 * nb_col - nb_diagonal_block) * BLOCK_SIZE_SQ;
+    csr_arrays->m_matrix_row.resize(nb_row * BLOCK_SIZE);
+    csr_arrays->m_matrix_rows_nb_column.resize(nb_row * BLOCK_SIZE);
+    csr_arrays->m_matrix_column.resize(nb_full_value);
+    csr_arrays->m_matrix_value.resize(nb_full_value);
 
-    if (mesh->dimension() != 2 && mesh->dimension() != 3)
-      ARCANE_THROW(NotImplementedException, "BSRFormat(initialize): Only supports 2D and 3D");
+    {
+      auto command = makeCommand(m_queue);
+      auto in_row_index = viewIn(command, m_row_index);
+      auto in_columns = viewIn(command, m_columns);
+      auto in_values = viewIn(command, m_values);
+      auto in_full_row_index = viewIn(command, full_row_index);
+      auto in_nb_full_block = viewIn(command, nb_full_block);
+      auto in_nb_transposed_block = viewIn(command, nb_transposed_block);
+      auto inout_transposed_row = viewInOut(command, transposed_row);
+      auto inout_transposed_block = viewInOut(command, transposed_block);
+      auto out_row = viewOut(command, csr_arrays->m_matrix_row);
+      auto out_rows_nb_column = viewOut(command, csr_arrays->m_matrix_rows_nb_column);
+      auto out_columns = viewOut(command, csr_arrays->m_matrix_column);
+      auto out_values = viewOut(command, csr_arrays->m_matrix_value);
 
-    auto startTime = platform::getRealTime();
+      command << RUNCOMMAND_LOOP1(iter, nb_row)
+      {
+        auto [row] = iter();
+        IndexType begin = in_row_index[row];
+        IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+        IndexType start = in_full_row_index[row] * BLOCK_SIZE_SQ;
+        // The number of blocks of a row is small so a row always fits in an Int32
+        Int32 row_stride = static_cast<Int32>(in_nb_full_block[row] * BLOCK_SIZE);
+        for (Int32 i = 0; i < BLOCK_SIZE; ++i) {
+          out_row[row * BLOCK_SIZE + i] = start + i * row_stride;
+          out_rows_nb_column[row * BLOCK_SIZE + i] = row_stride;
+        }
 
-    m_mesh = mesh;
-    Int64 nb_edge = computeNbEdge(mesh);
-    Int32 nb_node = m_mesh->nbNode();
-    Int32 nb_col = 2 * nb_edge + nb_node;
-    Int32 nb_non_zero_value = (NB_DOF * NB_DOF) * (2 * nb_edge + nb_node);
+        // Sort the transposed blocks of the row by their row (insertion
+        // sort as there are only a few blocks per row).
+        IndexType transposed_begin = in_full_row_index[row] - begin;
+        Int32 nb_transposed = static_cast<Int32>(in_nb_transposed_block[row]);
+        for (Int32 t = 1; t < nb_transposed; ++t) {
+          Int32 t_row = inout_transposed_row[transposed_begin + t];
+          IndexType t_block = inout_transposed_block[transposed_begin + t];
+          Int32 u = t - 1;
+          while (u >= 0 && inout_transposed_row[transposed_begin + u] > t_row) {
+            inout_transposed_row[transposed_begin + u + 1] = inout_transposed_row[transposed_begin + u];
+            inout_transposed_block[transposed_begin + u + 1] = inout_transposed_block[transposed_begin + u];
+            --u;
+          }
+          inout_transposed_row[transposed_begin + u + 1] = t_row;
+          inout_transposed_block[transposed_begin + u + 1] = t_block;
+        }
 
-    m_use_csr_in_linear_system = does_linear_system_use_csr;
-    bool order_values_per_block = !does_linear_system_use_csr;
-    m_bsr_matrix.initialize(nb_non_zero_value, nb_col, nb_node, order_values_per_block);
-    m_use_atomic_free = use_atomic_free;
-    info() << "[ArcaneFem-Timer] Time to initialize BSR format = " << (platform::getRealTime() - startTime);
+        for (Int32 t = 0; t < nb_transposed; ++t) {
+          Int32 col = inout_transposed_row[transposed_begin + t];
+          IndexType k = inout_transposed_block[transposed_begin + t];
+          IndexType block_start = start + t * BLOCK_SIZE;
+          for (Int32 i = 0; i < BLOCK_SIZE; ++i) {
+            for (Int32 j = 0; j < BLOCK_SIZE; ++j) {
+              out_columns[block_start + i * row_stride + j] = col * BLOCK_SIZE + j;
+              out_values[block_start + i * row_stride + j] = in_values[k * BLOCK_SIZE_SQ + j * BLOCK_SIZE + i];
+            }
+          }
+        }
+        for (IndexType k = begin; k < end; ++k) {
+          Int32 col = in_columns[k];
+          IndexType block_start = start + (nb_transposed + (k - begin)) * BLOCK_SIZE;
+          for (Int32 i = 0; i < BLOCK_SIZE; ++i) {
+            for (Int32 j = 0; j < BLOCK_SIZE; ++j) {
+              out_columns[block_start + i * row_stride + j] = col * BLOCK_SIZE + j;
+              out_values[block_start + i * row_stride + j] = in_values[k * BLOCK_SIZE_SQ + i * BLOCK_SIZE + j];
+            }
+          }
+        }
+      };
+    }
+    m_queue.barrier();
+
+    return CSRFormatViewT<IndexType>(csr_arrays->m_matrix_row.to1DSpan(), csr_arrays->m_matrix_rows_nb_column.to1DSpan(),
+                                     csr_arrays->m_matrix_column.to1DSpan(), csr_arrays->m_matrix_value.to1DSpan());
   }
 
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  void toLinearSystem(DoFLinearSystem& linear_system)
+  void _spmvOrderedPerBlock(Span<const Real> x, Span<Real> y)
   {
-    auto startTime = platform::getRealTime();
-    if (m_use_csr_in_linear_system) {
-      if (!linear_system.hasSetCSRValues())
-        ARCANE_THROW(ArgumentException, "BSRFormat(toLinearSystem): Linear system was set to use CSR but is incompatible");
+    constexpr int BLOCK_SIZE_SQ = BLOCK_SIZE * BLOCK_SIZE;
+    Int32 nb_row = m_nb_row;
+    IndexType nb_col = m_nb_col;
 
-      m_bsr_matrix.toCsr(&m_csr_matrix);
+    auto command = makeCommand(m_queue);
+    auto in_row_index = viewIn(command, m_row_index);
+    auto in_columns = viewIn(command, m_columns);
+    auto in_values = viewIn(command, m_values);
 
-      info() << "BSRFormat(toLinearSystem): Set CSR values into linear system";
-      CSRFormatView csr_view(m_csr_matrix.m_matrix_row.to1DSpan(), m_csr_matrix.m_matrix_rows_nb_column.to1DSpan(), m_csr_matrix.m_matrix_column.to1DSpan(), m_csr_matrix.m_matrix_value.to1DSpan());
-      linear_system.setCSRValues(csr_view);
-    }
-    else
-      m_bsr_matrix.toLinearSystem(linear_system);
-    info() << "[ArcaneFem-Timer] Time to translate to linear system the BSR matrix = " << (platform::getRealTime() - startTime);
-  };
+    command << RUNCOMMAND_LOOP1(iter, nb_row)
+    {
+      auto [row] = iter();
+      IndexType begin = in_row_index[row];
+      IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+      if constexpr (BLOCK_SIZE == 1) {
+        Real sum = 0.0;
+        for (IndexType k = begin; k < end; ++k)
+          sum += in_values[k] * x[in_columns[k]];
+        y[row] = sum;
+      }
+      else {
+        Real sum[BLOCK_SIZE] = {};
+        for (IndexType k = begin; k < end; ++k) {
+          Int32 x_start = in_columns[k] * BLOCK_SIZE;
+          Real block[BLOCK_SIZE_SQ];
+          for (Int32 l = 0; l < BLOCK_SIZE_SQ; ++l)
+            block[l] = in_values[k * BLOCK_SIZE_SQ + l];
+          Real x_block[BLOCK_SIZE];
+          for (Int32 j = 0; j < BLOCK_SIZE; ++j)
+            x_block[j] = x[x_start + j];
+          for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+            for (Int32 j = 0; j < BLOCK_SIZE; ++j)
+              sum[i] += block[i * BLOCK_SIZE + j] * x_block[j];
+        }
+        for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+          y[row * BLOCK_SIZE + i] = sum[i];
+      }
+    };
+  }
 
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  void computeNzPerRowArray()
+  void _spmvOrderedPerRow(Span<const Real> x, Span<Real> y)
   {
-    info() << "BSRFormat(computeNzPerRowArray): Compute nb_nz_per_row BSR matrix array";
+    constexpr int BLOCK_SIZE_SQ = BLOCK_SIZE * BLOCK_SIZE;
+    Int32 nb_row = m_nb_row;
 
-    auto startTime = platform::getRealTime();
     auto command = makeCommand(m_queue);
-    NumArray<Int32, MDDim1>& nb_nz_per_row = m_bsr_matrix.nbNzPerRow();
-    auto inout_nb_nz_per_row = viewInOut(command, nb_nz_per_row);
-    auto inout_row_index = viewInOut(command, m_bsr_matrix.rowIndex());
+    auto in_row_index = viewIn(command, m_row_index);
+    auto in_columns = viewIn(command, m_columns);
+    auto in_nb_nz_per_row = viewIn(command, m_nb_nz_per_row);
+    auto in_values = viewIn(command, m_values);
 
-    auto nb_row = m_bsr_matrix.nbRow();
-    // Copy `row_index` in `nz_per_row`
-    // NOTE: Does Arcane provide a copy-on-gpu primitive ?
+    command << RUNCOMMAND_LOOP1(iter, nb_row)
     {
-      auto command = makeCommand(m_queue);
-      command << RUNCOMMAND_LOOP1(iter, nb_row)
-      {
-        auto [i] = iter();
-        inout_nb_nz_per_row[i] = inout_row_index[i];
-      };
-    }
-    m_queue.barrier();
+      auto [row] = iter();
+      IndexType begin = in_row_index[row];
+      Int32 nb_block = in_nb_nz_per_row[row];
+      // Values of a scalar row are contiguous: `nb_block * BLOCK_SIZE` values
+      Int32 row_stride = nb_block * BLOCK_SIZE;
+      IndexType values_start = begin * BLOCK_SIZE_SQ;
+      Real sum[BLOCK_SIZE] = {};
+      for (Int32 k = 0; k < nb_block; ++k) {
+        Int32 x_start = in_columns[begin + k] * BLOCK_SIZE;
+        Real x_block[BLOCK_SIZE];
+        for (Int32 j = 0; j < BLOCK_SIZE; ++j)
+          x_block[j] = x[x_start + j];
+        for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+          for (Int32 j = 0; j < BLOCK_SIZE; ++j)
+            sum[i] += in_values[values_start + i * row_stride + k * BLOCK_SIZE + j] * x_block[j];
+      }
+      for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+        y[row * BLOCK_SIZE + i] = sum[i];
+    };
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  void _spmvSymmetric(Span<const Real> x, Span<Real> y)
+  {
+    constexpr int BLOCK_SIZE_SQ = BLOCK_SIZE * BLOCK_SIZE;
+    Int32 nb_row = m_nb_row;
+    IndexType nb_col = m_nb_col;
 
     {
-      auto nb_col = m_bsr_matrix.nbCol();
       auto command = makeCommand(m_queue);
-      command << RUNCOMMAND_LOOP1(iter, nb_row)
+      command << RUNCOMMAND_LOOP1(iter, y.size())
       {
         auto [i] = iter();
-        auto x = inout_nb_nz_per_row[i];
-        if (i == nb_row - 1)
-          inout_nb_nz_per_row[i] = nb_col - inout_row_index[i];
-        else
-          inout_nb_nz_per_row[i] = inout_row_index[i + 1] - x;
+        y[i] = 0.0;
       };
     }
-    m_queue.barrier();
 
-    info() << "[ArcaneFem-Timer] Time to compute nb_nz_per_row = " << (platform::getRealTime() - startTime);
+    auto command = makeCommand(m_queue);
+    auto in_row_index = viewIn(command, m_row_index);
+    auto in_columns = viewIn(command, m_columns);
+    auto in_values = viewIn(command, m_values);
+
+    command << RUNCOMMAND_LOOP1(iter, nb_row)
+    {
+      auto [row] = iter();
+      IndexType begin = in_row_index[row];
+      IndexType end = (row == nb_row - 1) ? nb_col : in_row_index[row + 1];
+      Real x_row[BLOCK_SIZE];
+      for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+        x_row[i] = x[row * BLOCK_SIZE + i];
+      Real sum[BLOCK_SIZE] = {};
+      for (IndexType k = begin; k < end; ++k) {
+        Int32 col = in_columns[k];
+        Real block[BLOCK_SIZE_SQ];
+        for (Int32 l = 0; l < BLOCK_SIZE_SQ; ++l)
+          block[l] = in_values[k * BLOCK_SIZE_SQ + l];
+        for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+          for (Int32 j = 0; j < BLOCK_SIZE; ++j)
+            sum[i] += block[i * BLOCK_SIZE + j] * x[col * BLOCK_SIZE + j];
+        if (col != row) {
+          for (Int32 j = 0; j < BLOCK_SIZE; ++j) {
+            Real transposed_sum = 0.0;
+            for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+              transposed_sum += block[i * BLOCK_SIZE + j] * x_row[i];
+            Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(y[col * BLOCK_SIZE + j], transposed_sum);
+          }
+        }
+      }
+      for (Int32 i = 0; i < BLOCK_SIZE; ++i)
+        Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(y[row * BLOCK_SIZE + i], sum[i]);
+    };
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Linear operator applying a BSRMatrix without translating it to CSR.
+ *
+ * It is used by BSRFormat to give a symmetric matrix to a linear system
+ * supporting linear operators (NativeLinearSystem): the products use only
+ * the stored upper blocks (see `BSRMatrix::spmv()`) and the preconditioner
+ * uses the diagonal (see `BSRMatrix::computeDiagonal()`).
+ */
+/*---------------------------------------------------------------------------*/
+
+template <int BLOCK_SIZE, typename IndexType = Int32>
+class BSRLinearOperator
+: public IDoFLinearOperator
+{
+ public:
+
+  explicit BSRLinearOperator(BSRMatrix<BLOCK_SIZE, IndexType>& matrix)
+  : m_matrix(matrix)
+  {}
+
+ public:
+
+  void apply(Span<const Real> x, Span<Real> y) override { m_matrix.spmv(x, y); }
+  void computeDiagonal(Span<Real> diagonal) override { m_matrix.computeDiagonal(diagonal); }
+
+ private:
+
+  BSRMatrix<BLOCK_SIZE, IndexType>& m_matrix;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Strategy used by BSRFormat to assemble the bilinear operator
+enum class eBSRAssemblyStrategy
+{
+  //! Loop over the cells with atomic additions
+  Atomic,
+  //! Loop over the nodes, element matrices are computed for each node of the cells
+  AtomicFree,
+  //! Loop over the nodes, element matrices are computed once in a scratch buffer
+  AtomicFreeCached,
+  //! Loop over the cells one color at a time, without atomic operations
+  Colored
+};
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief A class for assembling Block Sparse Row (BSR) matrices from mesh data.
+ *
+ * The `BSRFormat` class is designed to construct and manage BSR matrices using 
+ * mesh connectivity and degree-of-freedom (DoF) information.
+ *
+ * In 2D, the sparsity is computed based on node-face connectivity, while in 3D, 
+ * node-node connectivity is used.
+ *
+ * In parallel, only the rows of the own nodes have blocks: the rows of the
+ * ghost nodes are kept (so that rows are still indexed by the DoFs) but are
+ * empty, and the ghost nodes only appear as columns. The global index of
+ * each column is given by `columnGlobalIndex()`.
+ *
+ * `IndexType` is the index type of the matrix (see `BSRMatrix`). Int64 is
+ * needed when a sub-domain has more than 2^31 values, which is checked by
+ * `initializeMatrix()`. The CSR matrix is then given to the linear system
+ * with `DoFLinearSystem::setCSRValues(const CSRFormatView64&)`.
+ *
+ * @note This class uses Arcane's accelerator api and will use GPU is possible.
+ * It uses a `BSRMatrix` under the hood for representation and operations.
+ */
+/*---------------------------------------------------------------------------*/
+
+template <int NB_DOF, typename IndexType = Int32>
+class BSRFormat : public TraceAccessor
+{
+ public:
+
+  BSRFormat(ITraceMng* tm, RunQueue& queue, const FemDoFsOnNodes& dofs_on_nodes)
+  : TraceAccessor(tm)
+  , m_dofs_on_nodes(dofs_on_nodes)
+  , m_queue(queue)
+  , m_bsr_matrix(tm, queue.memoryRessource(), queue)
+  , m_bsr_linear_operator(m_bsr_matrix)
+  , m_csr_matrix(queue.memoryRessource())
+  , m_cell_value_index(queue.memoryRessource())
+  , m_element_matrices(queue.memoryRessource())
+  , m_colored_cells(queue.memoryRessource())
+  , m_node_cell_offset(queue.memoryRessource())
+  , m_node_cell_local_index(queue.memoryRessource())
+  , m_node_row(queue.memoryRessource())
+  , m_is_own_row(queue.memoryRessource())
+  , m_column_global_index(queue.memoryRessource()) {};
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  void initialize(IMesh* mesh, bool does_linear_system_use_csr, bool use_atomic_free = false)
+  {
+    auto strategy = (use_atomic_free) ? eBSRAssemblyStrategy::AtomicFree : eBSRAssemblyStrategy::Atomic;
+    initialize(mesh, does_linear_system_use_csr, strategy);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  /**
+   * @brief Initializes the BSR matrix.
+   *
+   * If \a is_symmetric is true, only the blocks of the upper triangle are
+   * stored and assembled (see `BSRMatrix::keepUpperTriangle()`). The element
+   * matrices have to be symmetric. The values are then always ordered per
+   * block. If the linear system supports linear operators (NativeLinearSystem),
+   * the symmetric matrix is applied directly (see `BSRLinearOperator`).
+   * Otherwise the full CSR matrix is built when translating to a linear
+   * system which uses CSR.
+   *
+   * The size of the matrix is only known when the sparsity is computed
+   * (see `computeSparsity()`) because only the rows of the own nodes
+   * have blocks.
+   */
+  void initialize(IMesh* mesh, bool does_linear_system_use_csr, eBSRAssemblyStrategy assembly_strategy, bool is_symmetric = false)
+  {
+    ARCANE_CHECK_POINTER(mesh);
+
+    if (mesh->dimension() != 2 && mesh->dimension() != 3)
+      ARCANE_THROW(NotImplementedException, "BSRFormat(initialize): Only supports 2D and 3D");
+
+    auto startTime = platform::getRealTime();
+
+    m_mesh = mesh;
+    m_use_cell_sparsity = isCellSparsityNeeded(mesh);
+    m_use_csr_in_linear_system = does_linear_system_use_csr;
+    m_is_symmetric = is_symmetric;
+    m_order_values_per_block = !does_linear_system_use_csr || is_symmetric;
+    m_assembly_strategy = assembly_strategy;
+    info() << "[ArcaneFem-Timer] Time to initialize BSR format = " << (platform::getRealTime() - startTime);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  void toLinearSystem(DoFLinearSystem& linear_system)
+  {
+    auto startTime = platform::getRealTime();
+    // Allow the solver to use the block structure (e.g. systems AMG)
+    linear_system.setBlockSize(NB_DOF);
+    if (m_is_symmetric && linear_system.hasSetLinearOperator()) {
+      // Keep only the upper blocks: the eliminations and the forced values
+      // are applied by the linear system around the products
+      info() << "BSRFormat(toLinearSystem): Set symmetric BSR matrix as linear operator into linear system";
+      linear_system.setLinearOperator(&m_bsr_linear_operator);
+    }
+    else if (m_use_csr_in_linear_system) {
+      if constexpr (std::is_same_v<IndexType, Int64>) {
+        if (!linear_system.hasSetCSRValues64())
+          ARCANE_THROW(ArgumentException, "BSRFormat(toLinearSystem): Linear system was set to use CSR but does not support 64-bit indexes");
+      }
+      else if (!linear_system.hasSetCSRValues())
+        ARCANE_THROW(ArgumentException, "BSRFormat(toLinearSystem): Linear system was set to use CSR but is incompatible");
+
+      CSRFormatViewT<IndexType> csr_view = m_bsr_matrix.toCsr(&m_csr_matrix);
+      csr_view.setStructureVersion(m_structure_version);
+
+      info() << "BSRFormat(toLinearSystem): Set CSR values into linear system";
+      linear_system.setCSRValues(csr_view);
+    }
+    else
+      m_bsr_matrix.toLinearSystem(linear_system);
+    info() << "[ArcaneFem-Timer] Time to translate to linear system the BSR matrix = " << (platform::getRealTime() - startTime);
+  };
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  void computeNzPerRowArray()
+  {
+    info() << "BSRFormat(computeNzPerRowArray): Compute nb_nz_per_row BSR matrix array";
+
+    auto startTime = platform::getRealTime();
+    auto nb_row = m_bsr_matrix.nbRow();
+    auto nb_col = m_bsr_matrix.nbCol();
+    {
+      auto command = makeCommand(m_queue);
+      auto out_nb_nz_per_row = viewOut(command, m_bsr_matrix.nbNzPerRow());
+      auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
+      command << RUNCOMMAND_LOOP1(iter, nb_row)
+      {
+        auto [i] = iter();
+        IndexType end = (i == nb_row - 1) ? nb_col : in_row_index[i + 1];
+        // The number of blocks of a row always fits in an Int32
+        out_nb_nz_per_row[i] = static_cast<Int32>(end - in_row_index[i]);
+      };
+    }
+    m_queue.barrier();
+
+    info() << "[ArcaneFem-Timer] Time to compute nb_nz_per_row = " << (platform::getRealTime() - startTime);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Returns true if the block (row, col) is stored in the matrix.
+   *
+   * Only the rows of own nodes have blocks: the rows of ghost nodes are
+   * empty and their nodes are only used as columns. For a symmetric matrix,
+   * the rows of ghost nodes also keep the blocks whose column is own, as
+   * the transposed blocks are needed by the own rows (see `keepUpperTriangle()`).
+   */
+  /*---------------------------------------------------------------------------*/
+
+  ARCCORE_HOST_DEVICE static bool isBlockNeeded(bool is_own_row, bool is_own_col, bool is_symmetric)
+  {
+    return is_own_row || (is_symmetric && is_own_col);
   }
 
   /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Initializes the matrix from the number of blocks of each row.
+   *
+   * The number of blocks of the matrix is the sum of \a nb_block_per_row and
+   * the row index is its exclusive sum. The sum is done with Int64 so that
+   * a number of values which does not fit in `IndexType` is detected.
+   */
   /*---------------------------------------------------------------------------*/
 
-  void computeNeighborsAtomicFree(SmallSpan<Int32>& neighbors_ss)
+  void initializeMatrix(NumArray<IndexType, MDDim1>& nb_block_per_row)
   {
+    Int32 nb_row = nb_block_per_row.extent0();
+    Int64 nb_block = 0;
+    {
+      auto command = makeCommand(m_queue);
+      Accelerator::ReducerSum2<Int64> reducer(command);
+      auto in_nb_block_per_row = viewIn(command, nb_block_per_row);
+      command << RUNCOMMAND_LOOP1(iter, nb_row, reducer)
+      {
+        auto [row] = iter();
+        reducer.combine(in_nb_block_per_row[row]);
+      };
+      nb_block = reducer.reducedValue();
+    }
+
+    const Int64 nb_value = static_cast<Int64>(NB_DOF * NB_DOF) * nb_block;
+    if (nb_value > std::numeric_limits<IndexType>::max())
+      ARCANE_FATAL("BSRFormat(initializeMatrix): the number of values '{0}' does not fit in a 32-bit index, use Int64 as index type", nb_value);
+
+    m_bsr_matrix.initialize(static_cast<IndexType>(nb_value), static_cast<IndexType>(nb_block), nb_row, m_order_values_per_block);
+
+    Accelerator::Scanner<IndexType> scanner;
+    scanner.exclusiveSum(&m_queue, nb_block_per_row.to1DSmallSpan(), m_bsr_matrix.rowIndex().to1DSmallSpan());
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  void computeNeighborsAtomicFree(SmallSpan<IndexType>& neighbors_ss)
+  {
+    bool is_symmetric = m_is_symmetric;
     auto command = makeCommand(m_queue);
+    auto in_node_row = viewIn(command, m_node_row);
+    auto in_is_own_row = viewIn(command, m_is_own_row);
     if (m_mesh->dimension() == 2) {
       UnstructuredMeshConnectivityView connectivity_view(m_mesh);
       auto node_face_cv = connectivity_view.nodeFace();
+      auto face_node_cv = connectivity_view.faceNode();
       command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
       {
-        neighbors_ss[node_id] = node_face_cv.nbFace(node_id) + 1;
+        auto row = in_node_row[node_id];
+        bool is_own_row = in_is_own_row[row];
+        Int32 nb_block = (is_own_row) ? 1 : 0;
+        for (auto face_lid : node_face_cv.faceIds(node_id)) {
+          auto nodes = face_node_cv.nodes(face_lid);
+          auto col = in_node_row[nodes[0] == node_id ? nodes[1] : nodes[0]];
+          if (isBlockNeeded(is_own_row, in_is_own_row[col], is_symmetric))
+            ++nb_block;
+        }
+        neighbors_ss[row] = nb_block;
       };
     }
     else {
@@ -494,7 +1224,13 @@ class BSRFormat : public TraceAccessor
 
       command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
       {
-        neighbors_ss[node_id] = node_node_cv.nbNode(node_id) + 1;
+        auto row = in_node_row[node_id];
+        bool is_own_row = in_is_own_row[row];
+        Int32 nb_block = (is_own_row) ? 1 : 0;
+        for (auto neighbor_idx : node_node_cv.nodeIds(node_id))
+          if (isBlockNeeded(is_own_row, in_is_own_row[in_node_row[neighbor_idx]], is_symmetric))
+            ++nb_block;
+        neighbors_ss[row] = nb_block;
       };
     }
   }
@@ -505,13 +1241,11 @@ class BSRFormat : public TraceAccessor
   void computeRowIndexAtomicFree()
   {
     auto mem_ressource = m_queue.memoryRessource();
-    NumArray<Int32, MDDim1> neighbors(mem_ressource);
+    NumArray<IndexType, MDDim1> neighbors(mem_ressource);
     neighbors.resize(m_mesh->nbNode());
-    SmallSpan<Int32> neighbors_ss = neighbors.to1DSmallSpan();
+    SmallSpan<IndexType> neighbors_ss = neighbors.to1DSmallSpan();
     computeNeighborsAtomicFree(neighbors_ss);
-
-    Accelerator::Scanner<Int32> scanner;
-    scanner.exclusiveSum(&m_queue, neighbors_ss, m_bsr_matrix.rowIndex().to1DSmallSpan());
+    initializeMatrix(neighbors);
   }
 
   /*---------------------------------------------------------------------------*/
@@ -519,8 +1253,11 @@ class BSRFormat : public TraceAccessor
 
   void computeColumnsAtomicFree()
   {
+    bool is_symmetric = m_is_symmetric;
     auto command = makeCommand(m_queue);
     auto inout_columns = viewInOut(command, m_bsr_matrix.columns());
+    auto in_node_row = viewIn(command, m_node_row);
+    auto in_is_own_row = viewIn(command, m_is_own_row);
     auto row_index = m_bsr_matrix.rowIndex().to1DSmallSpan();
 
     if (m_mesh->dimension() == 2) {
@@ -530,15 +1267,21 @@ class BSRFormat : public TraceAccessor
 
       command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
       {
-        auto offset = row_index[node_id];
+        auto row = in_node_row[node_id];
+        bool is_own_row = in_is_own_row[row];
+        auto offset = row_index[row];
 
         for (auto face_lid : node_face_cv.faceIds(node_id)) {
           auto nodes = face_node_cv.nodes(face_lid);
-          inout_columns[offset] = nodes[0] == node_id ? nodes[1] : nodes[0];
-          ++offset;
+          auto col = in_node_row[nodes[0] == node_id ? nodes[1] : nodes[0]];
+          if (isBlockNeeded(is_own_row, in_is_own_row[col], is_symmetric)) {
+            inout_columns[offset] = col;
+            ++offset;
+          }
         }
 
-        inout_columns[offset] = node_id;
+        if (is_own_row)
+          inout_columns[offset] = row;
       };
     }
     else {
@@ -548,14 +1291,20 @@ class BSRFormat : public TraceAccessor
 
       command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
       {
-        auto offset = row_index[node_id];
+        auto row = in_node_row[node_id];
+        bool is_own_row = in_is_own_row[row];
+        auto offset = row_index[row];
 
         for (auto neighbor_idx : node_node_cv.nodeIds(node_id)) {
-          inout_columns[offset] = neighbor_idx;
-          ++offset;
+          auto col = in_node_row[neighbor_idx];
+          if (isBlockNeeded(is_own_row, in_is_own_row[col], is_symmetric)) {
+            inout_columns[offset] = col;
+            ++offset;
+          }
         }
 
-        inout_columns[offset] = node_id;
+        if (is_own_row)
+          inout_columns[offset] = row;
       };
     }
   }
@@ -611,13 +1360,14 @@ class BSRFormat : public TraceAccessor
     {
       auto command = makeCommand(m_queue);
       auto inout_edges = viewInOut(command, edges);
+      auto in_node_row = viewIn(command, m_node_row);
 
       if (m_mesh->dimension() == 2) {
         command << RUNCOMMAND_ENUMERATE(CellLocalId, cell_lid, m_mesh->allCells())
         {
-          auto n0 = cell_node_cv.nodeId(cell_lid, 0);
-          auto n1 = cell_node_cv.nodeId(cell_lid, 1);
-          auto n2 = cell_node_cv.nodeId(cell_lid, 2);
+          auto n0 = in_node_row[cell_node_cv.nodeId(cell_lid, 0)];
+          auto n1 = in_node_row[cell_node_cv.nodeId(cell_lid, 1)];
+          auto n2 = in_node_row[cell_node_cv.nodeId(cell_lid, 2)];
 
           auto start = cell_lid * edges_per_element;
           inout_edges[start] = pack(n0, n1);
@@ -628,10 +1378,10 @@ class BSRFormat : public TraceAccessor
       else {
         command << RUNCOMMAND_ENUMERATE(CellLocalId, cell_lid, m_mesh->allCells())
         {
-          auto n0 = cell_node_cv.nodeId(cell_lid, 0);
-          auto n1 = cell_node_cv.nodeId(cell_lid, 1);
-          auto n2 = cell_node_cv.nodeId(cell_lid, 2);
-          auto n3 = cell_node_cv.nodeId(cell_lid, 3);
+          auto n0 = in_node_row[cell_node_cv.nodeId(cell_lid, 0)];
+          auto n1 = in_node_row[cell_node_cv.nodeId(cell_lid, 1)];
+          auto n2 = in_node_row[cell_node_cv.nodeId(cell_lid, 2)];
+          auto n3 = in_node_row[cell_node_cv.nodeId(cell_lid, 3)];
 
           auto start = cell_lid * edges_per_element;
           inout_edges[start] = pack(n0, n1);
@@ -653,10 +1403,12 @@ class BSRFormat : public TraceAccessor
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  void computeNeighbors(Int8 edges_per_element, Int64 nb_edge_total, NumArray<Int32, MDDim1>& neighbors, SmallSpan<UInt64>& sorted_edges_ss)
+  void computeNeighbors(Int8 edges_per_element, Int64 nb_edge_total, NumArray<IndexType, MDDim1>& neighbors, SmallSpan<UInt64>& sorted_edges_ss)
   {
+    bool is_symmetric = m_is_symmetric;
     auto command = makeCommand(m_queue);
     auto inout_neighbors = viewInOut(command, neighbors);
+    auto in_is_own_row = viewIn(command, m_is_own_row);
 
     command << RUNCOMMAND_LOOP1(iter, nb_edge_total)
     {
@@ -665,8 +1417,12 @@ class BSRFormat : public TraceAccessor
       if (thread_id == (nb_edge_total - 1) || cur_edge != sorted_edges_ss[thread_id + 1]) {
         Int32 n0, n1 = 0;
         unpack(cur_edge, n0, n1);
-        Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_neighbors[n0], 1);
-        Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_neighbors[n1], 1);
+        bool is_own_n0 = in_is_own_row[n0];
+        bool is_own_n1 = in_is_own_row[n1];
+        if (isBlockNeeded(is_own_n0, is_own_n1, is_symmetric))
+          Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_neighbors[n0], 1);
+        if (isBlockNeeded(is_own_n1, is_own_n0, is_symmetric))
+          Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_neighbors[n1], 1);
       }
     };
   }
@@ -674,26 +1430,40 @@ class BSRFormat : public TraceAccessor
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
+  //! Fills \a nb_block with 1 for the own rows (diagonal block) and 0 for the other rows
+  void fillDiagonalBlockCount(NumArray<IndexType, MDDim1>& nb_block)
+  {
+    nb_block.resize(m_mesh->nbNode());
+    auto command = makeCommand(m_queue);
+    auto in_is_own_row = viewIn(command, m_is_own_row);
+    auto out_nb_block = viewOut(command, nb_block);
+    command << RUNCOMMAND_LOOP1(iter, m_mesh->nbNode())
+    {
+      auto [row] = iter();
+      out_nb_block[row] = (in_is_own_row[row]) ? 1 : 0;
+    };
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
   void computeRowIndex(Int8 edges_per_element, Int64 nb_edge_total, SmallSpan<UInt64>& sorted_edges_ss)
   {
     auto mem_ressource = m_queue.memoryRessource();
-    NumArray<Int32, MDDim1> neighbors(mem_ressource);
-    neighbors.resize(m_mesh->nbNode());
-    neighbors.fill(1, &m_queue);
+    NumArray<IndexType, MDDim1> neighbors(mem_ressource);
+    fillDiagonalBlockCount(neighbors);
     computeNeighbors(edges_per_element, nb_edge_total, neighbors, sorted_edges_ss);
-
-    Accelerator::Scanner<Int32> scanner;
-    SmallSpan<Int32> neighbors_ss = neighbors.to1DSmallSpan();
-    scanner.exclusiveSum(&m_queue, neighbors_ss, m_bsr_matrix.rowIndex().to1DSmallSpan());
+    initializeMatrix(neighbors);
   }
 
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  ARCCORE_HOST_DEVICE static void registerEdgeInColumns(Int32 src, Int32 dst, Accelerator::NumArrayView<DataViewGetterSetter<Int32>, MDDim1, DefaultLayout> offsets, Accelerator::NumArrayView<DataViewGetter<Int32>, MDDim1, DefaultLayout> row_index, Accelerator::NumArrayView<DataViewGetterSetter<Int32>, MDDim1, DefaultLayout> columns)
+  template <typename OffsetsView, typename RowIndexView, typename ColumnsView>
+  ARCCORE_HOST_DEVICE static void registerEdgeInColumns(Int32 src, Int32 dst, OffsetsView offsets, RowIndexView row_index, ColumnsView columns)
   {
-    Int32 start = row_index[src];
-    Int32 offset = Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(offsets[src], 1);
+    IndexType start = row_index[src];
+    IndexType offset = Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(offsets[src], 1);
     columns[start + offset] = dst;
   }
 
@@ -703,30 +1473,32 @@ class BSRFormat : public TraceAccessor
   void computeColumns(Int8 edges_per_element, Int64 nb_edge_total, SmallSpan<uint64_t>& sorted_edges_ss)
   {
     auto nb_node = m_mesh->nbNode();
+    bool is_symmetric = m_is_symmetric;
 
     {
       auto command = makeCommand(m_queue);
       auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
+      auto in_is_own_row = viewIn(command, m_is_own_row);
       auto inout_columns = viewInOut(command, m_bsr_matrix.columns());
 
       command << RUNCOMMAND_LOOP1(iter, nb_node)
       {
         auto [n] = iter();
-        auto start = in_row_index[n];
-        inout_columns[start] = n;
+        if (in_is_own_row[n])
+          inout_columns[in_row_index[n]] = n;
       };
     }
     m_queue.barrier();
 
     auto mem_ressource = m_queue.memoryRessource();
-    NumArray<Int32, MDDim1> offsets(mem_ressource);
-    offsets.resize(nb_node);
-    offsets.fill(1, &m_queue);
+    NumArray<IndexType, MDDim1> offsets(mem_ressource);
+    fillDiagonalBlockCount(offsets);
 
     {
       auto command = makeCommand(m_queue);
       auto inout_columns = viewInOut(command, m_bsr_matrix.columns());
       auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
+      auto in_is_own_row = viewIn(command, m_is_own_row);
       auto inout_offsets = viewInOut(command, offsets);
 
       command << RUNCOMMAND_LOOP1(iter, nb_edge_total)
@@ -736,8 +1508,12 @@ class BSRFormat : public TraceAccessor
         if (thread_id == (nb_edge_total - 1) || cur_edge != sorted_edges_ss[thread_id + 1]) {
           Int32 n0, n1 = 0;
           unpack(cur_edge, n0, n1);
-          registerEdgeInColumns(n0, n1, inout_offsets, in_row_index, inout_columns);
-          registerEdgeInColumns(n1, n0, inout_offsets, in_row_index, inout_columns);
+          bool is_own_n0 = in_is_own_row[n0];
+          bool is_own_n1 = in_is_own_row[n1];
+          if (isBlockNeeded(is_own_n0, is_own_n1, is_symmetric))
+            registerEdgeInColumns(n0, n1, inout_offsets, in_row_index, inout_columns);
+          if (isBlockNeeded(is_own_n1, is_own_n0, is_symmetric))
+            registerEdgeInColumns(n1, n0, inout_offsets, in_row_index, inout_columns);
         }
       };
     }
@@ -769,130 +1545,481 @@ class BSRFormat : public TraceAccessor
       computeNzPerRowArray();
   }
 
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Returns true if the sparsity has to be computed from the cell-node connectivity.
+   *
+   * The edge-based sparsity (faces in 2D and edges in 3D) is only valid for
+   * linear simplices (Triangle3 and Tetraedron4) because all the nodes of
+   * these cells are connected by an edge. The other cells (Quad4, Hexa8,
+   * Tria6, Tetra10, ...) couple nodes that are not neighbors by an edge.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  static bool isCellSparsityNeeded(IMesh* mesh)
+  {
+    Int16 linear_simplex_type = (mesh->dimension() == 2) ? IT_Triangle3 : IT_Tetraedron4;
+    ENUMERATE_CELL (icell, mesh->allCells()) {
+      if ((*icell).type() != linear_simplex_type)
+        return true;
+    }
+    return false;
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes the sorted list of the pairs of nodes of each cell.
+   *
+   * Each pair `(n0, n1)` with `n0 < n1` of nodes of a cell is packed in an
+   * `UInt64` (see `pack()`). A pair shared by several cells appears several
+   * times in \a sorted_pairs. Returns the number of pairs.
+   *
+   * The sort needs 32-bit sizes: it is a fatal error if the number of
+   * pairs does not fit in an Int32.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  Int64 computeSortedCellNodePairs(NumArray<UInt64, MDDim1>& sorted_pairs)
+  {
+    UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
+    auto cell_node_cv = m_connectivity_view.cellNode();
+
+    auto mem_ressource = m_queue.memoryRessource();
+    Int32 max_cell_lid = m_mesh->cellFamily()->maxLocalId();
+    NumArray<Int64, MDDim1> nb_pair_per_cell(mem_ressource);
+    nb_pair_per_cell.resize(max_cell_lid);
+    nb_pair_per_cell.fill(0, &m_queue);
+    {
+      auto command = makeCommand(m_queue);
+      auto out_nb_pair_per_cell = viewOut(command, nb_pair_per_cell);
+      command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
+      {
+        auto nb_node = cell_node_cv.nbNode(cell);
+        out_nb_pair_per_cell[cell] = (nb_node * (nb_node - 1)) / 2;
+      };
+    }
+    Int64 nb_pair_total = 0;
+    {
+      auto command = makeCommand(m_queue);
+      Accelerator::ReducerSum2<Int64> reducer(command);
+      auto in_nb_pair_per_cell = viewIn(command, nb_pair_per_cell);
+      command << RUNCOMMAND_LOOP1(iter, max_cell_lid, reducer)
+      {
+        auto [cell_lid] = iter();
+        reducer.combine(in_nb_pair_per_cell[cell_lid]);
+      };
+      nb_pair_total = reducer.reducedValue();
+    }
+    // The pairs are sorted and indexed with 32-bit sizes
+    if (nb_pair_total > std::numeric_limits<Int32>::max())
+      ARCANE_FATAL("BSRFormat(computeSortedCellNodePairs): the number of node pairs '{0}' does not fit in a 32-bit index", nb_pair_total);
+
+    // The offsets have the type of the number of pairs
+    NumArray<Int64, MDDim1> pair_offsets(mem_ressource);
+    pair_offsets.resize(max_cell_lid);
+    Accelerator::Scanner<Int64> scanner;
+    scanner.exclusiveSum(&m_queue, nb_pair_per_cell.to1DSmallSpan(), pair_offsets.to1DSmallSpan());
+
+    NumArray<UInt64, MDDim1> pairs(mem_ressource);
+    pairs.resize(nb_pair_total);
+    {
+      auto command = makeCommand(m_queue);
+      auto in_pair_offsets = viewIn(command, pair_offsets);
+      auto in_node_row = viewIn(command, m_node_row);
+      auto out_pairs = viewOut(command, pairs);
+      command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
+      {
+        // Fits in Int32 because the number of pairs has been checked
+        Int32 offset = static_cast<Int32>(in_pair_offsets[cell]);
+        auto nb_node = cell_node_cv.nbNode(cell);
+        for (Int32 i = 0; i < nb_node; ++i) {
+          auto n0 = in_node_row[cell_node_cv.nodeId(cell, i)];
+          for (Int32 j = i + 1; j < nb_node; ++j) {
+            out_pairs[offset] = pack(n0, in_node_row[cell_node_cv.nodeId(cell, j)]);
+            ++offset;
+          }
+        }
+      };
+    }
+    m_queue.barrier();
+
+    sorted_pairs.resize(nb_pair_total);
+    auto sorter = Accelerator::GenericSorter(m_queue);
+    SmallSpan<const UInt64> pairs_ss = pairs.to1DSmallSpan();
+    sorter.apply(pairs_ss, sorted_pairs.to1DSmallSpan());
+    return nb_pair_total;
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes the sparsity from the cell-node connectivity.
+   *
+   * Two nodes are coupled if they share a cell. The pairs of nodes of all
+   * the cells are sorted and each distinct pair adds one block in the two
+   * rows of its nodes. It works for any type of cell, including higher-order
+   * and mixed meshes.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void computeSparsityFromCells()
+  {
+    info() << "BSRFormat(computeSparsityFromCells): Computing sparsity of BSR matrix from cell-node connectivity...";
+    auto startTime = platform::getRealTime();
+
+    NumArray<UInt64, MDDim1> sorted_pairs(m_queue.memoryRessource());
+    Int64 nb_pair_total = computeSortedCellNodePairs(sorted_pairs);
+    auto sorted_pairs_ss = sorted_pairs.to1DSmallSpan();
+
+    // The number of edges per element is not used by these methods
+    computeRowIndex(0, nb_pair_total, sorted_pairs_ss);
+    computeColumns(0, nb_pair_total, sorted_pairs_ss);
+
+    info() << "[ArcaneFem-Timer] Time to compute the sparsity of BSR matrix (from cell-node connectivity) = " << (platform::getRealTime() - startTime);
+
+    if (m_use_csr_in_linear_system)
+      computeNzPerRowArray();
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes the block row of each node.
+   *
+   * The rows of the matrix follow the numbering of the DoFs: the block row
+   * of a node is the local id of its first DoF divided by `NB_DOF`. It is
+   * the local id of the node unless the nodes were renumbered by
+   * `FemDoFsOnNodes` (see `eNodeRenumbering`). All the sparsity and
+   * assembly methods go through this array to find the row of a node.
+   * It also computes which rows belong to own nodes.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void computeNodeRow()
+  {
+    auto node_dof(m_dofs_on_nodes.nodeDoFConnectivityView());
+    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    m_node_row.resize(m_mesh->nodeFamily()->maxLocalId());
+    m_is_own_row.resize(m_mesh->nbNode());
+
+    auto command = makeCommand(m_queue);
+    auto out_node_row = viewOut(command, m_node_row);
+    auto out_is_own_row = viewOut(command, m_is_own_row);
+    command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
+    {
+      auto row = node_dof.dofId(node_id, 0) / NB_DOF;
+      out_node_row[node_id] = row;
+      out_is_own_row[row] = (nodes_infos.isOwn(node_id)) ? 1 : 0;
+    };
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes the global index of each block column.
+   *
+   * The own rows of all the sub-domains are numbered contiguously, in the
+   * order of the ranks and then of the rows. The index of a ghost column
+   * is the one given by its owner. It gives the local-to-global column map
+   * needed to build a distributed matrix from the own rows.
+   *
+   * It is only called by `columnGlobalIndex()`, the first time the map is
+   * needed after `computeSparsity()`.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void computeColumnGlobalIndex()
+  {
+    IParallelMng* pm = m_mesh->parallelMng();
+    NodeGroup own_nodes = m_mesh->ownNodes();
+    const Int32 nb_own_row = own_nodes.size();
+
+    Int64 first_own_row = 0;
+    if (pm->isParallel()) {
+      UniqueArray<Int32> nb_own_row_per_rank(pm->commSize());
+      pm->allGather(ConstArrayView<Int32>(1, &nb_own_row), nb_own_row_per_rank);
+      for (Int32 i = 0; i < pm->commRank(); ++i)
+        first_own_row += nb_own_row_per_rank[i];
+    }
+
+    NumArray<Int32, MDDim1> node_row(eMemoryRessource::Host);
+    node_row.copy(m_node_row);
+    UniqueArray<Int32> own_rows;
+    own_rows.reserve(nb_own_row);
+    ENUMERATE_NODE (inode, own_nodes) {
+      own_rows.add(node_row[inode.itemLocalId()]);
+    }
+    std::sort(own_rows.begin(), own_rows.end());
+
+    NumArray<Int64, MDDim1> column_global_index(eMemoryRessource::Host);
+    column_global_index.resize(m_mesh->nbNode());
+    for (Int32 i = 0; i < nb_own_row; ++i)
+      column_global_index[own_rows[i]] = first_own_row + i;
+
+    if (pm->isParallel()) {
+      VariableNodeInt64 node_global_row(VariableBuildInfo(m_mesh, "BSRFormatNodeGlobalRow", IVariable::PNoDump | IVariable::PNoRestore));
+      ENUMERATE_NODE (inode, own_nodes) {
+        node_global_row[inode] = column_global_index[node_row[inode.itemLocalId()]];
+      }
+      node_global_row.synchronize();
+      ENUMERATE_NODE (inode, m_mesh->allNodes()) {
+        column_global_index[node_row[inode.itemLocalId()]] = node_global_row[inode];
+      }
+    }
+    m_column_global_index.copy(column_global_index);
+    m_is_column_global_index_valid = true;
+
+    info() << "BSRFormat(computeColumnGlobalIndex): nb_own_row=" << nb_own_row << " nb_ghost_row=" << (m_mesh->nbNode() - nb_own_row)
+           << " first_own_row=" << first_own_row;
+  }
+
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
   void computeSparsity()
   {
-    if (m_use_atomic_free)
+    computeNodeRow();
+    m_is_column_global_index_valid = false;
+    if (m_use_cell_sparsity)
+      computeSparsityFromCells();
+    else if (m_assembly_strategy != eBSRAssemblyStrategy::Atomic)
       computeSparsityAtomicFree();
     else
       computeSparsityAtomic();
+    if (m_is_symmetric) {
+      m_bsr_matrix.keepUpperTriangle();
+      if (m_use_csr_in_linear_system)
+        computeNzPerRowArray();
+    }
+    computeScatterMap();
+    if (m_assembly_strategy == eBSRAssemblyStrategy::Colored)
+      computeCellColoring();
+    else if (m_assembly_strategy != eBSRAssemblyStrategy::Atomic)
+      computeNodeCellLocalIndex();
+    m_structure_version = newCSRStructureVersion();
   }
 
   /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes the position in the BSR values of each block of the element matrices.
+   *
+   * For each cell and each pair `(row_node_idx, col_node_idx)` of local
+   * indexes of its nodes, the scatter map stores the index in `values` of the
+   * first coefficient of the block `(row_node, col_node)`. The other
+   * coefficients of the block are at `index + i * row_stride + j` with
+   * `row_stride = NB_DOF` when values are ordered per block and
+   * `row_stride = NB_DOF * nb_nz_per_row[row_node]` when they are ordered per row.
+   * The index is `-1` when the row node is not own (or when the block is not
+   * in the sparsity).
+   *
+   * For a symmetric matrix, only the blocks with `row_node <= col_node` are
+   * mapped, for which the row node or the column node is own: the
+   * transposed block is needed by the row of the column node.
+   *
+   * The map is only valid for the current sparsity and has to be computed
+   * again if the mesh changes. It is computed by `computeSparsity()` so that
+   * the assembly does not need to search the columns of the rows.
+   */
   /*---------------------------------------------------------------------------*/
 
-  template <class Function>
-  void assembleBilinearOrderedPerBlock(Function compute_element_matrix)
+  void computeScatterMap()
   {
+    info() << "BSRFormat(computeScatterMap): Compute position of element blocks in BSR matrix";
+    auto startTime = platform::getRealTime();
+
+    Int32 max_nb_node_per_cell = 0;
+    ENUMERATE_CELL (icell, m_mesh->allCells()) {
+      Cell cell = *icell;
+      if (cell.nbNode() > max_nb_node_per_cell)
+        max_nb_node_per_cell = cell.nbNode();
+    }
+    m_max_nb_node_per_cell = max_nb_node_per_cell;
+    auto map_stride = max_nb_node_per_cell * max_nb_node_per_cell;
+    m_cell_value_index.resize(m_mesh->cellFamily()->maxLocalId() * map_stride);
+
     UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
     auto cell_node_cv = m_connectivity_view.cellNode();
-
     ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
 
     constexpr int NB_DOF_SQ = NB_DOF * NB_DOF;
     auto matrix_nb_row = m_bsr_matrix.nbRow();
     auto matrix_nb_column = m_bsr_matrix.nbCol();
-    auto matrix_nb_nz = m_bsr_matrix.nbNz();
-
-    auto node_dof(m_dofs_on_nodes.nodeDoFConnectivityView());
+    bool order_values_per_block = m_bsr_matrix.orderValuePerBlock();
+    bool is_symmetric = m_is_symmetric;
 
     auto command = makeCommand(m_queue);
     auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
     auto in_columns = viewIn(command, m_bsr_matrix.columns());
-    auto inout_values = viewInOut(command, m_bsr_matrix.values());
-    auto in_nz_per_row = viewIn(command, m_bsr_matrix.nbNzPerRow());
+    auto out_cell_value_index = viewOut(command, m_cell_value_index);
+    auto in_node_row = viewIn(command, m_node_row);
 
     command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
     {
-      auto element_matrix = compute_element_matrix(cell);
-
+      auto cell_offset = cell.asInt32() * map_stride;
       auto cur_row_node_idx = 0;
       for (NodeLocalId row_node_lid : cell_node_cv.nodes(cell)) {
         auto cur_col_node_idx = 0;
         for (NodeLocalId col_node_lid : cell_node_cv.nodes(cell)) {
-          if (nodes_infos.isOwn(row_node_lid)) {
-            auto begin = in_row_index[row_node_lid];
-            auto end = (row_node_lid == matrix_nb_row - 1) ? matrix_nb_column : in_row_index[row_node_lid + 1];
-            while (begin < end) {
-              if (in_columns[begin] == col_node_lid) {
-                auto block_start = begin * NB_DOF_SQ;
-                for (auto i = 0; i < NB_DOF; ++i) {
-                  for (auto j = 0; j < NB_DOF; ++j) {
-                    double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
-                    Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_values[block_start + (i * NB_DOF + j)], value);
-                  }
-                }
+          IndexType value_index = -1;
+          auto row = in_node_row[row_node_lid];
+          auto col = in_node_row[col_node_lid];
+          bool is_block_needed = (is_symmetric) ? (row <= col && (nodes_infos.isOwn(row_node_lid) || nodes_infos.isOwn(col_node_lid))) : nodes_infos.isOwn(row_node_lid);
+          if (is_block_needed) {
+            auto row_begin = in_row_index[row];
+            auto end = (row == matrix_nb_row - 1) ? matrix_nb_column : in_row_index[row + 1];
+            for (auto begin = row_begin; begin < end; ++begin) {
+              if (in_columns[begin] == col) {
+                if (order_values_per_block)
+                  value_index = begin * NB_DOF_SQ;
+                else
+                  value_index = row_begin * NB_DOF_SQ + NB_DOF * (begin - row_begin);
                 break;
               }
-              ++begin;
             }
           }
+          out_cell_value_index[cell_offset + cur_row_node_idx * max_nb_node_per_cell + cur_col_node_idx] = value_index;
           ++cur_col_node_idx;
         }
         ++cur_row_node_idx;
       }
     };
+
+    info() << "[ArcaneFem-Timer] Time to compute the scatter map of BSR matrix = " << (platform::getRealTime() - startTime);
   }
 
   /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes a coloring of the cells for the colored assembly.
+   *
+   * Two cells sharing a node get different colors so that the cells of one
+   * color never write in the same rows of the matrix. The coloring is a
+   * greedy one: the cells are taken in the order of the mesh and each cell
+   * gets the smallest color not used by its neighbors. It is done once on
+   * the host and the cells are then grouped per color.
+   */
   /*---------------------------------------------------------------------------*/
 
-  template <class Function> void assembleBilinearOrderedPerRow(Function compute_element_matrix)
+  void computeCellColoring()
+  {
+    info() << "BSRFormat(computeCellColoring): Compute coloring of the cells";
+    auto startTime = platform::getRealTime();
+
+    UniqueArray<Int32> cell_colors(m_mesh->cellFamily()->maxLocalId());
+    cell_colors.fill(-1);
+    // Last cell for which the color is used by a neighbor
+    UniqueArray<Int32> forbidden_colors;
+    Int32 nb_color = 0;
+    ENUMERATE_CELL (icell, m_mesh->allCells()) {
+      Cell cell = *icell;
+      for (Node node : cell.nodes())
+        for (Cell neighbor_cell : node.cells()) {
+          Int32 neighbor_color = cell_colors[neighbor_cell.localId()];
+          if (neighbor_color >= 0)
+            forbidden_colors[neighbor_color] = cell.localId();
+        }
+      Int32 color = 0;
+      while (color < nb_color && forbidden_colors[color] == cell.localId())
+        ++color;
+      if (color == nb_color) {
+        forbidden_colors.add(-1);
+        ++nb_color;
+      }
+      cell_colors[cell.localId()] = color;
+    }
+
+    // Group the cells per color (counting sort)
+    m_color_offsets.resize(nb_color + 1);
+    m_color_offsets.fill(0);
+    ENUMERATE_CELL (icell, m_mesh->allCells()) {
+      ++m_color_offsets[cell_colors[icell.localId()] + 1];
+    }
+    for (Int32 color = 0; color < nb_color; ++color)
+      m_color_offsets[color + 1] += m_color_offsets[color];
+
+    NumArray<Int32, MDDim1> colored_cells(eMemoryRessource::Host);
+    colored_cells.resize(m_mesh->allCells().size());
+    UniqueArray<Int32> position(m_color_offsets.subConstView(0, nb_color));
+    ENUMERATE_CELL (icell, m_mesh->allCells()) {
+      colored_cells[position[cell_colors[icell.localId()]]++] = icell.localId();
+    }
+    m_colored_cells.copy(colored_cells);
+
+    info() << "BSRFormat(computeCellColoring): nb_color=" << nb_color;
+    info() << "[ArcaneFem-Timer] Time to compute the coloring of the cells = " << (platform::getRealTime() - startTime);
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  template <class Function>
+  void assembleBilinearOrderedPerBlock(Function compute_element_matrix)
   {
     UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
     auto cell_node_cv = m_connectivity_view.cellNode();
 
-    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    auto max_nb_node_per_cell = m_max_nb_node_per_cell;
+    auto map_stride = max_nb_node_per_cell * max_nb_node_per_cell;
 
-    constexpr int NB_DOF_SQ = NB_DOF * NB_DOF;
-    auto matrix_nb_row = m_bsr_matrix.nbRow();
-    auto matrix_nb_column = m_bsr_matrix.nbCol();
-    auto matrix_nb_nz = m_bsr_matrix.nbNz();
+    auto command = makeCommand(m_queue);
+    auto inout_values = viewInOut(command, m_bsr_matrix.values());
+    auto in_cell_value_index = viewIn(command, m_cell_value_index);
 
-    auto node_dof(m_dofs_on_nodes.nodeDoFConnectivityView());
+    command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
+    {
+      auto element_matrix = compute_element_matrix(cell);
+      auto cell_offset = cell.asInt32() * map_stride;
+      auto nb_node = cell_node_cv.nbNode(cell);
+
+      for (Int32 cur_row_node_idx = 0; cur_row_node_idx < nb_node; ++cur_row_node_idx) {
+        for (Int32 cur_col_node_idx = 0; cur_col_node_idx < nb_node; ++cur_col_node_idx) {
+          auto block_start = in_cell_value_index[cell_offset + cur_row_node_idx * max_nb_node_per_cell + cur_col_node_idx];
+          if (block_start < 0)
+            continue;
+          for (auto i = 0; i < NB_DOF; ++i) {
+            for (auto j = 0; j < NB_DOF; ++j) {
+              double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
+              Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_values[block_start + (i * NB_DOF + j)], value);
+            }
+          }
+        }
+      }
+    };
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /*---------------------------------------------------------------------------*/
+
+  template <class Function> void assembleBilinearOrderedPerRow(Function compute_element_matrix)
+  {
+    UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
+    auto cell_node_cv = m_connectivity_view.cellNode();
+
+    auto max_nb_node_per_cell = m_max_nb_node_per_cell;
+    auto map_stride = max_nb_node_per_cell * max_nb_node_per_cell;
 
     auto command = makeCommand(m_queue);
-    auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
-    auto in_columns = viewIn(command, m_bsr_matrix.columns());
     auto inout_values = viewInOut(command, m_bsr_matrix.values());
     auto in_nz_per_row = viewIn(command, m_bsr_matrix.nbNzPerRow());
+    auto in_node_row = viewIn(command, m_node_row);
+    auto in_cell_value_index = viewIn(command, m_cell_value_index);
 
     command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
     {
       auto element_matrix = compute_element_matrix(cell);
-
-      auto cur_row_node_idx = 0;
-      for (NodeLocalId row_node_lid : cell_node_cv.nodes(cell)) {
-        auto cur_col_node_idx = 0;
-        for (NodeLocalId col_node_lid : cell_node_cv.nodes(cell)) {
-          if (nodes_infos.isOwn(row_node_lid)) {
-
-            auto g_block_start = in_row_index[row_node_lid] * NB_DOF_SQ;
-            auto begin = in_row_index[row_node_lid];
-            auto end = (row_node_lid == matrix_nb_row - 1) ? matrix_nb_column : in_row_index[row_node_lid + 1];
-
-            auto x = 0;
-            while (begin < end) {
-              if (in_columns[begin] == col_node_lid) {
-                for (auto i = 0; i < NB_DOF; ++i) {
-                  for (auto j = 0; j < NB_DOF; ++j) {
-                    double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
-                    auto l_block_start = g_block_start + (NB_DOF * x);
-                    if (i != 0)
-                      l_block_start += (NB_DOF * in_nz_per_row[row_node_lid]);
-                    Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_values[l_block_start + j], value);
-                  }
-                }
-              }
-              ++begin;
-              ++x;
+      auto cell_offset = cell.asInt32() * map_stride;
+      auto nb_node = cell_node_cv.nbNode(cell);
+
+      for (Int32 cur_row_node_idx = 0; cur_row_node_idx < nb_node; ++cur_row_node_idx) {
+        // Values of the same row of a block are separated by the whole scalar row.
+        auto row_stride = NB_DOF * in_nz_per_row[in_node_row[cell_node_cv.nodeId(cell, cur_row_node_idx)]];
+        for (Int32 cur_col_node_idx = 0; cur_col_node_idx < nb_node; ++cur_col_node_idx) {
+          auto block_start = in_cell_value_index[cell_offset + cur_row_node_idx * max_nb_node_per_cell + cur_col_node_idx];
+          if (block_start < 0)
+            continue;
+          for (auto i = 0; i < NB_DOF; ++i) {
+            for (auto j = 0; j < NB_DOF; ++j) {
+              double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
+              Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(inout_values[block_start + i * row_stride + j], value);
             }
           }
-          ++cur_col_node_idx;
         }
-        ++cur_row_node_idx;
       }
     };
   }
@@ -932,171 +2059,301 @@ class BSRFormat : public TraceAccessor
   }
 
   /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes the local index of each node in each of its cells.
+   *
+   * For the `k`-th cell of a node (in the order of the node-cell
+   * connectivity), `m_node_cell_local_index[m_node_cell_offset[node] + k]`
+   * is the index of the node in the nodes of the cell. It is used by the
+   * node-wise (atomic-free) assemblies to find the rows of the element
+   * matrices without searching the node in the cell, and works for any
+   * type of cell.
+   */
   /*---------------------------------------------------------------------------*/
 
-  template <class Function>
-  void assembleBilinearOrderedPerBlockAtomicFree(Function compute_element_matrix)
+  void computeNodeCellLocalIndex()
   {
+    info() << "BSRFormat(computeNodeCellLocalIndex): Compute local index of nodes in their cells";
+    auto startTime = platform::getRealTime();
+
     UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
     auto cell_node_cv = m_connectivity_view.cellNode();
     auto node_cell_cv = m_connectivity_view.nodeCell();
 
-    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    Int32 nb_node = m_mesh->nbNode();
+    Int32 nb_node_cell = 0;
+    ENUMERATE_NODE (inode, m_mesh->allNodes()) {
+      nb_node_cell += (*inode).nbCell();
+    }
 
-    constexpr int NB_DOF_SQ = NB_DOF * NB_DOF;
-    auto matrix_nb_row = m_bsr_matrix.nbRow();
-    auto matrix_nb_column = m_bsr_matrix.nbCol();
-    auto matrix_nb_nz = m_bsr_matrix.nbNz();
+    auto mem_ressource = m_queue.memoryRessource();
+    NumArray<Int32, MDDim1> nb_cell_per_node(mem_ressource);
+    nb_cell_per_node.resize(nb_node);
+    {
+      auto command = makeCommand(m_queue);
+      auto out_nb_cell_per_node = viewOut(command, nb_cell_per_node);
+      command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
+      {
+        out_nb_cell_per_node[node_id] = node_cell_cv.nbCell(node_id);
+      };
+    }
+    m_node_cell_offset.resize(nb_node);
+    Accelerator::Scanner<Int32> scanner;
+    scanner.exclusiveSum(&m_queue, nb_cell_per_node.to1DSmallSpan(), m_node_cell_offset.to1DSmallSpan());
 
+    m_node_cell_local_index.resize(nb_node_cell);
     auto command = makeCommand(m_queue);
-    auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
-    auto in_columns = viewIn(command, m_bsr_matrix.columns());
-    auto inout_values = viewInOut(command, m_bsr_matrix.values());
+    auto in_node_cell_offset = viewIn(command, m_node_cell_offset);
+    auto out_node_cell_local_index = viewOut(command, m_node_cell_local_index);
 
-    command << RUNCOMMAND_ENUMERATE(Node, row_node, m_mesh->allNodes())
+    command << RUNCOMMAND_ENUMERATE(Node, node_id, m_mesh->allNodes())
     {
-      auto cur_row_node_idx = 0;
-      for (auto cell : node_cell_cv.cells(row_node)) {
-
-        // Find the index of the node in the current cell
-        for (Int32 i = 1; i <= 3; ++i) {
-          if (row_node == cell_node_cv.nodeId(cell, i)) {
-            cur_row_node_idx = i;
+      auto offset = in_node_cell_offset[node_id];
+      for (auto cell : node_cell_cv.cells(node_id)) {
+        Int32 local_index = -1;
+        for (Int32 i = 0, n = cell_node_cv.nbNode(cell); i < n; ++i) {
+          if (cell_node_cv.nodeId(cell, i) == node_id) {
+            local_index = i;
             break;
           }
-          cur_row_node_idx = 0;
         }
+        out_node_cell_local_index[offset] = local_index;
+        ++offset;
+      }
+    };
 
-        auto element_matrix = compute_element_matrix(cell);
+    info() << "[ArcaneFem-Timer] Time to compute the local index of nodes in cells = " << (platform::getRealTime() - startTime);
+  }
 
-        auto cur_col_node_idx = 0;
-        for (NodeLocalId col_node_lid : cell_node_cv.nodes(cell)) {
-          if (nodes_infos.isOwn(row_node)) {
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Assembles the global BSR matrix for a bilinear operator, node-wise.
+   *
+   * This function constructs the Block Sparse Row (BSR) matrix by iterating over mesh nodes
+   * and accumulating contributions from element-level matrices. It uses a user-defined
+   * callback to compute the local matrix for each cell and updates the global matrix.
+   *
+   * ### Parameters:
+   * - `compute_element_matrix`: A callback function that computes the local matrix
+   *   for a given cell. It must return a matrix compatible with the expected block size.
+   *
+   * ### Key Details:
+   * - Uses cell-to-node, node-to-cell connectivity from the mesh and DoF mappings for assembly.
+   * - The local index of the node in each of its cells is precomputed (see `computeNodeCellLocalIndex()`)
+   *   so any type of cell can be used.
+   * - Handles block structure updates for `blockSize x blockSize` dimensions.
+   *
+   */
+  /*---------------------------------------------------------------------------*/
 
-            auto begin = in_row_index[row_node];
-            auto end = (row_node == matrix_nb_row - 1) ? matrix_nb_column : in_row_index[row_node + 1];
+  template <class Function> void assembleBilinearAtomicFree(Function compute_element_matrix)
+  {
+    info() << "BSRFormat(assembleBilinearAtomicFree): Integrating over nodes...";
+    auto startTime = platform::getRealTime();
 
-            while (begin < end) {
-              if (in_columns[begin] == col_node_lid) {
-                auto block_start = begin * NB_DOF_SQ;
+    UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
+    auto cell_node_cv = m_connectivity_view.cellNode();
+    auto node_cell_cv = m_connectivity_view.nodeCell();
 
-                for (auto i = 0; i < NB_DOF; ++i) {
-                  for (auto j = 0; j < NB_DOF; ++j) {
-                    double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
-                    inout_values[block_start + (i * NB_DOF + j)] += value;
-                  }
-                }
-                break;
+    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+
+    auto max_nb_node_per_cell = m_max_nb_node_per_cell;
+    auto map_stride = max_nb_node_per_cell * max_nb_node_per_cell;
+    bool order_values_per_block = m_bsr_matrix.orderValuePerBlock();
+    // With symmetric storage, rows of ghost nodes hold blocks needed by own nodes
+    bool is_symmetric = m_is_symmetric;
+
+    auto command = makeCommand(m_queue);
+    auto inout_values = viewInOut(command, m_bsr_matrix.values());
+    auto in_nz_per_row = viewIn(command, m_bsr_matrix.nbNzPerRow());
+    auto in_node_row = viewIn(command, m_node_row);
+    auto in_cell_value_index = viewIn(command, m_cell_value_index);
+    auto in_node_cell_offset = viewIn(command, m_node_cell_offset);
+    auto in_node_cell_local_index = viewIn(command, m_node_cell_local_index);
+
+    command << RUNCOMMAND_ENUMERATE(Node, row_node, m_mesh->allNodes())
+    {
+      if (is_symmetric || nodes_infos.isOwn(row_node)) {
+        auto row_stride = (order_values_per_block) ? NB_DOF : NB_DOF * in_nz_per_row[in_node_row[row_node]];
+        auto local_index_offset = in_node_cell_offset[row_node];
+        for (auto cell : node_cell_cv.cells(row_node)) {
+          auto cur_row_node_idx = in_node_cell_local_index[local_index_offset];
+          ++local_index_offset;
+
+          auto element_matrix = compute_element_matrix(cell);
+
+          auto nb_node = cell_node_cv.nbNode(cell);
+          auto map_offset = cell.asInt32() * map_stride + cur_row_node_idx * max_nb_node_per_cell;
+          for (Int32 cur_col_node_idx = 0; cur_col_node_idx < nb_node; ++cur_col_node_idx) {
+            auto block_start = in_cell_value_index[map_offset + cur_col_node_idx];
+            if (block_start < 0)
+              continue;
+            for (auto i = 0; i < NB_DOF; ++i) {
+              for (auto j = 0; j < NB_DOF; ++j) {
+                double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
+                inout_values[block_start + i * row_stride + j] += value;
               }
-              ++begin;
             }
           }
-          ++cur_col_node_idx;
         }
       }
     };
-  };
+
+    info() << "[ArcaneFem-Timer] Time to assemble (atomic-free implementation) BSR matrix = " << (platform::getRealTime() - startTime);
+  }
 
   /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Assembles the global BSR matrix node-wise with element matrices computed once.
+   *
+   * The element matrices are first computed cell-wise into a scratch buffer.
+   * Then each row node sums the blocks of its cells at the positions given
+   * by the scatter map (see `computeScatterMap()`). As for the atomic-free
+   * approach, each row is only written by its node so no atomic operation
+   * is needed and the result is deterministic, but each element matrix is
+   * computed once instead of once per node of the cell.
+   *
+   * The scratch buffer uses `nb_cell * element_matrix_size` reals.
+   */
   /*---------------------------------------------------------------------------*/
 
-  template <class Function>
-  void assembleBilinearOrderedPerRowAtomicFree(Function compute_element_matrix)
+  template <class Function> void assembleBilinearAtomicFreeCached(Function compute_element_matrix)
   {
+    info() << "BSRFormat(assembleBilinearAtomicFreeCached): Integrating over elements then nodes...";
+    auto startTime = platform::getRealTime();
+
+    using ElementMatrixType = decltype(compute_element_matrix(CellLocalId(0)));
+    constexpr Int32 ELEMENT_MATRIX_SIZE = ElementMatrixType::totalNbElement();
+
     UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
     auto cell_node_cv = m_connectivity_view.cellNode();
     auto node_cell_cv = m_connectivity_view.nodeCell();
 
-    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    m_element_matrices.resize(m_mesh->cellFamily()->maxLocalId() * ELEMENT_MATRIX_SIZE);
 
-    constexpr int NB_DOF_SQ = NB_DOF * NB_DOF;
-    auto matrix_nb_row = m_bsr_matrix.nbRow();
-    auto matrix_nb_column = m_bsr_matrix.nbCol();
-    auto matrix_nb_nz = m_bsr_matrix.nbNz();
+    {
+      auto command = makeCommand(m_queue);
+      auto out_element_matrices = viewOut(command, m_element_matrices);
+
+      command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
+      {
+        auto element_matrix = compute_element_matrix(cell);
+        auto nb_element_column = NB_DOF * cell_node_cv.nbNode(cell);
+        auto offset = cell.asInt32() * ELEMENT_MATRIX_SIZE;
+        for (Int32 i = 0; i < nb_element_column; ++i)
+          for (Int32 j = 0; j < nb_element_column; ++j)
+            out_element_matrices[offset + i * nb_element_column + j] = element_matrix(i, j);
+      };
+    }
+
+    auto max_nb_node_per_cell = m_max_nb_node_per_cell;
+    auto map_stride = max_nb_node_per_cell * max_nb_node_per_cell;
+    bool order_values_per_block = m_bsr_matrix.orderValuePerBlock();
+
+    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    // With symmetric storage, rows of ghost nodes hold blocks needed by own nodes
+    bool is_symmetric = m_is_symmetric;
 
     auto command = makeCommand(m_queue);
-    auto in_row_index = viewIn(command, m_bsr_matrix.rowIndex());
-    auto in_columns = viewIn(command, m_bsr_matrix.columns());
     auto inout_values = viewInOut(command, m_bsr_matrix.values());
     auto in_nz_per_row = viewIn(command, m_bsr_matrix.nbNzPerRow());
+    auto in_node_row = viewIn(command, m_node_row);
+    auto in_cell_value_index = viewIn(command, m_cell_value_index);
+    auto in_element_matrices = viewIn(command, m_element_matrices);
+    auto in_node_cell_offset = viewIn(command, m_node_cell_offset);
+    auto in_node_cell_local_index = viewIn(command, m_node_cell_local_index);
 
     command << RUNCOMMAND_ENUMERATE(Node, row_node, m_mesh->allNodes())
     {
-      auto cur_row_node_idx = 0;
+      if (!is_symmetric && !nodes_infos.isOwn(row_node))
+        return;
+      auto row_stride = (order_values_per_block) ? NB_DOF : NB_DOF * in_nz_per_row[in_node_row[row_node]];
+      auto local_index_offset = in_node_cell_offset[row_node];
       for (auto cell : node_cell_cv.cells(row_node)) {
-
-        // Find the index of the node in the current cell
-        for (Int32 i = 1; i <= 3; ++i) {
-          if (row_node == cell_node_cv.nodeId(cell, i)) {
-            cur_row_node_idx = i;
-            break;
-          }
-          cur_row_node_idx = 0;
-        }
-
-        auto element_matrix = compute_element_matrix(cell);
-
-        auto cur_col_node_idx = 0;
-        for (NodeLocalId col_node_lid : cell_node_cv.nodes(cell)) {
-          if (nodes_infos.isOwn(row_node)) {
-
-            auto g_block_start = in_row_index[row_node] * NB_DOF_SQ;
-            auto begin = in_row_index[row_node];
-            auto end = (row_node == matrix_nb_row - 1) ? matrix_nb_column : in_row_index[row_node + 1];
-
-            auto x = 0;
-            while (begin < end) {
-              if (in_columns[begin] == col_node_lid) {
-                for (auto i = 0; i < NB_DOF; ++i) {
-                  for (auto j = 0; j < NB_DOF; ++j) {
-                    double value = element_matrix(NB_DOF * cur_row_node_idx + i, NB_DOF * cur_col_node_idx + j);
-                    auto l_block_start = g_block_start + (NB_DOF * x);
-                    if (i != 0)
-                      l_block_start += (NB_DOF * in_nz_per_row[row_node]);
-                    inout_values[l_block_start + j] += value;
-                  }
-                }
-              }
-              ++begin;
-              ++x;
+        auto nb_node = cell_node_cv.nbNode(cell);
+        auto cur_row_node_idx = in_node_cell_local_index[local_index_offset];
+        ++local_index_offset;
+
+        auto nb_element_column = NB_DOF * nb_node;
+        auto matrix_offset = cell.asInt32() * ELEMENT_MATRIX_SIZE;
+        auto map_offset = cell.asInt32() * map_stride + cur_row_node_idx * max_nb_node_per_cell;
+        for (Int32 cur_col_node_idx = 0; cur_col_node_idx < nb_node; ++cur_col_node_idx) {
+          auto block_start = in_cell_value_index[map_offset + cur_col_node_idx];
+          if (block_start < 0)
+            continue;
+          for (auto i = 0; i < NB_DOF; ++i) {
+            for (auto j = 0; j < NB_DOF; ++j) {
+              auto element_index = (NB_DOF * cur_row_node_idx + i) * nb_element_column + NB_DOF * cur_col_node_idx + j;
+              inout_values[block_start + i * row_stride + j] += in_element_matrices[matrix_offset + element_index];
             }
-            ++cur_col_node_idx;
           }
         }
-      };
+      }
     };
+
+    info() << "[ArcaneFem-Timer] Time to assemble (atomic-free implementation with element matrix cache) BSR matrix = " << (platform::getRealTime() - startTime);
   }
 
   /*---------------------------------------------------------------------------*/
   /**
-   * @brief Assembles the global BSR matrix for a bilinear operator, node-wise.
-   *
-   * This function constructs the Block Sparse Row (BSR) matrix by iterating over mesh nodes
-   * and accumulating contributions from element-level matrices. It uses a user-defined
-   * callback to compute the local matrix for each cell and updates the global matrix.
-   *
-   * ### Parameters:
-   * - `compute_element_matrix`: A callback function that computes the local matrix
-   *   for a given cell. It must return a matrix compatible with the expected block size.
-   *
-   * ### Key Details:
-   * - Uses cell-to-node, node-to-cell connectivity from the mesh and DoF mappings for assembly.
-   * - Handles block structure updates for `blockSize x blockSize` dimensions.
+   * @brief Assembles the global BSR matrix cell-wise, one color at a time.
    *
+   * The cells of one color do not share any node (see `computeCellColoring()`)
+   * so they can be assembled in parallel without atomic operations. Each
+   * element matrix is computed once and the result is deterministic.
    */
   /*---------------------------------------------------------------------------*/
 
-  template <class Function> void assembleBilinearAtomicFree(Function compute_element_matrix)
+  template <class Function> void assembleBilinearColored(Function compute_element_matrix)
   {
-    info() << "BSRFormat(assembleBilinearAtomicFree): Integrating over nodes...";
+    info() << "BSRFormat(assembleBilinearColored): Integrating over elements per color...";
     auto startTime = platform::getRealTime();
 
-    if (m_bsr_matrix.orderValuePerBlock())
-      assembleBilinearOrderedPerBlockAtomicFree(compute_element_matrix);
-    else
-      assembleBilinearOrderedPerRowAtomicFree(compute_element_matrix);
+    UnstructuredMeshConnectivityView m_connectivity_view(m_mesh);
+    auto cell_node_cv = m_connectivity_view.cellNode();
 
-    info() << "[ArcaneFem-Timer] Time to assemble (atomic-free implementation) BSR matrix = " << (platform::getRealTime() - startTime);
+    auto max_nb_node_per_cell = m_max_nb_node_per_cell;
+    auto map_stride = max_nb_node_per_cell * max_nb_node_per_cell;
+    bool order_values_per_block = m_bsr_matrix.orderValuePerBlock();
+
+    for (Int32 color = 0, nb_color = m_color_offsets.size() - 1; color < nb_color; ++color) {
+      auto color_begin = m_color_offsets[color];
+      auto nb_cell_in_color = m_color_offsets[color + 1] - color_begin;
+
+      auto command = makeCommand(m_queue);
+      auto inout_values = viewInOut(command, m_bsr_matrix.values());
+      auto in_nz_per_row = viewIn(command, m_bsr_matrix.nbNzPerRow());
+      auto in_node_row = viewIn(command, m_node_row);
+      auto in_cell_value_index = viewIn(command, m_cell_value_index);
+      auto in_colored_cells = viewIn(command, m_colored_cells);
+
+      command << RUNCOMMAND_LOOP1(iter, nb_cell_in_color)
+      {
+        auto [i] = iter();
+        CellLocalId cell(in_colored_cells[color_begin + i]);
+        auto element_matrix = compute_element_matrix(cell);
+        auto cell_offset = cell.asInt32() * map_stride;
+        auto nb_node = cell_node_cv.nbNode(cell);
+
+        for (Int32 cur_row_node_idx = 0; cur_row_node_idx < nb_node; ++cur_row_node_idx) {
+          auto row_node_lid = cell_node_cv.nodeId(cell, cur_row_node_idx);
+          auto row_stride = (order_values_per_block) ? NB_DOF : NB_DOF * in_nz_per_row[in_node_row[row_node_lid]];
+          for (Int32 cur_col_node_idx = 0; cur_col_node_idx < nb_node; ++cur_col_node_idx) {
+            auto block_start = in_cell_value_index[cell_offset + cur_row_node_idx * max_nb_node_per_cell + cur_col_node_idx];
+            if (block_start < 0)
+              continue;
+            for (auto bi = 0; bi < NB_DOF; ++bi) {
+              for (auto bj = 0; bj < NB_DOF; ++bj) {
+                double value = element_matrix(NB_DOF * cur_row_node_idx + bi, NB_DOF * cur_col_node_idx + bj);
+                inout_values[block_start + bi * row_stride + bj] += value;
+              }
+            }
+          }
+        }
+      };
+    }
+
+    info() << "[ArcaneFem-Timer] Time to assemble (colored implementation) BSR matrix = " << (platform::getRealTime() - startTime);
   }
 
   /*---------------------------------------------------------------------------*/
@@ -1104,19 +2361,41 @@ class BSRFormat : public TraceAccessor
 
   template <class Function> void assembleBilinear(Function compute_element_matrix)
   {
-    if (m_use_atomic_free)
-      assembleBilinearAtomicFree(compute_element_matrix);
-    else
+    switch (m_assembly_strategy) {
+    case eBSRAssemblyStrategy::Atomic:
       assembleBilinearAtomic(compute_element_matrix);
+      break;
+    case eBSRAssemblyStrategy::AtomicFree:
+      assembleBilinearAtomicFree(compute_element_matrix);
+      break;
+    case eBSRAssemblyStrategy::AtomicFreeCached:
+      assembleBilinearAtomicFreeCached(compute_element_matrix);
+      break;
+    case eBSRAssemblyStrategy::Colored:
+      assembleBilinearColored(compute_element_matrix);
+      break;
+    }
   }
 
   /*---------------------------------------------------------------------------*/
   /*---------------------------------------------------------------------------*/
 
-  BSRMatrix<NB_DOF>& matrix()
+  BSRMatrix<NB_DOF, IndexType>& matrix()
   {
     return m_bsr_matrix;
   };
+  /*!
+   * \brief Global index of each block column (see computeColumnGlobalIndex()).
+   *
+   * The map is computed at the first call after `computeSparsity()`. In
+   * this case the call is collective.
+   */
+  NumArray<Int64, MDDim1>& columnGlobalIndex()
+  {
+    if (!m_is_column_global_index_valid)
+      computeColumnGlobalIndex();
+    return m_column_global_index;
+  };
   void resetMatrixValues()
   {
     m_bsr_matrix.values().fill(0, m_queue);
@@ -1129,10 +2408,37 @@ class BSRFormat : public TraceAccessor
  private:
 
   bool m_use_csr_in_linear_system = false;
-  bool m_use_atomic_free = false;
-
-  BSRMatrix<NB_DOF> m_bsr_matrix;
-  CsrFormat m_csr_matrix;
+  eBSRAssemblyStrategy m_assembly_strategy = eBSRAssemblyStrategy::Atomic;
+  //! True if only the upper triangle of the matrix is stored
+  bool m_is_symmetric = false;
+  //! True if the sparsity is computed from the cell-node connectivity (see isCellSparsityNeeded())
+  bool m_use_cell_sparsity = false;
+  bool m_order_values_per_block = false;
+  //! Version of the sparsity given to the linear system (see newCSRStructureVersion())
+  Int64 m_structure_version = -1;
+
+  BSRMatrix<NB_DOF, IndexType> m_bsr_matrix;
+  //! Operator given to the linear system for a symmetric matrix (see toLinearSystem())
+  BSRLinearOperator<NB_DOF, IndexType> m_bsr_linear_operator;
+  BSRCsrArrays<IndexType> m_csr_matrix;
+
+  //! Index in the BSR values of the blocks of each cell (see computeScatterMap())
+  NumArray<IndexType, MDDim1> m_cell_value_index;
+  Int32 m_max_nb_node_per_cell = 0;
+  //! Element matrices of each cell (see assembleBilinearAtomicFreeCached())
+  NumArray<Real, MDDim1> m_element_matrices;
+  //! Cells grouped per color and index of the first cell of each color (see computeCellColoring())
+  NumArray<Int32, MDDim1> m_colored_cells;
+  UniqueArray<Int32> m_color_offsets;
+  //! Local index of the nodes in their cells (see computeNodeCellLocalIndex())
+  NumArray<Int32, MDDim1> m_node_cell_offset;
+  NumArray<Int32, MDDim1> m_node_cell_local_index;
+  //! Block row of each node and 1 if the row is the one of an own node (see computeNodeRow())
+  NumArray<Int32, MDDim1> m_node_row;
+  NumArray<Byte, MDDim1> m_is_own_row;
+  //! Global index of each block column (see computeColumnGlobalIndex())
+  NumArray<Int64, MDDim1> m_column_global_index;
+  bool m_is_column_global_index_valid = false;
 
   IMesh* m_mesh;
   RunQueue& m_queue;
@@ -48,6 +48,7 @@ initialize(IItemFamily* dof_family, Int32 nnz, Int32 nbRow, RunQueue& queue)
   m_dof_family = dof_family;
   m_last_value = 0;
   m_nnz = nnz;
+  m_structure_version = newCSRStructureVersion();
   info() << "Filling CSR Matrix with zeros";
 }
 
@@ -87,6 +88,7 @@ translateToLinearSystem(DoFLinearSystem& linear_system, const RunQueue& queue)
 
   if (do_set_csr) {
     CSRFormatView csr_view(m_matrix_row.to1DSpan(), m_matrix_rows_nb_column.to1DSpan(), m_matrix_column.to1DSpan(), m_matrix_value.to1DSpan());
+    csr_view.setStructureVersion(m_structure_version);
     linear_system.setCSRValues(csr_view);
   }
 }
@@ -130,6 +130,8 @@ class CsrFormat
   //! Nombre de colonnes de chaque lignes.
   NumArray<Int32, MDDim1> m_matrix_rows_nb_column;
   IItemFamily* m_dof_family = nullptr;
+  //! Version of the structure set by initialize() (see newCSRStructureVersion())
+  Int64 m_structure_version = -1;
 
   //! Return the Value at the (row, column) coordinates.
   Int32 getValue(DoFLocalId row, DoFLocalId column)
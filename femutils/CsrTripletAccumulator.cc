@@ -0,0 +1,197 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CsrTripletAccumulator.cc                                    (C) 2022-2025 */
+/*                                                                           */
+/* Accumulation of (row,column,value) triplets in a sorted CSR matrix.       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "CsrTripletAccumulator.h"
+
+#include <arcane/utils/FatalErrorException.h>
+
+#include <algorithm>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+namespace
+{
+  using RowValue = std::pair<Int32, Real>;
+
+  /*!
+   * \brief Sort \a row_values by column and add them to \a columns and \a values.
+   *
+   * The values with the same column are summed.
+   */
+  void _addSortedRow(UniqueArray<RowValue>& row_values, UniqueArray<Int32>& columns, UniqueArray<Real>& values)
+  {
+    std::sort(row_values.begin(), row_values.end(),
+              [](const RowValue& a, const RowValue& b) {
+                return a.first < b.first;
+              });
+    Int32 last_column = -1;
+    for (const auto& x : row_values) {
+      if (x.first == last_column)
+        values.back() += x.second;
+      else {
+        columns.add(x.first);
+        values.add(x.second);
+        last_column = x.first;
+      }
+    }
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void CsrTripletAccumulator::
+reset(Int32 nb_row)
+{
+  m_nb_row = nb_row;
+  m_rows_index.resize(nb_row + 1);
+  m_rows_index.fill(0);
+  m_columns.clear();
+  m_values.clear();
+  m_pending_rows.clear();
+  m_pending_columns.clear();
+  m_pending_values.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+Int32 CsrTripletAccumulator::
+findIndex(Int32 row, Int32 column) const
+{
+  auto begin = m_columns.begin() + m_rows_index[row];
+  auto end = m_columns.begin() + m_rows_index[row + 1];
+  auto x = std::lower_bound(begin, end, column);
+  if (x == end || *x != column)
+    return -1;
+  return static_cast<Int32>(x - m_columns.begin());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Merge the pending values in the CSR matrix.
+ *
+ * The pending values are first bucketed by row (counting sort). Then for
+ * each row the existing values and the pending values are sorted by column
+ * and the values with the same column are summed.
+ */
+void CsrTripletAccumulator::
+merge()
+{
+  const Int32 nb_pending = m_pending_rows.size();
+  if (nb_pending == 0)
+    return;
+  const Int32 nb_row = m_nb_row;
+
+  // Bucket the pending values by row
+  UniqueArray<Int32> pending_index(nb_row + 1);
+  pending_index.fill(0);
+  for (Int32 i = 0; i < nb_pending; ++i)
+    ++pending_index[m_pending_rows[i] + 1];
+  for (Int32 r = 0; r < nb_row; ++r)
+    pending_index[r + 1] += pending_index[r];
+  UniqueArray<Int32> pending_position(pending_index.constView().subView(0, nb_row));
+  UniqueArray<Int32> bucket_columns(nb_pending);
+  UniqueArray<Real> bucket_values(nb_pending);
+  for (Int32 i = 0; i < nb_pending; ++i) {
+    Int32 pos = pending_position[m_pending_rows[i]]++;
+    bucket_columns[pos] = m_pending_columns[i];
+    bucket_values[pos] = m_pending_values[i];
+  }
+  m_pending_rows.clear();
+  m_pending_columns.clear();
+  m_pending_values.clear();
+
+  // Merge row by row. The size of the new matrix is at most
+  // the size of the old one plus the number of pending values.
+  UniqueArray<Int32> new_rows_index(nb_row + 1);
+  UniqueArray<Int32> new_columns;
+  UniqueArray<Real> new_values;
+  new_columns.reserve(m_columns.size() + nb_pending);
+  new_values.reserve(m_columns.size() + nb_pending);
+  UniqueArray<RowValue> row_values;
+  new_rows_index[0] = 0;
+  for (Int32 r = 0; r < nb_row; ++r) {
+    row_values.clear();
+    for (Int32 i = m_rows_index[r], n = m_rows_index[r + 1]; i < n; ++i)
+      row_values.add(std::make_pair(m_columns[i], m_values[i]));
+    for (Int32 i = pending_index[r], n = pending_index[r + 1]; i < n; ++i)
+      row_values.add(std::make_pair(bucket_columns[i], bucket_values[i]));
+    _addSortedRow(row_values, new_columns, new_values);
+    new_rows_index[r + 1] = new_columns.size();
+  }
+  m_rows_index.swap(new_rows_index);
+  m_columns.swap(new_columns);
+  m_values.swap(new_values);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Add the values of \a csr_view.
+ *
+ * Columns with a null local id are padding and are skipped. The columns of
+ * a row may not be sorted and may appear several times. If the matrix has
+ * no other value, the CSR matrix is directly built from the view without
+ * going through the pending values.
+ */
+void CsrTripletAccumulator::
+addCSRView(CSRFormatView& csr_view)
+{
+  Span<const Int32> rows = csr_view.rows();
+  Span<const Int32> rows_nb_column = csr_view.rowsNbColumn();
+  Span<const Int32> columns = csr_view.columns();
+  Span<Real> values = csr_view.values();
+  const Int32 nb_row = csr_view.nbRow();
+  if (nb_row > m_nb_row)
+    ARCANE_FATAL("Bad number of rows in CSR view (nb_row={0} max={1})", nb_row, m_nb_row);
+
+  if (!m_columns.empty() || !m_pending_rows.empty()) {
+    for (Int32 r = 0; r < nb_row; ++r) {
+      for (Int32 i = rows[r], n = rows[r] + rows_nb_column[r]; i < n; ++i) {
+        if (columns[i] >= 0)
+          add(r, columns[i], values[i]);
+      }
+    }
+    return;
+  }
+
+  m_columns.reserve(csr_view.nbColumn());
+  m_values.reserve(csr_view.nbColumn());
+  UniqueArray<RowValue> row_values;
+  m_rows_index[0] = 0;
+  for (Int32 r = 0; r < m_nb_row; ++r) {
+    if (r < nb_row) {
+      row_values.clear();
+      for (Int32 i = rows[r], n = rows[r] + rows_nb_column[r]; i < n; ++i) {
+        if (columns[i] >= 0)
+          row_values.add(std::make_pair(columns[i], values[i]));
+      }
+      _addSortedRow(row_values, m_columns, m_values);
+    }
+    m_rows_index[r + 1] = m_columns.size();
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,100 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* CsrTripletAccumulator.h                                     (C) 2022-2025 */
+/*                                                                           */
+/* Accumulation of (row,column,value) triplets in a sorted CSR matrix.       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+#ifndef FEMUTILS_CSRTRIPLETACCUMULATOR_H
+#define FEMUTILS_CSRTRIPLETACCUMULATOR_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <arcane/utils/UniqueArray.h>
+#include <arcane/utils/ArrayView.h>
+#include <arcane/utils/Span.h>
+
+#include "DoFLinearSystem.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief CSR matrix built from (row,column,value) triplets.
+ *
+ * Values given by add() are first stored as triplets. These triplets are
+ * periodically sorted and merged into a CSR matrix whose columns are sorted
+ * for each row, and the values with the same (row,column) are summed. The
+ * memory used is proportional to the number of non-zero values and not to
+ * the square of the number of rows.
+ *
+ * The CSR matrix (rowsIndex(), columns() and values()) is only up to date
+ * after a call to merge().
+ */
+class CsrTripletAccumulator
+{
+ public:
+
+  //! Minimum number of pending values before merging them in the CSR matrix
+  static constexpr Int32 MIN_NB_PENDING_VALUE = 1 << 20;
+
+ public:
+
+  //! Remove all the values and set the number of rows to \a nb_row
+  void reset(Int32 nb_row);
+
+  //! Add \a value to (row,column)
+  void add(Int32 row, Int32 column, Real value)
+  {
+    m_pending_rows.add(row);
+    m_pending_columns.add(column);
+    m_pending_values.add(value);
+    if (m_pending_rows.size() >= math::max(MIN_NB_PENDING_VALUE, m_columns.size()))
+      merge();
+  }
+
+  void addCSRView(CSRFormatView& csr_view);
+  void merge();
+
+  //! Index of (row,column) in the CSR matrix or -1 if not found.
+  Int32 findIndex(Int32 row, Int32 column) const;
+
+  Int32 nbRow() const { return m_nb_row; }
+  //! Index of the first value of each row (size nbRow()+1)
+  Span<const Int32> rowsIndex() const { return m_rows_index.constSpan(); }
+  Span<const Int32> columns() const { return m_columns.constSpan(); }
+  Span<Real> values() { return m_values.span(); }
+  Span<const Real> values() const { return m_values.constSpan(); }
+
+ private:
+
+  Int32 m_nb_row = 0;
+  UniqueArray<Int32> m_rows_index;
+  UniqueArray<Int32> m_columns;
+  UniqueArray<Real> m_values;
+
+  //! Values given by add() not yet merged in the CSR matrix
+  UniqueArray<Int32> m_pending_rows;
+  UniqueArray<Int32> m_pending_columns;
+  UniqueArray<Real> m_pending_values;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
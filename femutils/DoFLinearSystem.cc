@@ -14,17 +14,29 @@
 #include "DoFLinearSystem.h"
 
 #include <arcane/utils/FatalErrorException.h>
+#include <arcane/utils/NotImplementedException.h>
 #include <arcane/utils/TraceAccessor.h>
 #include <arcane/utils/NumArray.h>
 #include <arcane/utils/ITraceMng.h>
+#include <arcane/utils/PlatformUtils.h>
 
 #include <arcane/VariableTypes.h>
 #include <arcane/IItemFamily.h>
 #include <arcane/ISubDomain.h>
 #include <arcane/IParallelMng.h>
+#include <arcane/IDirectory.h>
+#include <arcane/Directory.h>
+#include <arcane/CommonVariables.h>
 
 #include "FemUtils.h"
+#include "CsrTripletAccumulator.h"
 #include "IDoFLinearSystemFactory.h"
+#include "SparseDirectSolver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <fstream>
+#include <memory>
 
 namespace Arcane::FemUtils
 {
@@ -32,7 +44,9 @@ enum class eInternalSolverMethod
 {
   Auto,
   Direct,
-  PCG
+  PCG,
+  //! Sparse LU/LDLt factorization (see SparseDirectSolver)
+  SparseDirect
 };
 }
 
@@ -40,6 +54,7 @@ enum class eInternalSolverMethod
 /*---------------------------------------------------------------------------*/
 
 #include "SequentialBasicDoFLinearSystemFactory_axl.h"
+#include "SparseDirectDoFLinearSystemFactory_axl.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -53,6 +68,24 @@ createAlephDoFLinearSystemImpl(ISubDomain* sd, IItemFamily* dof_family, const St
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+Int64
+newCSRStructureVersion()
+{
+  static std::atomic<Int64> last_version = 0;
+  return ++last_version;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Sequential linear system using a sparse CSR matrix.
+ *
+ * Values given by matrixAddValue() are accumulated in a CSR matrix whose
+ * columns are sorted for each row (see CsrTripletAccumulator).
+ *
+ * Values given by matrixSetValue(), row eliminations, forced values and
+ * values given by setCSRValues() are only applied when solve() is called.
+ */
 class SequentialDoFLinearSystemImpl
 : public TraceAccessor
 , public DoFLinearSystemImpl
@@ -65,52 +98,100 @@ class SequentialDoFLinearSystemImpl
   , m_dof_family(dof_family)
   , m_rhs_variable(VariableBuildInfo(dof_family, solver_name + "RHSVariable"))
   , m_dof_variable(VariableBuildInfo(dof_family, solver_name + "SolutionVariable"))
+  , m_dof_forced_info(VariableBuildInfo(dof_family, solver_name + "DoFForcedInfo"))
+  , m_dof_forced_value(VariableBuildInfo(dof_family, solver_name + "DoFForcedValue"))
+  , m_dof_elimination_info(VariableBuildInfo(dof_family, solver_name + "DoFEliminationInfo"))
+  , m_dof_elimination_value(VariableBuildInfo(dof_family, solver_name + "DoFEliminationValue"))
   {}
 
  public:
 
   void build()
   {
-    Int32 nb_node = m_dof_family->allItems().size();
-    m_k_matrix.resize(nb_node, nb_node);
-    m_k_matrix.fill(0.0);
-    m_rhs_vector.resize(nb_node);
+    Int32 nb_row = m_dof_family->maxLocalId();
+    m_nb_row = nb_row;
+    m_matrix.reset(nb_row);
+    m_set_rows.clear();
+    m_set_columns.clear();
+    m_set_values.clear();
+    m_csr_view = {};
+    m_has_csr_view = false;
+    m_rhs_vector.resize(nb_row);
     m_rhs_vector.fill(0.0);
+    m_dof_forced_info.fill(false);
+    m_dof_forced_value.fill(0.0);
+    m_dof_elimination_info.fill(ELIMINATE_NONE);
+    m_dof_elimination_value.fill(0.0);
   }
 
  private:
 
   void matrixAddValue(DoFLocalId row, DoFLocalId column, Real value) override
   {
-    m_k_matrix(row, column) += value;
+    if (row.isNull())
+      ARCANE_FATAL("Row is null");
+    if (column.isNull())
+      ARCANE_FATAL("Column is null");
+    m_matrix.add(row, column, value);
   }
 
   void matrixSetValue(DoFLocalId row, DoFLocalId column, Real value) override
   {
-    // TODO: We should do the set() at the solving time because a following
-    // call to matrixAddValue() will override this value and this is not the
-    // wanted bahavior.
-    m_k_matrix(row, column) = value;
+    if (row.isNull())
+      ARCANE_FATAL("Row is null");
+    if (column.isNull())
+      ARCANE_FATAL("Column is null");
+    // The value is set during solve() so that any call to matrixAddValue()
+    // for the same (row,column) is discarded. The zero value ensures that
+    // the entry exists in the sparsity of the matrix.
+    m_matrix.add(row, column, 0.0);
+    m_set_rows.add(row);
+    m_set_columns.add(column);
+    m_set_values.add(value);
   }
 
   void eliminateRow(DoFLocalId row, Real value) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    if (row.isNull())
+      ARCANE_FATAL("Row is null");
+    m_dof_elimination_info[row] = ELIMINATE_ROW;
+    m_dof_elimination_value[row] = value;
   }
 
   void eliminateRowColumn(DoFLocalId row, Real value) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    if (row.isNull())
+      ARCANE_FATAL("Row is null");
+    m_dof_elimination_info[row] = ELIMINATE_ROW_COLUMN;
+    m_dof_elimination_value[row] = value;
   }
 
   void solve() override
   {
+    m_solve_report = {};
+    m_solve_report.linear_system_name = "Sequential";
+    Real build_begin = platform::getRealTime();
+
+    // _fillMatrix() may change the values of RHS vector
+    // with row-column elimination so we has to do it before
+    // filling the RHS vector.
+    _fillMatrix();
     _fillRHSVector();
 
-    Int32 matrix_size = m_k_matrix.extent0();
+    if (m_solver_method == eInternalSolverMethod::SparseDirect) {
+      m_solve_report.matrix_build_time = platform::getRealTime() - build_begin;
+      _solveSparseDirect();
+      return;
+    }
+
+    Int32 matrix_size = m_nb_row;
     Arcane::MatVec::Matrix matrix(matrix_size, matrix_size);
-    _convertNumArrayToCSRMatrix(matrix, m_k_matrix.span());
-    bool is_verbose = true;
+    _fillMatVecMatrix(matrix);
+    m_solve_report.matrix_build_time = platform::getRealTime() - build_begin;
+    // Matrix (values, columns and rows) and vectors copied to MatVec
+    m_solve_report.nb_transferred_byte = m_matrix.values().size() * (sizeof(Real) + sizeof(Int32)) + (matrix_size + 1) * sizeof(Int32) + 3 * matrix_size * sizeof(Real);
+    // Do not print values if the matrix is too big
+    bool is_verbose = matrix_size < 200;
     Arcane::MatVec::Vector vector_b(matrix_size);
     Arcane::MatVec::Vector vector_x(matrix_size);
     {
@@ -132,10 +213,13 @@ class SequentialDoFLinearSystemImpl
     case eInternalSolverMethod::Direct:
       use_direct_solver = true;
       break;
+    case eInternalSolverMethod::SparseDirect:
+      ARCANE_FATAL("SparseDirect is solved by _solveSparseDirect()");
     case eInternalSolverMethod::PCG:
       use_direct_solver = false;
       break;
     }
+    Real solve_begin = platform::getRealTime();
     if (use_direct_solver) {
       info() << "Using direct solver";
       Arcane::MatVec::DirectSolver solver;
@@ -149,7 +233,10 @@ class SequentialDoFLinearSystemImpl
       solver.solve(matrix, vector_b, vector_x, epsilon, &p);
       info() << "End solver nb_iteration=" << solver.nbIteration()
              << " residual_norm=" << solver.residualNorm();
+      m_solve_report.nb_iteration = solver.nbIteration();
+      m_solve_report.residual = solver.residualNorm();
     }
+    m_solve_report.solve_time = platform::getRealTime() - solve_begin;
 
     {
       auto vector_x_view = vector_x.values();
@@ -173,96 +260,255 @@ class SequentialDoFLinearSystemImpl
     return m_rhs_variable;
   }
 
-  CSRFormatView& getCSRValues() override
-  {
-    ARCANE_THROW(NotImplementedException, "");
-  }
+  CSRFormatView& getCSRValues() override { return m_csr_view; }
+  VariableDoFReal& getForcedValue() override { return m_dof_forced_value; }
+  VariableDoFBool& getForcedInfo() override { return m_dof_forced_info; }
+  VariableDoFByte& getEliminationInfo() override { return m_dof_elimination_info; }
+  VariableDoFReal& getEliminationValue() override { return m_dof_elimination_value; }
 
-  VariableDoFReal& getForcedValue() override
-  {
-    ARCANE_THROW(NotImplementedException, "");
-  }
+  void setSolverCommandLineArguments(const CommandLineArguments&) override {}
 
-  VariableDoFBool& getForcedInfo() override
+  void clearValues() override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    info() << "[SequentialLinearSystem] Clear values of current solver";
+    build();
   }
 
-  VariableDoFByte& getEliminationInfo() override
+  void setCSRValues(const CSRFormatView& csr_view) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    // The values are read during solve()
+    m_csr_view = csr_view;
+    m_has_csr_view = true;
   }
 
-  VariableDoFReal& getEliminationValue() override
+  bool hasSetCSRValues() const override { return true; }
+  void setCSRValues64(const CSRFormatView64&) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    ARCANE_THROW(NotImplementedException, "CSR matrix with 64-bit row offsets");
   }
-
-  void setSolverCommandLineArguments(const CommandLineArguments&) override {}
-
-  void clearValues() override
+  bool hasSetCSRValues64() const override { return false; }
+  void setRunner(Runner* r) override { m_runner = r; }
+  Runner* runner() const override { return m_runner; }
+  //! The direct solvers used here do not need the block size
+  void setBlockSize(Int32) override {}
+  void setLinearOperator(IDoFLinearOperator*) override
   {
-    // TODO: not yet tested. We need to have test for this.
-    build();
+    ARCANE_THROW(NotImplementedException, "Matrix-free linear operator");
   }
-
-  void setCSRValues(const CSRFormatView& csr_view) override
+  bool hasSetLinearOperator() const override { return false; }
+  void solveMultipleRhs(VariableDoFArrayReal&, VariableDoFArrayReal&) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    ARCANE_THROW(NotImplementedException, "Solve with multiple right hand sides");
   }
-
-  bool hasSetCSRValues() const override { return false; }
-  void setRunner(Runner* r) override { m_runner = r; }
-  Runner* runner() const { return m_runner; }
+  bool hasSolveMultipleRhs() const override { return false; }
+  const SolveReport& solveReport() const override { return m_solve_report; }
 
  public:
 
   void setEpsilon(Real v) { m_epsilon = v; }
   void setSolverMethod(eInternalSolverMethod v) { m_solver_method = v; }
+  /*!
+   * \brief Set the sparse direct solver used with eInternalSolverMethod::SparseDirect.
+   *
+   * The solver may be shared with the next instances so that they can reuse
+   * its factorization. If null, the instance uses its own solver.
+   */
+  void setSparseDirectSolver(SparseDirectSolver* v) { m_sparse_direct_solver = v; }
 
  private:
 
   ISubDomain* m_sub_domain = nullptr;
   IItemFamily* m_dof_family = nullptr;
+  SolveReport m_solve_report;
   VariableDoFReal m_rhs_variable;
   VariableDoFReal m_dof_variable;
+  VariableDoFBool m_dof_forced_info;
+  VariableDoFReal m_dof_forced_value;
+  VariableDoFByte m_dof_elimination_info;
+  VariableDoFReal m_dof_elimination_value;
+
+  Int32 m_nb_row = 0;
+  //! CSR matrix of the values given by matrixAddValue() and setCSRValues()
+  CsrTripletAccumulator m_matrix;
+
+  //! Values given by matrixSetValue() in the order of the calls
+  UniqueArray<Int32> m_set_rows;
+  UniqueArray<Int32> m_set_columns;
+  UniqueArray<Real> m_set_values;
+
+  CSRFormatView m_csr_view;
+  bool m_has_csr_view = false;
 
-  NumArray<Real, MDDim2> m_k_matrix;
   //! RHS (Right Hand Side) vector
   NumArray<Real, MDDim1> m_rhs_vector;
 
   Real m_epsilon = 1.0e-15;
   eInternalSolverMethod m_solver_method = eInternalSolverMethod::Auto;
+  SparseDirectSolver* m_sparse_direct_solver = nullptr;
+  std::unique_ptr<SparseDirectSolver> m_own_sparse_direct_solver;
 
   Runner* m_runner = nullptr;
 
  private:
 
-  void _fillRHSVector()
-  {
-    // For the LinearSystem class we need an array
-    // with only the values for the ownNodes().
-    // The values of 'rhs_values' should not be updated after
-    // this call.
-    UniqueArray<Real> rhs_values_for_linear_system;
-    VariableDoFReal& rhs_values(rhsVariable());
-    ENUMERATE_ (DoF, idof, m_dof_family->allItems().own()) {
-      rhs_values_for_linear_system.add(rhs_values[idof]);
+  void _fillMatrix();
+  void _fillMatVecMatrix(Arcane::MatVec::Matrix& matrix);
+  void _fillRHSVector();
+  void _solveSparseDirect();
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Apply set values, forced values and eliminations to the matrix.
+ */
+void SequentialDoFLinearSystemImpl::
+_fillMatrix()
+{
+  // Values given by setCSRValues()
+  if (m_has_csr_view) {
+    m_matrix.addCSRView(m_csr_view);
+    m_has_csr_view = false;
+  }
+  DoFGroup all_dofs = m_dof_family->allItems();
+
+  // Forced values change the diagonal. Ensure the diagonal exists
+  // for forced or eliminated rows.
+  ENUMERATE_ (DoF, idof, all_dofs) {
+    DoFLocalId dof_id = *idof;
+    if (m_dof_forced_info[dof_id] || m_dof_elimination_info[dof_id] != ELIMINATE_NONE)
+      m_matrix.add(dof_id, dof_id, 0.0);
+  }
+  m_matrix.merge();
+
+  Span<const Int32> rows_index = m_matrix.rowsIndex();
+  Span<const Int32> columns = m_matrix.columns();
+  Span<Real> values = m_matrix.values();
+
+  // Apply values given by matrixSetValue(). The last call wins.
+  for (Int32 i = 0, n = m_set_rows.size(); i < n; ++i)
+    values[m_matrix.findIndex(m_set_rows[i], m_set_columns[i])] = m_set_values[i];
+
+  ENUMERATE_ (DoF, idof, all_dofs) {
+    DoFLocalId dof_id = *idof;
+    if (m_dof_forced_info[dof_id])
+      values[m_matrix.findIndex(dof_id, dof_id)] = m_dof_forced_value[dof_id];
+  }
+
+  // Row+Column elimination: substract the eliminated columns from the RHS
+  // and remove them from the matrix.
+  for (Int32 r = 0; r < m_nb_row; ++r) {
+    bool is_row_eliminated = m_dof_elimination_info[DoFLocalId(r)] != ELIMINATE_NONE;
+    for (Int32 i = rows_index[r], n = rows_index[r + 1]; i < n; ++i) {
+      Int32 column_lid = columns[i];
+      DoFLocalId column(column_lid);
+      if (column_lid == r || m_dof_elimination_info[column] != ELIMINATE_ROW_COLUMN)
+        continue;
+      if (!is_row_eliminated)
+        m_rhs_variable[DoFLocalId(r)] -= values[i] * m_dof_elimination_value[column];
+      values[i] = 0.0;
     }
-    _setRHSValues(rhs_values_for_linear_system);
   }
 
-  void _setRHSValues(Span<const Real> values)
-  {
-    Int32 index = 0;
-    DoFGroup own_dofs = m_dof_family->allItems().own();
-    ENUMERATE_ (DoF, idof, own_dofs) {
-      DoFLocalId dof_id = *idof;
-      m_rhs_vector[dof_id] = values[index];
-      ++index;
+  // Row elimination: the row becomes the identity row and the RHS is set
+  // to the elimination value.
+  ENUMERATE_ (DoF, idof, all_dofs) {
+    DoFLocalId dof_id = *idof;
+    if (m_dof_elimination_info[dof_id] == ELIMINATE_NONE)
+      continue;
+    for (Int32 i = rows_index[dof_id], n = rows_index[dof_id + 1]; i < n; ++i)
+      values[i] = (columns[i] == dof_id) ? 1.0 : 0.0;
+    m_rhs_variable[dof_id] = m_dof_elimination_value[dof_id];
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Fill \a matrix with the non-zero values of the CSR matrix.
+ */
+void SequentialDoFLinearSystemImpl::
+_fillMatVecMatrix(Arcane::MatVec::Matrix& matrix)
+{
+  const Int32 nb_row = m_nb_row;
+  Span<const Int32> csr_rows_index = m_matrix.rowsIndex();
+  Span<const Int32> csr_columns = m_matrix.columns();
+  Span<const Real> csr_values = m_matrix.values();
+  UniqueArray<Integer> rows_size(nb_row);
+  for (Int32 r = 0; r < nb_row; ++r) {
+    Integer nb_value = 0;
+    for (Int32 i = csr_rows_index[r], n = csr_rows_index[r + 1]; i < n; ++i)
+      if (csr_values[i] != 0.0)
+        ++nb_value;
+    rows_size[r] = nb_value;
+  }
+  matrix.setRowsSize(rows_size);
+
+  UniqueArray<Integer> columns;
+  UniqueArray<Real> values;
+  columns.reserve(csr_columns.size());
+  values.reserve(csr_columns.size());
+  for (Int32 i = 0, n = csr_columns.size(); i < n; ++i) {
+    if (csr_values[i] != 0.0) {
+      columns.add(csr_columns[i]);
+      values.add(csr_values[i]);
     }
   }
-};
+  matrix.setValues(columns, values);
+  info() << "[SequentialLinearSystem] nb_row=" << nb_row << " nb_non_zero=" << values.size();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void SequentialDoFLinearSystemImpl::
+_fillRHSVector()
+{
+  m_rhs_vector.fill(0.0);
+  VariableDoFReal& rhs_values(rhsVariable());
+  ENUMERATE_ (DoF, idof, m_dof_family->allItems().own()) {
+    DoFLocalId dof_id = *idof;
+    m_rhs_vector[dof_id] = rhs_values[idof];
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Solve with the sparse direct solver.
+ *
+ * The CSR matrix is directly given to the solver. If it has not changed
+ * since the previous solve, only the forward and backward substitutions
+ * are done.
+ */
+void SequentialDoFLinearSystemImpl::
+_solveSparseDirect()
+{
+  m_solve_report.linear_system_name = "SparseDirect";
+  SparseDirectSolver* solver = m_sparse_direct_solver;
+  if (!solver) {
+    if (!m_own_sparse_direct_solver)
+      m_own_sparse_direct_solver = std::make_unique<SparseDirectSolver>(traceMng());
+    solver = m_own_sparse_direct_solver.get();
+  }
+
+  Real setup_begin = platform::getRealTime();
+  bool is_factorized = solver->factorize(m_nb_row, m_matrix.rowsIndex(), m_matrix.columns(), m_matrix.values());
+  m_solve_report.setup_time = platform::getRealTime() - setup_begin;
+  // Values compared to (or copied in) the solver, RHS and solution
+  m_solve_report.nb_transferred_byte = m_matrix.values().size() * sizeof(Real) + 2 * m_nb_row * sizeof(Real);
+  info() << "[SparseDirect-Info] factorized=" << is_factorized << " setup_time=" << m_solve_report.setup_time;
+
+  Real solve_begin = platform::getRealTime();
+  UniqueArray<Real> solution(m_nb_row);
+  solver->solve(m_rhs_vector.to1DSpan(), solution.span());
+  m_solve_report.solve_time = platform::getRealTime() - solve_begin;
+
+  ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
+    DoF dof = *idof;
+    m_dof_variable[dof] = solution[dof.localId()];
+  }
+}
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -285,7 +531,7 @@ class DefaultDoFLinearSystemFactory
   {
     IParallelMng* pm = sd->parallelMng();
     bool is_parallel = pm->isParallel();
-    // If true, we use a dense debug matrix in sequential
+    // If true, we use the basic sequential matrix
     bool use_debug_dense_matrix = false;
 #ifdef ENABLE_DEBUG_MATRIX
     use_debug_dense_matrix = true;
@@ -312,6 +558,17 @@ class DefaultDoFLinearSystemFactory
 DoFLinearSystem::
 DoFLinearSystem()
 {
+  String snapshot_format = platform::getEnvironmentVariable("ARCANEFEM_LINEAR_SYSTEM_SNAPSHOT");
+  if (snapshot_format == "binary")
+    m_snapshot_format = eLinearSystemSnapshotFormat::Binary;
+  else if (snapshot_format == "matrix-market")
+    m_snapshot_format = eLinearSystemSnapshotFormat::MatrixMarket;
+  else if (!snapshot_format.null())
+    ARCANE_FATAL("Invalid value '{0}' for environment variable ARCANEFEM_LINEAR_SYSTEM_SNAPSHOT"
+                 " (valid values are 'binary' or 'matrix-market')",
+                 snapshot_format);
+  m_snapshot_directory = platform::getEnvironmentVariable("ARCANEFEM_LINEAR_SYSTEM_SNAPSHOT_DIRECTORY");
+  m_solve_report_file_name = platform::getEnvironmentVariable("ARCANEFEM_SOLVE_REPORT_FILE");
 }
 
 /*---------------------------------------------------------------------------*/
@@ -321,6 +578,8 @@ DoFLinearSystem::
 ~DoFLinearSystem()
 {
   delete m_p;
+  delete m_rhs_array_variable;
+  delete m_solution_array_variable;
   delete m_default_linear_system_factory;
 }
 
@@ -351,7 +610,9 @@ initialize(ISubDomain* sd, Runner* runner, IItemFamily* dof_family, const String
       m_default_linear_system_factory = new DefaultDoFLinearSystemFactory();
     m_linear_system_factory = m_default_linear_system_factory;
   }
+  m_sub_domain = sd;
   m_item_family = dof_family;
+  m_solver_name = solver_name;
   m_p = m_linear_system_factory->createInstance(sd, dof_family, solver_name);
   m_p->setRunner(runner);
 }
@@ -412,7 +673,247 @@ void DoFLinearSystem::
 solve()
 {
   _checkInit();
+  // The implementations modify the matrix and the RHS during the solve
+  // so the snapshot has to be filled before.
+  LinearSystemSnapshot snapshot;
+  bool has_snapshot = _fillSnapshot(snapshot);
+  Real begin_time = platform::getRealTime();
   m_p->solve();
+  m_solve_report = m_p->solveReport();
+  m_solve_report.total_time = platform::getRealTime() - begin_time;
+  _writeSolveReport();
+  if (has_snapshot)
+    _writeSnapshot(snapshot);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Fill \a snapshot with the current linear system.
+ *
+ * Returns false if no snapshot has to be written.
+ */
+bool DoFLinearSystem::
+_fillSnapshot(LinearSystemSnapshot& snapshot)
+{
+  if (m_snapshot_format == eLinearSystemSnapshotFormat::None)
+    return false;
+  ITraceMng* tm = m_item_family->traceMng();
+  CSRFormatView& csr_view = m_p->getCSRValues();
+  if (!m_p->hasSetCSRValues() || csr_view.nbRow() == 0) {
+    tm->pwarning() << "No snapshot for linear system '" << m_solver_name
+                   << "' because the matrix has not been set with setCSRValues()";
+    return false;
+  }
+
+  IParallelMng* pm = m_sub_domain->parallelMng();
+  snapshot.comm_rank = pm->commRank();
+  snapshot.comm_size = pm->commSize();
+  snapshot.block_size = m_block_size;
+  snapshot.rows.copy(csr_view.rows());
+  snapshot.rows_nb_column.copy(csr_view.rowsNbColumn());
+  snapshot.columns.copy(csr_view.columns());
+  snapshot.values.copy(csr_view.values());
+
+  const Int32 nb_row = csr_view.nbRow();
+  snapshot.dof_uids.resize(nb_row);
+  snapshot.dof_uids.fill(NULL_ITEM_UNIQUE_ID);
+  snapshot.dof_owners.resize(nb_row);
+  snapshot.dof_owners.fill(A_NULL_RANK);
+  snapshot.rhs.resize(nb_row);
+  snapshot.rhs.fill(0.0);
+  snapshot.initial_solution.resize(nb_row);
+  snapshot.initial_solution.fill(0.0);
+  snapshot.forced_info.resize(nb_row);
+  snapshot.forced_info.fill(0);
+  snapshot.forced_value.resize(nb_row);
+  snapshot.forced_value.fill(0.0);
+  snapshot.elimination_info.resize(nb_row);
+  snapshot.elimination_info.fill(0);
+  snapshot.elimination_value.resize(nb_row);
+  snapshot.elimination_value.fill(0.0);
+
+  VariableDoFReal& rhs_variable(m_p->rhsVariable());
+  VariableDoFReal& solution_variable(m_p->solutionVariable());
+  VariableDoFBool& forced_info(m_p->getForcedInfo());
+  VariableDoFReal& forced_value(m_p->getForcedValue());
+  VariableDoFByte& elimination_info(m_p->getEliminationInfo());
+  VariableDoFReal& elimination_value(m_p->getEliminationValue());
+  ENUMERATE_ (DoF, idof, m_item_family->allItems()) {
+    DoF dof = *idof;
+    Int32 lid = dof.localId();
+    if (lid >= nb_row)
+      ARCANE_FATAL("Local id '{0}' of DoF is greater than the number of rows of the matrix '{1}'", lid, nb_row);
+    snapshot.dof_uids[lid] = dof.uniqueId().asInt64();
+    snapshot.dof_owners[lid] = dof.owner();
+    snapshot.rhs[lid] = rhs_variable[dof];
+    snapshot.initial_solution[lid] = solution_variable[dof];
+    snapshot.forced_info[lid] = (forced_info[dof]) ? 1 : 0;
+    snapshot.forced_value[lid] = forced_value[dof];
+    snapshot.elimination_info[lid] = elimination_info[dof];
+    snapshot.elimination_value[lid] = elimination_value[dof];
+  }
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Add the solution to \a snapshot and write it.
+ */
+void DoFLinearSystem::
+_writeSnapshot(LinearSystemSnapshot& snapshot)
+{
+  const Int32 nb_row = snapshot.nbRow();
+  snapshot.solution.resize(nb_row);
+  snapshot.solution.fill(0.0);
+  VariableDoFReal& solution_variable(m_p->solutionVariable());
+  ENUMERATE_ (DoF, idof, m_item_family->allItems()) {
+    snapshot.solution[idof.itemLocalId()] = solution_variable[idof];
+  }
+
+  const CommonVariables& cv = m_sub_domain->commonVariables();
+  String file_name = String::format("{0}.{1}", m_solver_name, cv.globalIteration());
+  String file_prefix;
+  if (m_snapshot_directory.null())
+    file_prefix = m_sub_domain->listingDirectory().file(file_name);
+  else {
+    Directory directory(m_snapshot_directory);
+    directory.createDirectory();
+    file_prefix = directory.file(file_name);
+  }
+  m_item_family->traceMng()->info() << "Writing snapshot of linear system '" << m_solver_name
+                                    << "' prefix=" << file_prefix;
+  snapshot.write(file_prefix, m_snapshot_format);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DoFLinearSystem::
+solveMultipleRhs()
+{
+  _checkInit();
+  _createArrayVariables();
+  Real begin_time = platform::getRealTime();
+  m_p->solveMultipleRhs(*m_rhs_array_variable, *m_solution_array_variable);
+  m_solve_report = m_p->solveReport();
+  m_solve_report.nb_rhs = m_nb_rhs;
+  m_solve_report.total_time = platform::getRealTime() - begin_time;
+  _writeSolveReport();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool DoFLinearSystem::
+hasSolveMultipleRhs() const
+{
+  _checkInit();
+  return m_p->hasSolveMultipleRhs();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DoFLinearSystem::
+setNbRhs(Int32 nb_rhs)
+{
+  _checkInit();
+  if (nb_rhs < 1)
+    ARCANE_FATAL("Invalid number of right hand sides '{0}'", nb_rhs);
+  m_nb_rhs = nb_rhs;
+  _createArrayVariables();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+VariableDoFArrayReal& DoFLinearSystem::
+rhsArrayVariable()
+{
+  _checkInit();
+  _createArrayVariables();
+  return *m_rhs_array_variable;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+VariableDoFArrayReal& DoFLinearSystem::
+solutionArrayVariable()
+{
+  _checkInit();
+  _createArrayVariables();
+  return *m_solution_array_variable;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Create (if needed) the variables used by solveMultipleRhs().
+ *
+ * They are only created when used because they take nbRhs() values per
+ * DoF.
+ */
+void DoFLinearSystem::
+_createArrayVariables()
+{
+  if (!m_rhs_array_variable) {
+    m_rhs_array_variable = new VariableDoFArrayReal(VariableBuildInfo(m_item_family, m_solver_name + "RHSArrayVariable"));
+    m_solution_array_variable = new VariableDoFArrayReal(VariableBuildInfo(m_item_family, m_solver_name + "SolutionArrayVariable"));
+  }
+  if (m_rhs_array_variable->arraySize() != m_nb_rhs) {
+    m_rhs_array_variable->resize(m_nb_rhs);
+    m_solution_array_variable->resize(m_nb_rhs);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+const SolveReport& DoFLinearSystem::
+solveReport() const
+{
+  return m_solve_report;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Append the report of the last solve to the file given by
+ * setSolveReportFileName().
+ *
+ * There is one line per solve. The file is truncated by the first solve of
+ * this instance so that all the time steps are in the same file.
+ */
+void DoFLinearSystem::
+_writeSolveReport()
+{
+  if (m_solve_report_file_name.empty())
+    return;
+  if (!m_sub_domain->parallelMng()->isMasterIO())
+    return;
+
+  String file_name = m_sub_domain->listingDirectory().file(m_solve_report_file_name);
+  bool is_new_file = !m_is_solve_report_file_created;
+  m_is_solve_report_file_created = true;
+
+  std::ofstream ofile(file_name.localstr(), is_new_file ? std::ios::trunc : std::ios::app);
+  if (!ofile) {
+    m_sub_domain->traceMng()->pwarning() << "Can not open solve report file '" << file_name << "'";
+    return;
+  }
+  ofile.precision(12);
+  if (is_new_file)
+    ofile << "iteration,time,solver,linear_system,nb_rhs,nb_iteration,residual,converged,"
+          << "matrix_build_time,setup_time,solve_time,total_time,nb_transferred_byte\n";
+  const CommonVariables& cv = m_sub_domain->commonVariables();
+  const SolveReport& r = m_solve_report;
+  ofile << cv.globalIteration() << "," << cv.globalTime() << "," << m_solver_name << ","
+        << r.linear_system_name << "," << r.nb_rhs << "," << r.nb_iteration << "," << r.residual << ","
+        << r.convergedFlag() << "," << r.matrix_build_time << "," << r.setup_time << ","
+        << r.solve_time << "," << r.total_time << "," << r.nb_transferred_byte << "\n";
 }
 
 /*---------------------------------------------------------------------------*/
@@ -458,6 +959,16 @@ setCSRValues(const CSRFormatView& csr_view)
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+void DoFLinearSystem::
+setCSRValues(const CSRFormatView64& csr_view)
+{
+  _checkInit();
+  return m_p->setCSRValues64(csr_view);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 CSRFormatView& DoFLinearSystem::getCSRValues()
 {
   _checkInit();
@@ -513,11 +1024,58 @@ hasSetCSRValues() const
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+bool DoFLinearSystem::
+hasSetCSRValues64() const
+{
+  _checkInit();
+  return m_p->hasSetCSRValues64();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DoFLinearSystem::
+setBlockSize(Int32 block_size)
+{
+  _checkInit();
+  m_block_size = block_size;
+  m_p->setBlockSize(block_size);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void DoFLinearSystem::
+setLinearOperator(IDoFLinearOperator* linear_operator)
+{
+  _checkInit();
+  m_p->setLinearOperator(linear_operator);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool DoFLinearSystem::
+hasSetLinearOperator() const
+{
+  _checkInit();
+  return m_p->hasSetLinearOperator();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void DoFLinearSystem::
 reset()
 {
   delete m_p;
   m_p = nullptr;
+  delete m_rhs_array_variable;
+  m_rhs_array_variable = nullptr;
+  delete m_solution_array_variable;
+  m_solution_array_variable = nullptr;
+  m_nb_rhs = 1;
+  m_block_size = 1;
   m_item_family = nullptr;
 }
 
@@ -576,6 +1134,53 @@ class SequentialBasicDoFLinearSystemFactoryService
 ARCANE_REGISTER_SERVICE_SEQUENTIALBASICDOFLINEARSYSTEMFACTORY(SequentialBasicLinearSystem,
                                                               SequentialBasicDoFLinearSystemFactoryService);
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Sequential linear system solved with a sparse direct solver.
+ *
+ * The solver is kept by the service so its factorization is reused between
+ * the linear systems created by the service (for example at each time step
+ * of a transient run) as long as the matrix does not change.
+ */
+class SparseDirectDoFLinearSystemFactoryService
+: public ArcaneSparseDirectDoFLinearSystemFactoryObject
+{
+ public:
+
+  explicit SparseDirectDoFLinearSystemFactoryService(const ServiceBuildInfo& sbi)
+  : ArcaneSparseDirectDoFLinearSystemFactoryObject(sbi)
+  {
+  }
+
+  DoFLinearSystemImpl*
+  createInstance(ISubDomain* sd, IItemFamily* dof_family, const String& solver_name) override
+  {
+    IParallelMng* pm = sd->parallelMng();
+    if (pm->isParallel())
+      ARCANE_FATAL("This service is not available in parallel");
+    if (!m_solver)
+      m_solver = std::make_unique<SparseDirectSolver>(traceMng());
+    m_solver->setOrdering(options()->ordering());
+    m_solver->setReuseFactorization(options()->reuseFactorization());
+    auto* x = new SequentialDoFLinearSystemImpl(sd, dof_family, solver_name);
+    x->build();
+    x->setSolverMethod(eInternalSolverMethod::SparseDirect);
+    x->setSparseDirectSolver(m_solver.get());
+    return x;
+  }
+
+ private:
+
+  std::unique_ptr<SparseDirectSolver> m_solver;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE_SPARSEDIRECTDOFLINEARSYSTEMFACTORY(SparseDirectLinearSystem,
+                                                           SparseDirectDoFLinearSystemFactoryService);
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -24,9 +24,15 @@
 #include <arcane/utils/ArrayLayout.h>
 #include <arcane/utils/UtilsTypes.h>
 #include <arcane/utils/ArrayView.h>
+#include <arcane/utils/String.h>
+#include <arcane/utils/Math.h>
 #include <arcane/utils/NumArray.h>
 #include <arcane/utils/MDDim.h>
 
+#include <type_traits>
+
+#include "LinearSystemSnapshot.h"
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -34,20 +40,49 @@ namespace Arcane::FemUtils
 {
 class IDoFLinearSystemFactory;
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Values of DoFLinearSystem::getEliminationInfo().
+ *
+ * ELIMINATE_ROW and ELIMINATE_ROW_COLUMN correspond respectively to
+ * DoFLinearSystem::eliminateRow() and DoFLinearSystem::eliminateRowColumn().
+ */
+//! The DoF is not eliminated
+static constexpr Byte ELIMINATE_NONE = 0;
+//! The row of the DoF is eliminated
+static constexpr Byte ELIMINATE_ROW = 1;
+//! The row and the column of the DoF are eliminated
+static constexpr Byte ELIMINATE_ROW_COLUMN = 2;
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 /*!
  * \brief Vue au format CSR pour le solveur linéaire.
+ *
+ * \a IndexType is the type of the row offsets, and thus of the number of
+ * values (Int32 or Int64). The columns are the local ids of the DoFs and
+ * the number of columns of a row is small so they are always Int32.
+ *
+ * The structure version identifies the rows and the columns of the view.
+ * The producer of the view takes a new version with
+ * newCSRStructureVersion() each time the structure changes so that the
+ * linear system can keep the data computed from the structure. A view
+ * without version (-1) is always considered as a new structure.
  */
-class CSRFormatView
+template <typename IndexType>
+class CSRFormatViewT
 {
+  static_assert(std::is_same_v<IndexType, Int32> || std::is_same_v<IndexType, Int64>,
+                "CSRFormatViewT only supports Int32 or Int64 indexes");
+
  public:
 
-  CSRFormatView() = default;
-  CSRFormatView(Span<const Int32> rows,
-                Span<const Int32> matrix_rows_nb_column,
-                Span<const Int32> columns,
-                Span<Real> values)
+  CSRFormatViewT() = default;
+  CSRFormatViewT(Span<const IndexType> rows,
+                 Span<const Int32> matrix_rows_nb_column,
+                 Span<const Int32> columns,
+                 Span<Real> values)
   : m_matrix_rows(rows)
   , m_matrix_rows_nb_column(matrix_rows_nb_column)
   , m_matrix_columns(columns)
@@ -56,23 +91,125 @@ class CSRFormatView
 
  public:
 
-  Span<const Int32> rows() const { return m_matrix_rows; }
+  Span<const IndexType> rows() const { return m_matrix_rows; }
   Span<const Int32> rowsNbColumn() const { return m_matrix_rows_nb_column; }
   Span<const Int32> columns() const { return m_matrix_columns; }
   Span<Real> values() { return m_values; }
 
-  Int32 nbRow() { return m_matrix_rows.size(); }
-  Int32 nbColumn() { return m_matrix_columns.size(); }
-  Int32 nbValue() { return m_values.size(); }
+  Int32 nbRow() { return static_cast<Int32>(m_matrix_rows.size()); }
+  IndexType nbColumn() { return static_cast<IndexType>(m_matrix_columns.size()); }
+  IndexType nbValue() { return static_cast<IndexType>(m_values.size()); }
+
+  IndexType row(Int32 index) { return m_matrix_rows[index]; }
 
-  Int32 row(Int32 index) { return m_matrix_rows[index]; }
+  Int64 structureVersion() const { return m_structure_version; }
+  void setStructureVersion(Int64 v) { m_structure_version = v; }
 
  private:
 
-  Span<const Int32> m_matrix_rows;
+  Span<const IndexType> m_matrix_rows;
   Span<const Int32> m_matrix_rows_nb_column;
   Span<const Int32> m_matrix_columns;
   Span<Real> m_values;
+  Int64 m_structure_version = -1;
+};
+
+//! CSR view with 32-bit row offsets
+using CSRFormatView = CSRFormatViewT<Int32>;
+//! CSR view with 64-bit row offsets, for more than 2^31 values per sub-domain
+using CSRFormatView64 = CSRFormatViewT<Int64>;
+
+//! Returns a new structure version for a CSR view (never returned twice)
+extern "C++" Int64 newCSRStructureVersion();
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Report of the last call to DoFLinearSystem::solve().
+ *
+ * The values which are not available for an implementation keep their
+ * default value (-1 for the number of iterations and the residual) and
+ * \a is_convergence_known is false if the implementation can not tell if
+ * the solver has converged. Times are in seconds and are those of the
+ * current sub-domain.
+ */
+class SolveReport
+{
+ public:
+
+  //! Name of the implementation (for example 'Hypre')
+  String linear_system_name;
+  //! Number of iterations of the solver
+  Int32 nb_iteration = -1;
+  //! Final relative residual norm
+  Real residual = -1.0;
+  //! Indicate if the solver has converged (only relevant if is_convergence_known is true)
+  bool is_converged = true;
+  //! False if the implementation does not know if the solver has converged
+  bool is_convergence_known = true;
+  //! Time to build the matrix used by the solver (copies included)
+  Real matrix_build_time = 0.0;
+  //! Time to setup the solver and the preconditioner
+  Real setup_time = 0.0;
+  //! Time of the iterations of the solver
+  Real solve_time = 0.0;
+  //! Total time of DoFLinearSystem::solve()
+  Real total_time = 0.0;
+  //! Number of bytes copied between the DoF variables and the solver
+  Int64 nb_transferred_byte = 0;
+  //! Number of right hand sides solved
+  Int32 nb_rhs = 1;
+
+ public:
+
+  /*!
+   * \brief Merge the report \a r of the solve of another RHS.
+   *
+   * Times and bytes are summed. The number of iterations and the residual
+   * are the maximum over all the RHS.
+   */
+  void merge(const SolveReport& r)
+  {
+    nb_iteration = math::max(nb_iteration, r.nb_iteration);
+    residual = math::max(residual, r.residual);
+    is_converged = is_converged && r.is_converged;
+    is_convergence_known = is_convergence_known && r.is_convergence_known;
+    matrix_build_time += r.matrix_build_time;
+    setup_time += r.setup_time;
+    solve_time += r.solve_time;
+    nb_transferred_byte += r.nb_transferred_byte;
+  }
+
+  //! 1 if the solver has converged, 0 if not and -1 if it is not known
+  Int32 convergedFlag() const
+  {
+    if (!is_convergence_known)
+      return -1;
+    return (is_converged) ? 1 : 0;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Linear operator applied without storing the matrix.
+ *
+ * The vectors are indexed by the local ids of the DoFs. When apply() is
+ * called, the values of \a x for ghost DoFs are up to date.
+ */
+class IDoFLinearOperator
+{
+ public:
+
+  virtual ~IDoFLinearOperator() = default;
+
+ public:
+
+  //! Compute y = A.x. Only the values of \a y for own DoFs are relevant
+  virtual void apply(Span<const Real> x, Span<Real> y) = 0;
+
+  //! Fill \a diagonal with the diagonal of A (for own DoFs)
+  virtual void computeDiagonal(Span<Real> diagonal) = 0;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -105,8 +242,16 @@ class DoFLinearSystemImpl
   virtual VariableDoFByte& getEliminationInfo() = 0;
   virtual VariableDoFReal& getEliminationValue() = 0;
   virtual bool hasSetCSRValues() const = 0;
+  virtual void setCSRValues64(const CSRFormatView64& csr_view) = 0;
+  virtual bool hasSetCSRValues64() const = 0;
   virtual void setRunner(Runner* r) = 0;
   virtual Runner* runner() const = 0;
+  virtual void setBlockSize(Int32 block_size) = 0;
+  virtual void setLinearOperator(IDoFLinearOperator* linear_operator) = 0;
+  virtual bool hasSetLinearOperator() const = 0;
+  virtual const SolveReport& solveReport() const = 0;
+  virtual void solveMultipleRhs(VariableDoFArrayReal& rhs, VariableDoFArrayReal& solution) = 0;
+  virtual bool hasSolveMultipleRhs() const = 0;
 };
 
 /*---------------------------------------------------------------------------*/
@@ -194,9 +339,53 @@ class DoFLinearSystem
 
   /*!
    * \brief Solve the current linear system.
+   *
+   * After the solve, the report of the solver is available with
+   * solveReport() and is appended to the file given by
+   * setSolveReportFileName() if any.
    */
   void solve();
 
+  /*!
+   * \brief Solve the current linear system for several right hand sides.
+   *
+   * The matrix is assembled and the solver (and its preconditioner) is
+   * set up only one time, then the system is solved for each of the
+   * setNbRhs() columns of rhsArrayVariable(). The solution of the RHS
+   * \a k is put in the column \a k of solutionArrayVariable() (the values
+   * of this column are used as initial guess).
+   *
+   * Eliminations are applied the same way to all the RHS. Forced values
+   * (penalty) only change the matrix so the RHS may use different values.
+   * The values of rhsVariable() are not used.
+   *
+   * The report has the maximum number of iterations and residual over all
+   * the RHS and the total times.
+   */
+  void solveMultipleRhs();
+
+  //! Indicate if the implementation supports solveMultipleRhs()
+  bool hasSolveMultipleRhs() const;
+
+  //! Set the number of right hand sides used by solveMultipleRhs()
+  void setNbRhs(Int32 nb_rhs);
+
+  //! Number of right hand sides used by solveMultipleRhs()
+  Int32 nbRhs() const { return m_nb_rhs; }
+
+  /*!
+   * \brief Variable containing the right hand sides for solveMultipleRhs().
+   *
+   * There is one column per RHS.
+   */
+  VariableDoFArrayReal& rhsArrayVariable();
+
+  //! Variable containing the solutions computed by solveMultipleRhs()
+  VariableDoFArrayReal& solutionArrayVariable();
+
+  //! Report of the last call to solve() or solveMultipleRhs()
+  const SolveReport& solveReport() const;
+
   /*!
    * \brief Reset the current instance.
    *
@@ -254,12 +443,100 @@ class DoFLinearSystem
    * Positionne les valeurs de la matrice en considérant le format comme
    * étant au format CSR. Les vues doivent rester valides jusqu'à la
    * résolution du système linéaire (appel à solve()).
+   *
+   * The values of the view are not modified by solve(): the eliminations
+   * and the forced values are applied on a copy, so the same view can be
+   * solved again without a new assembly.
    */
   void setCSRValues(const CSRFormatView& csr_view);
 
   //! Indique si l'implémentation supporte d'utiliser setCSRValue()
   bool hasSetCSRValues() const;
 
+  /*!
+   * \brief Set the values of the matrix with 64-bit row offsets.
+   *
+   * Same as setCSRValues() but the row offsets are Int64 so a sub-domain
+   * can have more than 2^31 values. Only available if
+   * hasSetCSRValues64() is true (Hypre implementation). No snapshot is
+   * written for such a matrix.
+   */
+  void setCSRValues(const CSRFormatView64& csr_view);
+
+  //! Indicate if the implementation supports setCSRValues() with a CSRFormatView64
+  bool hasSetCSRValues64() const;
+
+  /*!
+   * \brief Set the number of DoFs per node (block size) of the system.
+   *
+   * The DoFs of a node are assumed to be numbered contiguously, as done
+   * by FemDoFsOnNodes. This is only a hint: implementations which do not
+   * use it (Aleph, sequential) ignore it. The Hypre implementation uses it
+   * to enable systems (unknown/nodal) BoomerAMG.
+   */
+  void setBlockSize(Int32 block_size);
+
+  /*!
+   * \brief Use \a linear_operator instead of an assembled matrix.
+   *
+   * In this mode the matrix is never stored: the solver only calls
+   * IDoFLinearOperator::apply() and IDoFLinearOperator::computeDiagonal().
+   * Forced values and eliminations are still taken into account.
+   * \a linear_operator has to stay valid until the call to solve().
+   * Using a null pointer goes back to the assembled matrix.
+   */
+  void setLinearOperator(IDoFLinearOperator* linear_operator);
+
+  //! Indicate if the implementation supports setLinearOperator()
+  bool hasSetLinearOperator() const;
+
+  /*!
+   * \brief Write a snapshot of the linear system at each call to solve().
+   *
+   * Each sub-domain writes the CSR matrix, the RHS, the solution and the
+   * numbering of its DoFs (see LinearSystemSnapshot) in the files
+   * '<solver_name>.<global_iteration>.<rank>' of the snapshot directory.
+   * A binary snapshot can be solved again with the 'Replay' code to tune
+   * the solver without doing the assembly again.
+   *
+   * The snapshot is only available if the matrix has been given with
+   * setCSRValues() and is not written by solveMultipleRhs().
+   *
+   * The default format is given by the environment variable
+   * ARCANEFEM_LINEAR_SYSTEM_SNAPSHOT ('binary' or 'matrix-market').
+   */
+  void setSnapshotFormat(eLinearSystemSnapshotFormat format) { m_snapshot_format = format; }
+
+  //! Format of the snapshot written by solve()
+  eLinearSystemSnapshotFormat snapshotFormat() const { return m_snapshot_format; }
+
+  /*!
+   * \brief Set the CSV file where the report of each solve is appended.
+   *
+   * The name is relative to the listing directory. The file is truncated by
+   * the first solve of this instance and then has one line per solve. It is
+   * only written by the master sub-domain. If the name is empty, no file is
+   * written. The name is kept by reset().
+   *
+   * The default name is given by the environment variable
+   * ARCANEFEM_SOLVE_REPORT_FILE so that every module can write its report.
+   */
+  void setSolveReportFileName(const String& file_name)
+  {
+    if (file_name != m_solve_report_file_name)
+      m_is_solve_report_file_created = false;
+    m_solve_report_file_name = file_name;
+  }
+
+  /*!
+   * \brief Set the directory where the snapshots are written.
+   *
+   * If null, the default value is given by the environment variable
+   * ARCANEFEM_LINEAR_SYSTEM_SNAPSHOT_DIRECTORY and if this variable is
+   * not set, the listing directory is used.
+   */
+  void setSnapshotDirectory(const String& directory) { m_snapshot_directory = directory; }
+
  public:
 
   CSRFormatView& getCSRValues();
@@ -276,13 +553,29 @@ class DoFLinearSystem
  private:
 
   DoFLinearSystemImpl* m_p = nullptr;
+  ISubDomain* m_sub_domain = nullptr;
   IItemFamily* m_item_family = nullptr;
+  String m_solver_name;
+  SolveReport m_solve_report;
+  //! File of the solve reports (see setSolveReportFileName())
+  String m_solve_report_file_name;
+  bool m_is_solve_report_file_created = false;
+  Int32 m_nb_rhs = 1;
+  Int32 m_block_size = 1;
+  eLinearSystemSnapshotFormat m_snapshot_format = eLinearSystemSnapshotFormat::None;
+  String m_snapshot_directory;
+  VariableDoFArrayReal* m_rhs_array_variable = nullptr;
+  VariableDoFArrayReal* m_solution_array_variable = nullptr;
   IDoFLinearSystemFactory* m_linear_system_factory = nullptr;
   IDoFLinearSystemFactory* m_default_linear_system_factory = nullptr;
 
  private:
 
   void _checkInit() const;
+  void _createArrayVariables();
+  void _writeSolveReport();
+  bool _fillSnapshot(LinearSystemSnapshot& snapshot);
+  void _writeSnapshot(LinearSystemSnapshot& snapshot);
 };
 
 /*---------------------------------------------------------------------------*/
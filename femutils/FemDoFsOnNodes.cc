@@ -13,10 +13,15 @@
 
 #include "FemDoFsOnNodes.h"
 
+#include <arcane/utils/FatalErrorException.h>
 #include <arcane/mesh/DoFFamily.h>
 #include "arcane/IIndexedIncrementalItemConnectivityMng.h"
 #include "arcane/IIndexedIncrementalItemConnectivity.h"
 #include "arcane/IndexedItemConnectivityView.h"
+#include "arcane/ItemInfoListView.h"
+#include "arcane/VariableTypes.h"
+
+#include <algorithm>
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -39,14 +44,36 @@ class FemDoFsOnNodes::Impl
 
  public:
 
-  void initialize(IMesh* mesh, Int32 nb_dof_per_node);
+  void initialize(IMesh* mesh, Int32 nb_dof_per_node, eNodeRenumbering renumbering);
 
  public:
 
   Ref<IIndexedIncrementalItemConnectivity> m_node_dof_connectivity;
   IItemFamily* m_dof_family = nullptr;
+  eNodeRenumbering m_renumbering = eNodeRenumbering::None;
+
+ private:
+
+  UniqueArray<Int32> _computeNodeOrder(IMesh* mesh, eNodeRenumbering renumbering);
+  void _sortReverseCuthillMcKee(IMesh* mesh, Array<Int32>& ordered_nodes);
+  void _sortMorton(IMesh* mesh, Array<Int32>& ordered_nodes);
 };
 
+namespace
+{
+  //! Spread the 21 lower bits of \a v so that there are two zero bits between each bit
+  UInt64 _spreadBits(UInt64 v)
+  {
+    v &= 0x1fffff;
+    v = (v | v << 32) & 0x1f00000000ffff;
+    v = (v | v << 16) & 0x1f0000ff0000ff;
+    v = (v | v << 8) & 0x100f00f00f00f00f;
+    v = (v | v << 4) & 0x10c30c30c30c30c3;
+    v = (v | v << 2) & 0x1249249249249249;
+    return v;
+  }
+} // namespace
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -69,18 +96,23 @@ FemDoFsOnNodes::
 /*---------------------------------------------------------------------------*/
 
 void FemDoFsOnNodes::Impl::
-initialize(IMesh* mesh, Int32 nb_dof_per_node)
+initialize(IMesh* mesh, Int32 nb_dof_per_node, eNodeRenumbering renumbering)
 {
   IItemFamily* dof_family_interface = mesh->findItemFamily(Arcane::IK_DoF, "DoFNodeFamily", true);
   mesh::DoFFamily* dof_family = ARCANE_CHECK_POINTER(dynamic_cast<mesh::DoFFamily*>(dof_family_interface));
   m_dof_family = dof_family_interface;
+  m_renumbering = renumbering;
+
+  // The DoFs are created in the order of 'ordered_nodes' so their local ids follow this order
+  UniqueArray<Int32> ordered_nodes = _computeNodeOrder(mesh, renumbering);
+  NodeInfoListView nodes(mesh->nodeFamily());
 
   // Create the DoFs
-  Int64UniqueArray uids(mesh->allNodes().size() * nb_dof_per_node);
+  Int64UniqueArray uids(ordered_nodes.size() * nb_dof_per_node);
   {
     Integer dof_index = 0;
-    ENUMERATE_NODE (inode, mesh->allNodes()) {
-      Node node = *inode;
+    for (Int32 node_lid : ordered_nodes) {
+      Node node = nodes[node_lid];
       Int64 node_unique_id = node.uniqueId().asInt64();
       for (Integer i = 0; i < nb_dof_per_node; ++i) {
         uids[dof_index] = node_unique_id * nb_dof_per_node + i;
@@ -99,8 +131,8 @@ initialize(IMesh* mesh, Int32 nb_dof_per_node)
   auto* cn = m_node_dof_connectivity->connectivity();
   {
     Integer dof_index = 0;
-    ENUMERATE_NODE (inode, mesh->allNodes()) {
-      NodeLocalId node = *inode;
+    for (Int32 node_lid : ordered_nodes) {
+      NodeLocalId node(node_lid);
       for (Integer i = 0; i < nb_dof_per_node; ++i) {
         cn->addConnectedItem(node, DoFLocalId(dof_lids[dof_index]));
         ++dof_index;
@@ -127,13 +159,190 @@ initialize(IMesh* mesh, Int32 nb_dof_per_node)
   }
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Local ids of the nodes in the order used to number the DoFs.
+ */
+UniqueArray<Int32> FemDoFsOnNodes::Impl::
+_computeNodeOrder(IMesh* mesh, eNodeRenumbering renumbering)
+{
+  UniqueArray<Int32> ordered_nodes;
+  ordered_nodes.reserve(mesh->allNodes().size());
+  ENUMERATE_NODE (inode, mesh->allNodes()) {
+    ordered_nodes.add(inode.itemLocalId());
+  }
+
+  switch (renumbering) {
+  case eNodeRenumbering::None:
+    break;
+  case eNodeRenumbering::ReverseCuthillMcKee:
+    _sortReverseCuthillMcKee(mesh, ordered_nodes);
+    break;
+  case eNodeRenumbering::Morton:
+    _sortMorton(mesh, ordered_nodes);
+    break;
+  }
+  return ordered_nodes;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Sort the nodes with the Reverse Cuthill-McKee algorithm.
+ *
+ * Two nodes are neighbors if they share a cell. Each connected component
+ * is traversed in breadth-first order from a node of minimal degree, the
+ * neighbors of a node being added by increasing degree, and the final
+ * order is reversed.
+ */
+void FemDoFsOnNodes::Impl::
+_sortReverseCuthillMcKee(IMesh* mesh, Array<Int32>& ordered_nodes)
+{
+  const Int32 max_lid = mesh->nodeFamily()->maxLocalId();
+  const Int32 nb_node = ordered_nodes.size();
+  NodeInfoListView nodes(mesh->nodeFamily());
+
+  // Node graph (CSR indexed by the local ids of the nodes)
+  UniqueArray<Int32> neighbor_begin(max_lid, 0);
+  UniqueArray<Int32> degrees(max_lid, 0);
+  UniqueArray<Int32> neighbors;
+  {
+    UniqueArray<Int32> last_seen(max_lid, -1);
+    for (Int32 node_lid : ordered_nodes) {
+      last_seen[node_lid] = node_lid;
+      neighbor_begin[node_lid] = neighbors.size();
+      for (Cell cell : nodes[node_lid].cells())
+        for (NodeLocalId neighbor : cell.nodeIds())
+          if (last_seen[neighbor] != node_lid) {
+            last_seen[neighbor] = node_lid;
+            neighbors.add(neighbor);
+          }
+      degrees[node_lid] = neighbors.size() - neighbor_begin[node_lid];
+    }
+  }
+  auto is_lower_degree = [&](Int32 a, Int32 b) { return degrees[a] < degrees[b]; };
+
+  UniqueArray<Int32> start_nodes(ordered_nodes);
+  std::stable_sort(start_nodes.begin(), start_nodes.end(), is_lower_degree);
+
+  UniqueArray<Byte> is_visited(max_lid, 0);
+  UniqueArray<Int32> new_order;
+  new_order.reserve(nb_node);
+  for (Int32 start_node : start_nodes) {
+    if (is_visited[start_node])
+      continue;
+    is_visited[start_node] = 1;
+    new_order.add(start_node);
+    for (Int32 head = new_order.size() - 1; head < new_order.size(); ++head) {
+      Int32 node_lid = new_order[head];
+      Int32 first_added = new_order.size();
+      for (Int32 i = neighbor_begin[node_lid], n = i + degrees[node_lid]; i < n; ++i) {
+        Int32 neighbor = neighbors[i];
+        if (!is_visited[neighbor]) {
+          is_visited[neighbor] = 1;
+          new_order.add(neighbor);
+        }
+      }
+      std::stable_sort(new_order.begin() + first_added, new_order.end(), is_lower_degree);
+    }
+  }
+  std::reverse(new_order.begin(), new_order.end());
+
+  // Bandwidth of the node graph before and after renumbering
+  auto compute_bandwidth = [&](ConstArrayView<Int32> order) {
+    UniqueArray<Int32> rank(max_lid, 0);
+    for (Int32 i = 0; i < nb_node; ++i)
+      rank[order[i]] = i;
+    Int32 bandwidth = 0;
+    for (Int32 node_lid : order)
+      for (Int32 i = neighbor_begin[node_lid], n = i + degrees[node_lid]; i < n; ++i)
+        bandwidth = std::max(bandwidth, std::abs(rank[node_lid] - rank[neighbors[i]]));
+    return bandwidth;
+  };
+  info() << "Reverse Cuthill-McKee renumbering: bandwidth=" << compute_bandwidth(ordered_nodes)
+         << " -> " << compute_bandwidth(new_order);
+
+  ordered_nodes.copy(new_order);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Sort the nodes along a Morton (Z-order) curve.
+ *
+ * The coordinates are scaled to the bounding box of the nodes and
+ * quantized on 21 bits per direction.
+ */
+void FemDoFsOnNodes::Impl::
+_sortMorton(IMesh* mesh, Array<Int32>& ordered_nodes)
+{
+  VariableNodeReal3& node_coord = mesh->nodesCoordinates();
+  const Int32 nb_node = ordered_nodes.size();
+  if (nb_node == 0)
+    return;
+
+  Real3 min_coord = node_coord[NodeLocalId(ordered_nodes[0])];
+  Real3 max_coord = min_coord;
+  for (Int32 node_lid : ordered_nodes) {
+    Real3 coord = node_coord[NodeLocalId(node_lid)];
+    min_coord = math::min(min_coord, coord);
+    max_coord = math::max(max_coord, coord);
+  }
+
+  const Real max_key = static_cast<Real>((1 << 21) - 1);
+  auto quantize = [&](Real x, Real min_x, Real max_x) -> UInt64 {
+    Real extent = max_x - min_x;
+    if (extent <= 0.0)
+      return 0;
+    return static_cast<UInt64>(((x - min_x) / extent) * max_key);
+  };
+
+  UniqueArray<std::pair<UInt64, Int32>> keys(nb_node);
+  for (Int32 i = 0; i < nb_node; ++i) {
+    Real3 coord = node_coord[NodeLocalId(ordered_nodes[i])];
+    UInt64 key = _spreadBits(quantize(coord.x, min_coord.x, max_coord.x));
+    key |= _spreadBits(quantize(coord.y, min_coord.y, max_coord.y)) << 1;
+    key |= _spreadBits(quantize(coord.z, min_coord.z, max_coord.z)) << 2;
+    keys[i] = std::make_pair(key, ordered_nodes[i]);
+  }
+  std::sort(keys.begin(), keys.end());
+  for (Int32 i = 0; i < nb_node; ++i)
+    ordered_nodes[i] = keys[i].second;
+  info() << "Morton renumbering of " << nb_node << " nodes";
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
 void FemDoFsOnNodes::
 initialize(IMesh* mesh, Int32 nb_dof_per_node)
 {
-  m_p->initialize(mesh, nb_dof_per_node);
+  m_p->initialize(mesh, nb_dof_per_node, eNodeRenumbering::None);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void FemDoFsOnNodes::
+initialize(IMesh* mesh, Int32 nb_dof_per_node, eNodeRenumbering renumbering)
+{
+  m_p->initialize(mesh, nb_dof_per_node, renumbering);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+eNodeRenumbering FemDoFsOnNodes::
+renumberingFromName(const String& name)
+{
+  if (name == "none")
+    return eNodeRenumbering::None;
+  if (name == "rcm")
+    return eNodeRenumbering::ReverseCuthillMcKee;
+  if (name == "morton")
+    return eNodeRenumbering::Morton;
+  ARCANE_FATAL("Unknown node renumbering '{0}' (valid values are 'none', 'rcm' and 'morton')", name);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -157,6 +366,15 @@ dofFamily() const
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+eNodeRenumbering FemDoFsOnNodes::
+nodeRenumbering() const
+{
+  return m_p->m_renumbering;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 }
 
 /*---------------------------------------------------------------------------*/
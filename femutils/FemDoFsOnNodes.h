@@ -26,6 +26,20 @@ namespace Arcane::FemUtils
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+//! Order in which the DoFs of the nodes are numbered
+enum class eNodeRenumbering
+{
+  //! Order of the nodes of the mesh
+  None,
+  //! Reverse Cuthill-McKee ordering of the node graph (reduces the bandwidth)
+  ReverseCuthillMcKee,
+  //! Morton (Z-order) space-filling curve of the node coordinates
+  Morton
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 /*!
  * \brief Manage one or more DoFs on Nodes.
  *
@@ -41,6 +55,12 @@ namespace Arcane::FemUtils
  * DoFLocalId dof0 = node_dof.dofId(node, 0); //< First DoF of the node
  * DoFLocalId dof1 = node_dof.dofId(node, 1); //< Second DoF of the node
  * \endcode
+ *
+ * The DoFs of a node have consecutive local ids. By default, the nodes are
+ * numbered in the order of the mesh. A renumbering (see eNodeRenumbering)
+ * can be given to initialize() to improve the locality of the matrices
+ * and vectors indexed by the DoFs: the local ids of the DoFs then follow
+ * the new order of the nodes and the local ids of the nodes are unchanged.
  */
 class FemDoFsOnNodes
 {
@@ -65,10 +85,23 @@ class FemDoFsOnNodes
    */
   void initialize(Arcane::IMesh* mesh, Arcane::Int32 nb_dof_per_node);
 
+  /*!
+   * \brief Initialize the instance with the DoFs numbered in the order \a renumbering.
+   */
+  void initialize(Arcane::IMesh* mesh, Arcane::Int32 nb_dof_per_node, eNodeRenumbering renumbering);
+
+  /*!
+   * \brief Renumbering from its name ('none', 'rcm' or 'morton').
+   *
+   * Throws an exception if the name is unknown.
+   */
+  static eNodeRenumbering renumberingFromName(const Arcane::String& name);
+
  public:
 
   Arcane::IndexedNodeDoFConnectivityView nodeDoFConnectivityView() const;
   Arcane::IItemFamily* dofFamily() const;
+  eNodeRenumbering nodeRenumbering() const;
 
  private:
 
@@ -14,9 +14,11 @@
 #include "DoFLinearSystem.h"
 
 #include <arcane/accelerator/RunCommandLoop.h>
+#include <arcane/accelerator/Reduce.h>
 #include <arcane/core/ItemTypes.h>
 #include <arcane/core/VariableTypedef.h>
 #include <arcane/utils/FatalErrorException.h>
+#include <arcane/utils/NotImplementedException.h>
 #include <arcane/utils/PlatformUtils.h>
 #include <arcane/utils/ArcaneGlobal.h>
 #include <arcane/utils/ArrayLayout.h>
@@ -33,6 +35,7 @@
 #include <arcane/core/VariableUtils.h>
 #include <arcane/core/IParallelMng.h>
 #include <arcane/core/IItemFamily.h>
+#include <arcane/core/IMesh.h>
 #include <arcane/core/ItemPrinter.h>
 #include <arcane/core/Timer.h>
 
@@ -43,12 +46,52 @@
 
 #include "FemUtils.h"
 #include "IDoFLinearSystemFactory.h"
-#include "HypreDoFLinearSystemFactory_axl.h"
 #include "ArcaneFemFunctionsGpu.h"
 
+namespace Arcane::FemUtils
+{
+/*!
+ * \brief Policy to reuse Hypre objects between two calls to solve().
+ */
+enum class eHypreReusePolicy
+{
+  //! Destroy and create again the matrix, the solver and the preconditioner
+  Rebuild,
+  //! Update the values of the matrix but keep the AMG hierarchy
+  ReuseSetup,
+  //! Keep the matrix and the solver. Only the RHS vector is updated.
+  ReuseAll
+};
+
+//! Hypre solver
+enum class eHypreSolver
+{
+  PCG,
+  GMRES,
+  FlexGMRES,
+  BiCGSTAB,
+  //! BoomerAMG used as a solver (no Krylov method)
+  AMG
+};
+
+//! Hypre preconditioner (not used if the solver is AMG)
+enum class eHyprePreconditioner
+{
+  None,
+  AMG,
+  //! Diagonal scaling
+  Jacobi,
+  ILU,
+  Euclid
+};
+} // namespace Arcane::FemUtils
+
+#include "HypreDoFLinearSystemFactory_axl.h"
+
 #include <HYPRE.h>
 #include <HYPRE_parcsr_ls.h>
 #include <krylov.h>
+#include <_hypre_utilities.h>
 
 // NOTE:
 // DoF family must be compacted (i.e maxLocalId()==nbItem()) and sorted
@@ -81,6 +124,15 @@ namespace
          << std::flush;
     throw Exception("HYPRE Check", hypre_func);
   }
+  //! Return \a int32_span if \a HypreType is Int32 and \a hypre_span otherwise
+  template <typename HypreType> Span<const HypreType>
+  _selectHypreSpan(Span<const Int32> int32_span, Span<const HypreType> hypre_span)
+  {
+    if constexpr (std::is_same_v<HypreType, Int32>)
+      return int32_span;
+    else
+      return hypre_span;
+  }
   inline void
   hypreCheck(const char* hypre_func, int error_code)
   {
@@ -90,6 +142,27 @@ namespace
       cout << "HYPRE GET ERROR r=" << r
            << " error_code=" << error_code << " func=" << hypre_func << '\n';
   }
+  /*!
+   * \brief Check the error code of the solve of a Hypre solver.
+   *
+   * The solvers return HYPRE_ERROR_CONV if they have not converged. It is
+   * not considered as an error: it is cleared and false is returned.
+   */
+  inline bool
+  hypreSolveCheck(const char* hypre_func, int error_code)
+  {
+    bool is_converged = true;
+    if (error_code & HYPRE_ERROR_CONV) {
+      is_converged = false;
+      HYPRE_ClearError(HYPRE_ERROR_CONV);
+      error_code &= ~HYPRE_ERROR_CONV;
+    }
+    hypreCheck(hypre_func, error_code);
+    return is_converged;
+  }
+
+  //! Extents of the arrays indexed by the values of the matrix (see CSRFormatView64)
+  using ValueExtents = ExtentsV<Int64, DynExtent>;
 } // namespace
 
 /*---------------------------------------------------------------------------*/
@@ -118,6 +191,9 @@ class HypreDoFLinearSystemImpl
 
   ~HypreDoFLinearSystemImpl()
   {
+    _destroySolver();
+    _destroyVectors();
+    _destroyMatrix();
     info() << "Calling HYPRE_Finalize";
 #if HYPRE_RELEASE_NUMBER >= 21500
     HYPRE_Finalize(); /* must be the last HYPRE function call */
@@ -135,34 +211,37 @@ class HypreDoFLinearSystemImpl
 
  public:
 
-  Int32 indexValue(DoFLocalId row_lid, DoFLocalId column_lid)
+  template <typename IndexType>
+  static IndexType indexValue(CSRFormatViewT<IndexType>& csr_view, DoFLocalId row_lid, DoFLocalId column_lid)
   {
-    auto begin = m_csr_view.rows()[row_lid];
-    auto end = row_lid == m_csr_view.nbRow() - 1 ? m_csr_view.nbColumn() : m_csr_view.row(row_lid + 1);
+    auto begin = csr_view.rows()[row_lid];
+    auto end = row_lid == csr_view.nbRow() - 1 ? csr_view.nbColumn() : csr_view.row(row_lid + 1);
     for (auto i = begin; i < end; ++i)
-      if (m_csr_view.columns()[i] == column_lid)
+      if (csr_view.columns()[i] == column_lid)
         return i;
     return -1;
   }
 
   void matrixAddValue(DoFLocalId row, DoFLocalId column, Real value) override
   {
-    m_csr_view.values()[indexValue(row, column)] += value;
+    _matrixValue(row, column) += value;
   }
 
   void matrixSetValue(DoFLocalId row, DoFLocalId column, Real value) override
   {
-    m_csr_view.values()[indexValue(row, column)] = value;
+    _matrixValue(row, column) = value;
   }
 
   void eliminateRow(DoFLocalId row, Real value) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    m_dof_elimination_info[row] = ELIMINATE_ROW;
+    m_dof_elimination_value[row] = value;
   }
 
   void eliminateRowColumn(DoFLocalId row, Real value) override
   {
-    ARCANE_THROW(NotImplementedException, "");
+    m_dof_elimination_info[row] = ELIMINATE_ROW_COLUMN;
+    m_dof_elimination_value[row] = value;
   }
 
   void solve() override;
@@ -185,12 +264,16 @@ class HypreDoFLinearSystemImpl
   {
     info() << "[Hypre-Info]: Clear values";
     m_csr_view = {};
+    m_csr_view64 = {};
+    m_assembled_csr_view = {};
+    m_assembled_csr_view64 = {};
+    m_use_csr_view64 = false;
     m_dof_forced_info.fill(false);
     m_dof_elimination_info.fill(ELIMINATE_NONE);
     m_dof_elimination_value.fill(0);
   }
 
-  CSRFormatView& getCSRValues() override { return m_csr_view; };
+  CSRFormatView& getCSRValues() override { return m_assembled_csr_view; };
   VariableDoFBool& getForcedInfo() override { return m_dof_forced_info; }
   VariableDoFReal& getForcedValue() override { return m_dof_forced_value; }
   VariableDoFByte& getEliminationInfo() override { return m_dof_elimination_info; }
@@ -198,11 +281,31 @@ class HypreDoFLinearSystemImpl
 
   void setCSRValues(const CSRFormatView& csr_view) override
   {
+    m_assembled_csr_view = csr_view;
     m_csr_view = csr_view;
+    m_use_csr_view64 = false;
   }
 
   bool hasSetCSRValues() const override { return true; }
 
+  /*!
+   * \brief Set the matrix with 64-bit row offsets.
+   *
+   * The row offsets are only used to find the values of a row. Hypre only
+   * receives the number of columns of each row so it needs 64-bit
+   * integers ('--enable-bigint') to store more than 2^31 values per rank.
+   */
+  void setCSRValues64(const CSRFormatView64& csr_view) override
+  {
+    m_assembled_csr_view64 = csr_view;
+    m_csr_view64 = csr_view;
+    m_assembled_csr_view = {};
+    m_csr_view = {};
+    m_use_csr_view64 = true;
+  }
+
+  bool hasSetCSRValues64() const override { return true; }
+
   void setRunner(Runner* r) override { m_runner = r; }
   Runner* runner() const override { return m_runner; }
 
@@ -215,10 +318,54 @@ class HypreDoFLinearSystemImpl
   void setRelTolerance(Real v) { m_rtol = v; }
   void setAbsTolerance(Real v) { m_atol = v; }
   void setAmgThreshold(Real v) { m_amg_threshold = v; }
+  void setReusePolicy(eHypreReusePolicy v) { m_reuse_policy = v; }
+  void setSolverMethod(eHypreSolver v) { m_solver_method = v; }
+  void setPreconditioner(eHyprePreconditioner v) { m_preconditioner = v; }
+  void setKrylovDim(Int32 v) { m_krylov_dim = v; }
+  void setAmgNodal(Int32 v) { m_amg_nodal = v; }
+  void setUseRigidBodyModes(bool v) { m_use_rigid_body_modes = v; }
+
+  void setBlockSize(Int32 block_size) override
+  {
+    if (block_size < 1)
+      ARCANE_FATAL("Invalid block size '{0}'", block_size);
+    m_block_size = block_size;
+  }
+  void setLinearOperator(IDoFLinearOperator*) override
+  {
+    ARCANE_THROW(NotImplementedException, "Matrix-free linear operator");
+  }
+  bool hasSetLinearOperator() const override { return false; }
+  void solveMultipleRhs(VariableDoFArrayReal& rhs, VariableDoFArrayReal& solution) override;
+  bool hasSolveMultipleRhs() const override { return true; }
+  const SolveReport& solveReport() const override { return m_solve_report; }
 
-  void _applyRowElimination();
+  void _selectMatrixValues();
+  void _applyElimination();
   void _applyForcedValuesToLhs();
 
+ private:
+
+  template <typename IndexType>
+  void _selectMatrixValues(CSRFormatViewT<IndexType>& assembled_csr_view, CSRFormatViewT<IndexType>& csr_view);
+  template <typename IndexType>
+  void _applyElimination(CSRFormatViewT<IndexType>& csr_view);
+  template <typename IndexType>
+  void _applyForcedValuesToLhs(CSRFormatViewT<IndexType>& csr_view);
+
+  //! Value (row, column) of the matrix given by setCSRValues() or setCSRValues64()
+  Real& _matrixValue(DoFLocalId row, DoFLocalId column)
+  {
+    if (m_use_csr_view64)
+      return m_assembled_csr_view64.values()[indexValue(m_assembled_csr_view64, row, column)];
+    return m_assembled_csr_view.values()[indexValue(m_assembled_csr_view, row, column)];
+  }
+  Span<const Int32> _csrRowsNbColumn() { return (m_use_csr_view64) ? m_csr_view64.rowsNbColumn() : m_csr_view.rowsNbColumn(); }
+  Span<const Int32> _csrColumns() { return (m_use_csr_view64) ? m_csr_view64.columns() : m_csr_view.columns(); }
+  Int64 _csrStructureVersion() { return (m_use_csr_view64) ? m_csr_view64.structureVersion() : m_csr_view.structureVersion(); }
+  Span<Real> _csrValues() { return (m_use_csr_view64) ? m_csr_view64.values() : m_csr_view.values(); }
+  Int64 _csrRow(Int32 row) { return (m_use_csr_view64) ? m_csr_view64.row(row) : m_csr_view.row(row); }
+
  private:
 
   IItemFamily* m_dof_family = nullptr;
@@ -226,18 +373,34 @@ class HypreDoFLinearSystemImpl
   VariableDoFReal m_dof_variable;
   VariableDoFInt32 m_dof_matrix_indexes;
   VariableDoFInt32 m_dof_matrix_numbering;
-  NumArray<Int32, MDDim1> m_parallel_columns_index;
-  NumArray<Int32, MDDim1> m_parallel_rows_index;
+  //! Global index of each row (all the DoFs) and of the own rows
+  NumArray<HYPRE_BigInt, MDDim1> m_rows_index;
+  NumArray<HYPRE_BigInt, MDDim1> m_parallel_rows_index;
+  //! Global index of the columns of the CSR matrix (see _computeStructureIndexes())
+  NumArray<HYPRE_BigInt, ValueExtents> m_columns_index;
+  //! Number of columns of each row if HYPRE_Int is not Int32
+  NumArray<HYPRE_Int, MDDim1> m_rows_nb_column;
+  //! Copy in device memory of the matrix structure (only used with device memory)
+  NumArray<HYPRE_Int, MDDim1> m_device_rows_nb_column;
+  NumArray<HYPRE_BigInt, MDDim1> m_device_rows_index;
+  NumArray<HYPRE_BigInt, ValueExtents> m_device_columns_index;
   //! Work array to store values of solution vector in parallel
   NumArray<Real, MDDim1> m_result_work_values;
   Runner* m_runner = nullptr;
 
+  //! Matrix given by setCSRValues(), never modified by solve()
+  CSRFormatView m_assembled_csr_view;
+  //! Matrix given by setCSRValues64(), used instead of m_assembled_csr_view if m_use_csr_view64 is true
+  CSRFormatView64 m_assembled_csr_view64;
+  //! Matrices given to Hypre (see _selectMatrixValues())
   CSRFormatView m_csr_view;
+  CSRFormatView64 m_csr_view64;
+  //! Values of the matrix given to Hypre if it has eliminations or forced values
+  NumArray<Real, ValueExtents> m_matrix_values;
+  bool m_use_csr_view64 = false;
 
   VariableDoFBool m_dof_forced_info;
   VariableDoFReal m_dof_forced_value;
-  static constexpr Byte ELIMINATE_NONE = 0;
-  static constexpr Byte ELIMINATE_ROW = 1;
   VariableDoFByte m_dof_elimination_info;
   VariableDoFReal m_dof_elimination_value;
 
@@ -253,9 +416,62 @@ class HypreDoFLinearSystemImpl
   Real m_rtol = 1.0e-7;
   Real m_atol = 0.;
 
+  eHypreReusePolicy m_reuse_policy = eHypreReusePolicy::Rebuild;
+  eHypreSolver m_solver_method = eHypreSolver::PCG;
+  eHyprePreconditioner m_preconditioner = eHyprePreconditioner::AMG;
+  Int32 m_krylov_dim = 30;
+
+  //! Number of DoFs per node. If greater than 1, systems AMG is used
+  Int32 m_block_size = 1;
+  //! Nodal coarsening option for BoomerAMG (0 means unknown-based approach)
+  Int32 m_amg_nodal = 0;
+  bool m_use_rigid_body_modes = false;
+  //! Rotational rigid body modes used as AMG interpolation vectors
+  UniqueArray<HYPRE_IJVector> m_ij_rbm_vectors;
+  UniqueArray<HYPRE_ParVector> m_rbm_vectors;
+
+  // Hypre objects kept between two calls to solve()
+  HYPRE_IJMatrix m_ij_A = nullptr;
+  HYPRE_ParCSRMatrix m_parcsr_A = nullptr;
+  HYPRE_IJVector m_ij_vector_b = nullptr;
+  HYPRE_ParVector m_parvector_b = nullptr;
+  HYPRE_IJVector m_ij_vector_x = nullptr;
+  HYPRE_ParVector m_parvector_x = nullptr;
+  HYPRE_Solver m_solver = nullptr;
+  HYPRE_Solver m_precond = nullptr;
+
+  //! Structure version of the CSR matrix used to create the Hypre matrix
+  Int64 m_matrix_structure_version = -1;
+
+  //! Timestamp of the group of the DoFs used to compute the current matrix numbering
+  Int64 m_numbering_timestamp = -1;
+  //! Structure version of the CSR matrix used to compute the cached column indexes
+  Int64 m_cached_structure_version = -1;
+  bool m_is_device_structure_valid = false;
+
+  //! Total time (in seconds) spent in the setup and in the solve
+  Real m_total_setup_time = 0.0;
+  Real m_total_solve_time = 0.0;
+  Int32 m_nb_solve = 0;
+  SolveReport m_solve_report;
+
  private:
 
   void _computeMatrixNumerotation();
+  void _computeStructureIndexes(RunQueue& queue);
+  template <typename IndexType>
+  void _computeColumnsIndex(RunQueue& queue, CSRFormatViewT<IndexType>& csr_view);
+  void _destroyMatrix();
+  void _destroyVectors();
+  void _destroySolver();
+  void _setAmgParameters(HYPRE_Solver amg);
+  void _setAmgSystemsParameters(HYPRE_Solver amg);
+  void _createRigidBodyModes(MPI_Comm mpi_comm, RunQueue& queue,
+                             eMemoryRessource mem_ressource, bool is_use_device);
+  void _createSolver(MPI_Comm mpi_comm);
+  void _setupSolver();
+  void _doSolve(bool is_keep_solver);
+  bool _solveWithSolver(Int32& nb_iteration, Real& final_residual);
 };
 
 /*---------------------------------------------------------------------------*/
@@ -298,14 +514,436 @@ _computeMatrixNumerotation()
   info() << " nb_own_row=" << nb_own_row << " nb_item=" << m_dof_family->nbItem();
   m_dof_matrix_numbering.synchronize();
 
+  // Hypre may use 64-bit global indexes ('--enable-mixedint' or '--enable-bigint')
+  Span<const Int32> numbering = m_dof_matrix_numbering.asArray();
+  m_rows_index.resize(numbering.size());
+  for (Int32 i = 0, n = numbering.size(); i < n; ++i)
+    m_rows_index[i] = numbering[i];
+
   m_parallel_rows_index.resize(nb_own_row);
   m_result_work_values.resize(nb_own_row);
+
+  // Fill 'm_parallel_rows_index' with only rows we owns
+  if (is_parallel) {
+    ENUMERATE_DOF (idof, own_dofs) {
+      m_parallel_rows_index[idof.index()] = m_dof_matrix_numbering[idof];
+    }
+  }
+  m_numbering_timestamp = all_dofs.timestamp();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the global column indexes of the CSR matrix.
+ *
+ * The columns of the CSR view use local DoF ids. In parallel they are
+ * translated to the global matrix numbering. This is only done when the
+ * structure of the CSR matrix or the DoF numbering has changed.
+ *
+ * In sequential, the columns are given directly to Hypre if HYPRE_BigInt
+ * is Int32. The same holds for the number of columns of the rows and
+ * HYPRE_Int.
+ */
+void HypreDoFLinearSystemImpl::
+_computeStructureIndexes(RunQueue& queue)
+{
+  const bool is_parallel = m_dof_family->parallelMng()->isParallel();
+  if (is_parallel || !std::is_same_v<HYPRE_BigInt, Int32>) {
+    if (m_use_csr_view64)
+      _computeColumnsIndex(queue, m_csr_view64);
+    else
+      _computeColumnsIndex(queue, m_csr_view);
+  }
+
+  Span<const Int32> rows_nb_column = _csrRowsNbColumn();
+  if constexpr (!std::is_same_v<HYPRE_Int, Int32>) {
+    const Int32 nb_row = rows_nb_column.size();
+    m_rows_nb_column.resize(nb_row);
+    auto command = makeCommand(queue);
+    auto out_rows_nb_column = Accelerator::viewOut(command, m_rows_nb_column);
+    command << RUNCOMMAND_LOOP1(iter, nb_row)
+    {
+      auto [i] = iter();
+      out_rows_nb_column[i] = rows_nb_column[i];
+    };
+  }
+
+  m_cached_structure_version = _csrStructureVersion();
+  m_is_device_structure_valid = false;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Fill m_columns_index with the global index of the columns of \a csr_view.
+ *
+ * One thread translates the columns of one row so that the loop does not
+ * depend on the number of values, which may not fit in an Int32.
+ */
+template <typename IndexType> void HypreDoFLinearSystemImpl::
+_computeColumnsIndex(RunQueue& queue, CSRFormatViewT<IndexType>& csr_view)
+{
+  const bool is_parallel = m_dof_family->parallelMng()->isParallel();
+  Span<const IndexType> rows = csr_view.rows();
+  Span<const Int32> rows_nb_column = csr_view.rowsNbColumn();
+  Span<const Int32> columns = csr_view.columns();
+  const Int32 nb_row = csr_view.nbRow();
+  info() << "[Hypre-Info] Computing matrix column indexes nb_column=" << columns.size();
+
+  m_columns_index.resize(columns.size());
+  auto command = makeCommand(queue);
+  auto in_numbering = Accelerator::viewIn(command, m_dof_matrix_numbering);
+  auto out_columns_index = Accelerator::viewOut(command, m_columns_index);
+  command << RUNCOMMAND_LOOP1(iter, nb_row)
+  {
+    auto [row] = iter();
+    for (IndexType i = rows[row], end = rows[row] + rows_nb_column[row]; i < end; ++i) {
+      DoFLocalId lid(columns[i]);
+      // Si lid correspond à une entité nulle, alors la valeur de la matrice
+      // ne sera pas utilisée.
+      HYPRE_BigInt column_index = 0;
+      if (!lid.isNull())
+        column_index = (is_parallel) ? in_numbering[lid] : lid.localId();
+      out_columns_index[i] = column_index;
+    }
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HypreDoFLinearSystemImpl::
+_destroyMatrix()
+{
+  if (m_ij_A)
+    HYPRE_IJMatrixDestroy(m_ij_A);
+  m_ij_A = nullptr;
+  m_parcsr_A = nullptr;
+  m_matrix_structure_version = -1;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HypreDoFLinearSystemImpl::
+_destroyVectors()
+{
+  if (m_ij_vector_b)
+    HYPRE_IJVectorDestroy(m_ij_vector_b);
+  if (m_ij_vector_x)
+    HYPRE_IJVectorDestroy(m_ij_vector_x);
+  m_ij_vector_b = nullptr;
+  m_parvector_b = nullptr;
+  m_ij_vector_x = nullptr;
+  m_parvector_x = nullptr;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HypreDoFLinearSystemImpl::
+_destroySolver()
+{
+  if (m_solver) {
+    switch (m_solver_method) {
+    case eHypreSolver::PCG:
+      HYPRE_ParCSRPCGDestroy(m_solver);
+      break;
+    case eHypreSolver::GMRES:
+      HYPRE_ParCSRGMRESDestroy(m_solver);
+      break;
+    case eHypreSolver::FlexGMRES:
+      HYPRE_ParCSRFlexGMRESDestroy(m_solver);
+      break;
+    case eHypreSolver::BiCGSTAB:
+      HYPRE_ParCSRBiCGSTABDestroy(m_solver);
+      break;
+    case eHypreSolver::AMG:
+      HYPRE_BoomerAMGDestroy(m_solver);
+      break;
+    }
+  }
+  if (m_precond) {
+    switch (m_preconditioner) {
+    case eHyprePreconditioner::AMG:
+      HYPRE_BoomerAMGDestroy(m_precond);
+      break;
+    case eHyprePreconditioner::ILU:
+#if HYPRE_RELEASE_NUMBER >= 21900
+      HYPRE_ILUDestroy(m_precond);
+#endif
+      break;
+    case eHyprePreconditioner::Euclid:
+      HYPRE_EuclidDestroy(m_precond);
+      break;
+    case eHyprePreconditioner::None:
+    case eHyprePreconditioner::Jacobi:
+      break;
+    }
+  }
+  m_solver = nullptr;
+  m_precond = nullptr;
+  // Interpolation vectors are referenced by BoomerAMG and are destroyed after it
+  for (HYPRE_IJVector v : m_ij_rbm_vectors)
+    HYPRE_IJVectorDestroy(v);
+  m_ij_rbm_vectors.clear();
+  m_rbm_vectors.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Set the parameters of a BoomerAMG solver or preconditioner.
+ */
+void HypreDoFLinearSystemImpl::
+_setAmgParameters(HYPRE_Solver amg)
+{
+  info() << "Info Hypre: AmgCoarsener=" << m_amg_coarsener;
+  info() << "Info Hypre: AmgInterpType=" << m_amg_interp_type;
+  info() << "Info Hypre: AmgSmoother=" << m_amg_smoother;
+
+  /* Set Boomer AMG precoditioner Note we try to add only GPU-CPU compatible ones*/
+  HYPRE_BoomerAMGSetPrintLevel(amg, 1); /* print amg solution info */
+  HYPRE_BoomerAMGSetCoarsenType(amg, m_amg_coarsener); /* GPU supported: 8(PMIS) */
+  HYPRE_BoomerAMGSetInterpType(amg, m_amg_interp_type); /* GPU supported: 3, 15, extended+i 6, 14, 18 */
+  //HYPRE_BoomerAMGSetOldDefault(amg);
+  HYPRE_BoomerAMGSetRelaxType(amg, m_amg_smoother); /* GPU support: 3, 4, 6 Sym G.S./Jacobi hybrid, 7, 18, 11, 12*/
+  HYPRE_BoomerAMGSetRelaxOrder(amg, 0); /* must be false */
+  HYPRE_BoomerAMGSetNumSweeps(amg, 1);
+  HYPRE_BoomerAMGSetStrongThreshold(amg, m_amg_threshold); /* amg threshold strength */
+  HYPRE_BoomerAMGSetKeepTranspose(amg, 1); /* for GPU the local interp. trnsp saved*/
+
+  if (m_block_size > 1)
+    _setAmgSystemsParameters(amg);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Set the parameters for systems AMG when there are several DoFs per node.
+ *
+ * The function of each row is the index of the DoF in its node. With
+ * FemDoFsOnNodes, the unique id of a DoF is 'node_uid * block_size + i'.
+ */
+void HypreDoFLinearSystemImpl::
+_setAmgSystemsParameters(HYPRE_Solver amg)
+{
+  info() << "Info Hypre: AmgNumFunctions=" << m_block_size << " AmgNodal=" << m_amg_nodal
+         << " NbRigidBodyModes=" << m_rbm_vectors.size();
+
+  HYPRE_BoomerAMGSetNumFunctions(amg, m_block_size);
+
+  // The array is owned by BoomerAMG and is destroyed with it.
+  HYPRE_Int* dof_func = hypre_CTAlloc(HYPRE_Int, m_nb_own_row, HYPRE_MEMORY_HOST);
+  ENUMERATE_DOF (idof, m_dof_family->allItems().own()) {
+    dof_func[idof.index()] = static_cast<HYPRE_Int>((*idof).uniqueId().asInt64() % m_block_size);
+  }
+  HYPRE_BoomerAMGSetDofFunc(amg, dof_func);
+
+  if (m_amg_nodal > 0)
+    HYPRE_BoomerAMGSetNodal(amg, m_amg_nodal);
+
+  if (!m_rbm_vectors.empty()) {
+    HYPRE_BoomerAMGSetInterpVectors(amg, m_rbm_vectors.size(), m_rbm_vectors.data());
+    HYPRE_BoomerAMGSetInterpVecVariant(amg, 2);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Create the solver and the preconditioner.
+ */
+void HypreDoFLinearSystemImpl::
+_createSolver(MPI_Comm mpi_comm)
+{
+  info() << "Info Hypre: Solver=" << (int)m_solver_method << " Preconditioner=" << (int)m_preconditioner;
+
+  // BoomerAMG used as solver. There is no preconditioner in this case.
+  if (m_solver_method == eHypreSolver::AMG) {
+    hypreCheck("HYPRE_BoomerAMGCreate", HYPRE_BoomerAMGCreate(&m_solver));
+    _setAmgParameters(m_solver);
+    HYPRE_BoomerAMGSetTol(m_solver, m_rtol); /* relative conv. tolerance */
+    HYPRE_BoomerAMGSetMaxIter(m_solver, m_max_iter); /* max iterations */
+    HYPRE_BoomerAMGSetPrintLevel(m_solver, m_verbosity); /* print solve info */
+    HYPRE_BoomerAMGSetLogging(m_solver, 1); /* needed to get run info later */
+    return;
+  }
+
+  HYPRE_PtrToParSolverFcn precond_solve = nullptr;
+  HYPRE_PtrToParSolverFcn precond_setup = nullptr;
+  switch (m_preconditioner) {
+  case eHyprePreconditioner::None:
+    break;
+  case eHyprePreconditioner::AMG:
+    hypreCheck("HYPRE_BoomerAMGCreate", HYPRE_BoomerAMGCreate(&m_precond));
+    _setAmgParameters(m_precond);
+    HYPRE_BoomerAMGSetTol(m_precond, 0.0); /* conv. tolerance zero */
+    HYPRE_BoomerAMGSetMaxIter(m_precond, 1); /* do only one iteration! */
+    precond_solve = HYPRE_BoomerAMGSolve;
+    precond_setup = HYPRE_BoomerAMGSetup;
+    break;
+  case eHyprePreconditioner::Jacobi:
+    // Diagonal scaling does not need a preconditioner object
+    precond_solve = HYPRE_ParCSRDiagScale;
+    precond_setup = HYPRE_ParCSRDiagScaleSetup;
+    break;
+  case eHyprePreconditioner::ILU:
+#if HYPRE_RELEASE_NUMBER >= 21900
+    hypreCheck("HYPRE_ILUCreate", HYPRE_ILUCreate(&m_precond));
+    HYPRE_ILUSetType(m_precond, 0); /* Block-Jacobi ILU(k) */
+    HYPRE_ILUSetLevelOfFill(m_precond, 0);
+    HYPRE_ILUSetTol(m_precond, 0.0);
+    HYPRE_ILUSetMaxIter(m_precond, 1);
+    precond_solve = HYPRE_ILUSolve;
+    precond_setup = HYPRE_ILUSetup;
+#else
+    ARCANE_FATAL("ILU preconditioner requires Hypre 2.19.0 or later");
+#endif
+    break;
+  case eHyprePreconditioner::Euclid:
+    hypreCheck("HYPRE_EuclidCreate", HYPRE_EuclidCreate(mpi_comm, &m_precond));
+    precond_solve = HYPRE_EuclidSolve;
+    precond_setup = HYPRE_EuclidSetup;
+    break;
+  }
+
+  switch (m_solver_method) {
+  case eHypreSolver::PCG:
+    hypreCheck("HYPRE_ParCSRPCGCreate", HYPRE_ParCSRPCGCreate(mpi_comm, &m_solver));
+    /* Set some parameters (See Reference Manual for more parameters) */
+    HYPRE_PCGSetMaxIter(m_solver, m_max_iter); /* max iterations */
+    HYPRE_PCGSetTol(m_solver, m_rtol); /* relative conv. tolerance */
+    HYPRE_PCGSetAbsoluteTol(m_solver, m_atol); /* absolute conv. tolerance */
+    HYPRE_PCGSetTwoNorm(m_solver, 1); /* use the two norm as the stopping criteria */
+    HYPRE_PCGSetPrintLevel(m_solver, m_verbosity); /* print solve info */
+    HYPRE_PCGSetLogging(m_solver, 1); /* needed to get run info later */
+    if (precond_solve)
+      hypreCheck("HYPRE_ParCSRPCGSetPrecond",
+                 HYPRE_ParCSRPCGSetPrecond(m_solver, precond_solve, precond_setup, m_precond));
+    break;
+  case eHypreSolver::GMRES:
+    hypreCheck("HYPRE_ParCSRGMRESCreate", HYPRE_ParCSRGMRESCreate(mpi_comm, &m_solver));
+    HYPRE_GMRESSetMaxIter(m_solver, m_max_iter);
+    HYPRE_GMRESSetTol(m_solver, m_rtol);
+    HYPRE_GMRESSetAbsoluteTol(m_solver, m_atol);
+    HYPRE_GMRESSetKDim(m_solver, m_krylov_dim); /* restart */
+    HYPRE_GMRESSetPrintLevel(m_solver, m_verbosity);
+    HYPRE_GMRESSetLogging(m_solver, 1);
+    if (precond_solve)
+      hypreCheck("HYPRE_ParCSRGMRESSetPrecond",
+                 HYPRE_ParCSRGMRESSetPrecond(m_solver, precond_solve, precond_setup, m_precond));
+    break;
+  case eHypreSolver::FlexGMRES:
+    hypreCheck("HYPRE_ParCSRFlexGMRESCreate", HYPRE_ParCSRFlexGMRESCreate(mpi_comm, &m_solver));
+    HYPRE_FlexGMRESSetMaxIter(m_solver, m_max_iter);
+    HYPRE_FlexGMRESSetTol(m_solver, m_rtol);
+    HYPRE_FlexGMRESSetAbsoluteTol(m_solver, m_atol);
+    HYPRE_FlexGMRESSetKDim(m_solver, m_krylov_dim); /* restart */
+    HYPRE_FlexGMRESSetPrintLevel(m_solver, m_verbosity);
+    HYPRE_FlexGMRESSetLogging(m_solver, 1);
+    if (precond_solve)
+      hypreCheck("HYPRE_ParCSRFlexGMRESSetPrecond",
+                 HYPRE_ParCSRFlexGMRESSetPrecond(m_solver, precond_solve, precond_setup, m_precond));
+    break;
+  case eHypreSolver::BiCGSTAB:
+    hypreCheck("HYPRE_ParCSRBiCGSTABCreate", HYPRE_ParCSRBiCGSTABCreate(mpi_comm, &m_solver));
+    HYPRE_BiCGSTABSetMaxIter(m_solver, m_max_iter);
+    HYPRE_BiCGSTABSetTol(m_solver, m_rtol);
+    HYPRE_BiCGSTABSetAbsoluteTol(m_solver, m_atol);
+    HYPRE_BiCGSTABSetPrintLevel(m_solver, m_verbosity);
+    HYPRE_BiCGSTABSetLogging(m_solver, 1);
+    if (precond_solve)
+      hypreCheck("HYPRE_ParCSRBiCGSTABSetPrecond",
+                 HYPRE_ParCSRBiCGSTABSetPrecond(m_solver, precond_solve, precond_setup, m_precond));
+    break;
+  case eHypreSolver::AMG:
+    break;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void HypreDoFLinearSystemImpl::
+_setupSolver()
+{
+  HYPRE_ParCSRMatrix A = m_parcsr_A;
+  HYPRE_ParVector b = m_parvector_b;
+  HYPRE_ParVector x = m_parvector_x;
+  switch (m_solver_method) {
+  case eHypreSolver::PCG:
+    hypreCheck("HYPRE_ParCSRPCGSetup", HYPRE_ParCSRPCGSetup(m_solver, A, b, x));
+    break;
+  case eHypreSolver::GMRES:
+    hypreCheck("HYPRE_ParCSRGMRESSetup", HYPRE_ParCSRGMRESSetup(m_solver, A, b, x));
+    break;
+  case eHypreSolver::FlexGMRES:
+    hypreCheck("HYPRE_ParCSRFlexGMRESSetup", HYPRE_ParCSRFlexGMRESSetup(m_solver, A, b, x));
+    break;
+  case eHypreSolver::BiCGSTAB:
+    hypreCheck("HYPRE_ParCSRBiCGSTABSetup", HYPRE_ParCSRBiCGSTABSetup(m_solver, A, b, x));
+    break;
+  case eHypreSolver::AMG:
+    hypreCheck("HYPRE_BoomerAMGSetup", HYPRE_BoomerAMGSetup(m_solver, A, b, x));
+    break;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Solve with the current solver.
+ *
+ * Return true if the solver has converged. \a final_residual is the
+ * relative residual norm given by the solver.
+ */
+bool HypreDoFLinearSystemImpl::
+_solveWithSolver(Int32& nb_iteration, Real& final_residual)
+{
+  HYPRE_ParCSRMatrix A = m_parcsr_A;
+  HYPRE_ParVector b = m_parvector_b;
+  HYPRE_ParVector x = m_parvector_x;
+  HYPRE_Int nb_iter = 0;
+  HYPRE_Real residual = 0.0;
+  bool is_converged = true;
+  switch (m_solver_method) {
+  case eHypreSolver::PCG:
+    is_converged = hypreSolveCheck("HYPRE_ParCSRPCGSolve", HYPRE_ParCSRPCGSolve(m_solver, A, b, x));
+    HYPRE_PCGGetNumIterations(m_solver, &nb_iter);
+    HYPRE_PCGGetFinalRelativeResidualNorm(m_solver, &residual);
+    break;
+  case eHypreSolver::GMRES:
+    is_converged = hypreSolveCheck("HYPRE_ParCSRGMRESSolve", HYPRE_ParCSRGMRESSolve(m_solver, A, b, x));
+    HYPRE_GMRESGetNumIterations(m_solver, &nb_iter);
+    HYPRE_GMRESGetFinalRelativeResidualNorm(m_solver, &residual);
+    break;
+  case eHypreSolver::FlexGMRES:
+    is_converged = hypreSolveCheck("HYPRE_ParCSRFlexGMRESSolve", HYPRE_ParCSRFlexGMRESSolve(m_solver, A, b, x));
+    HYPRE_FlexGMRESGetNumIterations(m_solver, &nb_iter);
+    HYPRE_FlexGMRESGetFinalRelativeResidualNorm(m_solver, &residual);
+    break;
+  case eHypreSolver::BiCGSTAB:
+    is_converged = hypreSolveCheck("HYPRE_ParCSRBiCGSTABSolve", HYPRE_ParCSRBiCGSTABSolve(m_solver, A, b, x));
+    HYPRE_BiCGSTABGetNumIterations(m_solver, &nb_iter);
+    HYPRE_BiCGSTABGetFinalRelativeResidualNorm(m_solver, &residual);
+    break;
+  case eHypreSolver::AMG:
+    is_converged = hypreSolveCheck("HYPRE_BoomerAMGSolve", HYPRE_BoomerAMGSolve(m_solver, A, b, x));
+    HYPRE_BoomerAMGGetNumIterations(m_solver, &nb_iter);
+    HYPRE_BoomerAMGGetFinalRelativeResidualNorm(m_solver, &residual);
+    break;
+  }
+  nb_iteration = nb_iter;
+  final_residual = residual;
+  return is_converged;
 }
 
 namespace
 {
-  template <typename DataType>
-  void _doCopy(NumArray<DataType, MDDim1>& num_array, Span<const DataType> rhs, RunQueue* q)
+  template <typename DataType, typename Extents>
+  void _doCopy(NumArray<DataType, Extents>& num_array, Span<const DataType> rhs, RunQueue* q)
   {
     num_array.resize(rhs.size());
     MemoryUtils::copy(num_array.to1DSpan(), rhs, q);
@@ -313,10 +951,189 @@ namespace
 
 } // namespace
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Create the rotational rigid body modes used as AMG interpolation vectors.
+ *
+ * The translations are already handled by systems AMG so only the
+ * rotations are needed: one in 2D and three in 3D. The node of a DoF is
+ * found from the DoF unique id ('node_uid * block_size + i').
+ */
+void HypreDoFLinearSystemImpl::
+_createRigidBodyModes(MPI_Comm mpi_comm, RunQueue& queue,
+                      eMemoryRessource mem_ressource, bool is_use_device)
+{
+  IMesh* mesh = m_dof_family->mesh();
+  const Int32 dimension = mesh->dimension();
+  if (m_block_size != dimension)
+    ARCANE_FATAL("Rigid body modes need one DoF per space dimension (block_size={0} dimension={1})",
+                 m_block_size, dimension);
+
+  DoFGroup own_dofs = m_dof_family->allItems().own();
+  const Int32 nb_own_row = own_dofs.size();
+
+  UniqueArray<Int64> node_uids(nb_own_row);
+  ENUMERATE_DOF (idof, own_dofs) {
+    node_uids[idof.index()] = (*idof).uniqueId().asInt64() / m_block_size;
+  }
+  UniqueArray<Int32> node_lids(nb_own_row);
+  mesh->nodeFamily()->itemsUniqueIdToLocalId(node_lids, node_uids, true);
+
+  VariableNodeReal3& node_coord = mesh->nodesCoordinates();
+  const Int32 nb_vector = (dimension == 2) ? 1 : 3;
+
+  NumArray<HYPRE_BigInt, MDDim1> rows(nb_own_row);
+  NumArray<Real, MDDim2> values(nb_vector, nb_own_row);
+  ENUMERATE_DOF (idof, own_dofs) {
+    const Int32 i = idof.index();
+    const Int32 component = static_cast<Int32>((*idof).uniqueId().asInt64() % m_block_size);
+    const Real3 x = node_coord[NodeLocalId(node_lids[i])];
+    rows[i] = m_first_own_row + i;
+    // Rotation around the z axis: (-y, x, 0)
+    values(0, i) = (component == 0) ? -x.y : ((component == 1) ? x.x : 0.0);
+    if (nb_vector == 3) {
+      // Rotation around the x axis: (0, -z, y)
+      values(1, i) = (component == 0) ? 0.0 : ((component == 1) ? -x.z : x.y);
+      // Rotation around the y axis: (z, 0, -x)
+      values(2, i) = (component == 0) ? x.z : ((component == 1) ? 0.0 : -x.x);
+    }
+  }
+
+  const HYPRE_BigInt first_row = m_first_own_row;
+  const HYPRE_BigInt last_row = m_first_own_row + m_nb_own_row - 1;
+  NumArray<HYPRE_BigInt, MDDim1> device_rows(mem_ressource);
+  NumArray<Real, MDDim1> device_values(mem_ressource);
+  const HYPRE_BigInt* rows_data = rows.to1DSpan().data();
+  if (is_use_device) {
+    _doCopy(device_rows, Span<const HYPRE_BigInt>(rows.to1DSpan()), &queue);
+    rows_data = device_rows.to1DSpan().data();
+  }
+
+  for (Int32 v = 0; v < nb_vector; ++v) {
+    Span<const Real> vector_values = values.to1DSpan().subSpan(v * nb_own_row, nb_own_row);
+    const Real* values_data = vector_values.data();
+    if (is_use_device) {
+      _doCopy(device_values, vector_values, &queue);
+      queue.barrier();
+      values_data = device_values.to1DSpan().data();
+    }
+    HYPRE_IJVector ij_vector = nullptr;
+    hypreCheck("IJVectorCreate", HYPRE_IJVectorCreate(mpi_comm, first_row, last_row, &ij_vector));
+    hypreCheck("IJVectorSetObjectType", HYPRE_IJVectorSetObjectType(ij_vector, HYPRE_PARCSR));
+    HYPRE_IJVectorInitialize(ij_vector);
+    hypreCheck("HYPRE_IJVectorSetValues",
+               HYPRE_IJVectorSetValues(ij_vector, nb_own_row, rows_data, values_data));
+    hypreCheck("HYPRE_IJVectorAssemble", HYPRE_IJVectorAssemble(ij_vector));
+    HYPRE_ParVector par_vector = nullptr;
+    HYPRE_IJVectorGetObject(ij_vector, (void**)&par_vector);
+    m_ij_rbm_vectors.add(ij_vector);
+    m_rbm_vectors.add(par_vector);
+  }
+  info() << "[Hypre-Info] Created " << nb_vector << " rigid body modes";
+}
+
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
-void HypreDoFLinearSystemImpl::_applyRowElimination()
+/*!
+ * \brief Select the values of the matrix given to Hypre.
+ *
+ * The view given by setCSRValues() may share its values with the assembled
+ * matrix (see BSRMatrix::toCsr()). If some DoFs are eliminated or forced,
+ * the values are copied so that the eliminations do not change the
+ * assembled matrix, which can then be solved again. Otherwise, the values
+ * of the view are given to Hypre without copy.
+ */
+void HypreDoFLinearSystemImpl::_selectMatrixValues()
+{
+  // Ghost DoFs have to know if they are eliminated because they may
+  // be used as column in our rows.
+  if (m_dof_family->parallelMng()->isParallel()) {
+    m_dof_elimination_info.synchronize();
+    m_dof_elimination_value.synchronize();
+  }
+
+  if (m_use_csr_view64)
+    _selectMatrixValues(m_assembled_csr_view64, m_csr_view64);
+  else
+    _selectMatrixValues(m_assembled_csr_view, m_csr_view);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template <typename IndexType> void HypreDoFLinearSystemImpl::
+_selectMatrixValues(CSRFormatViewT<IndexType>& assembled_csr_view, CSRFormatViewT<IndexType>& csr_view)
+{
+  auto nb_dof = m_dof_family->nbItem();
+  RunQueue queue = makeQueue(m_runner);
+
+  Int32 nb_modified_row = 0;
+  {
+    auto command = makeCommand(queue);
+    Accelerator::ReducerSum2<Int32> reducer(command);
+    auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+    auto in_forced_info = Accelerator::viewIn(command, m_dof_forced_info);
+    command << RUNCOMMAND_LOOP1(iter, nb_dof, reducer)
+    {
+      auto [i] = iter();
+      DoFLocalId dof_id(i);
+      if (in_elimination_info[dof_id] != ELIMINATE_NONE || in_forced_info[dof_id])
+        reducer.combine(1);
+    };
+    nb_modified_row = reducer.reducedValue();
+  }
+
+  csr_view = assembled_csr_view;
+  if (nb_modified_row == 0)
+    return;
+
+  Span<const Real> in_values = assembled_csr_view.values();
+  Int64 nb_value = in_values.size();
+  m_matrix_values.resize(nb_value);
+  {
+    auto command = makeCommand(queue);
+    Span<Real> out_values = m_matrix_values.to1DSpan();
+    command << RUNCOMMAND_LOOP1(iter, nb_value)
+    {
+      auto [i] = iter();
+      out_values[i] = in_values[i];
+    };
+  }
+  csr_view = CSRFormatViewT<IndexType>(assembled_csr_view.rows(), assembled_csr_view.rowsNbColumn(),
+                                       assembled_csr_view.columns(), m_matrix_values.to1DSpan());
+  csr_view.setStructureVersion(assembled_csr_view.structureVersion());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Apply row and row-column elimination to the CSR matrix.
+ *
+ * For an eliminated row \a r, the row becomes the identity row and the
+ * RHS is set to the elimination value.
+ *
+ * For a row-column elimination, the values of the column \a r in the other
+ * rows are also removed and moved to the RHS (b_i -= a_ir * value) so that
+ * the matrix stays symmetric.
+ *
+ * Each thread only modifies the values of its row so no atomic operation
+ * is needed.
+ */
+void HypreDoFLinearSystemImpl::_applyElimination()
+{
+  if (m_use_csr_view64)
+    _applyElimination(m_csr_view64);
+  else
+    _applyElimination(m_csr_view);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template <typename IndexType> void HypreDoFLinearSystemImpl::
+_applyElimination(CSRFormatViewT<IndexType>& csr_view)
 {
   auto nb_dof = m_dof_family->nbItem();
 
@@ -326,11 +1143,11 @@ void HypreDoFLinearSystemImpl::_applyRowElimination()
   auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
   auto in_elimination_value = Accelerator::viewIn(command, m_dof_elimination_value);
 
-  auto csr_row_size = m_csr_view.nbRow();
-  auto csr_columns_size = m_csr_view.nbColumn();
-  auto in_csr_row = m_csr_view.rows();
-  auto in_csr_columns = m_csr_view.columns();
-  auto in_out_csr_values = m_csr_view.values();
+  auto csr_row_size = csr_view.nbRow();
+  auto csr_columns_size = csr_view.nbColumn();
+  auto in_csr_row = csr_view.rows();
+  auto in_csr_columns = csr_view.columns();
+  auto in_out_csr_values = csr_view.values();
 
   auto in_out_rhs_variable = Accelerator::viewInOut(command, m_rhs_variable);
 
@@ -339,14 +1156,27 @@ void HypreDoFLinearSystemImpl::_applyRowElimination()
     auto [thread_id] = iter();
     DoFLocalId dof_id(thread_id);
     auto elimination_info = in_elimination_info[dof_id];
-    if (elimination_info == ELIMINATE_ROW) {
-      auto begin = in_csr_row[dof_id];
-      auto end = dof_id == csr_row_size - 1 ? csr_columns_size : in_csr_row[dof_id + 1];
+    auto begin = in_csr_row[dof_id];
+    auto end = dof_id == csr_row_size - 1 ? csr_columns_size : in_csr_row[dof_id + 1];
+    if (elimination_info == ELIMINATE_ROW || elimination_info == ELIMINATE_ROW_COLUMN) {
       auto elimination_value = in_elimination_value[dof_id];
-      for (Int32 i = begin; i < end; ++i)
+      for (IndexType i = begin; i < end; ++i)
         in_out_csr_values[i] = in_csr_columns[i] == dof_id ? 1 : 0;
       in_out_rhs_variable[dof_id] = elimination_value;
     }
+    else {
+      Real rhs_value = in_out_rhs_variable[dof_id];
+      for (IndexType i = begin; i < end; ++i) {
+        DoFLocalId column_id(in_csr_columns[i]);
+        if (column_id.isNull() || column_id == dof_id)
+          continue;
+        if (in_elimination_info[column_id] == ELIMINATE_ROW_COLUMN) {
+          rhs_value -= in_out_csr_values[i] * in_elimination_value[column_id];
+          in_out_csr_values[i] = 0;
+        }
+      }
+      in_out_rhs_variable[dof_id] = rhs_value;
+    }
   };
 }
 
@@ -354,6 +1184,18 @@ void HypreDoFLinearSystemImpl::_applyRowElimination()
 /*---------------------------------------------------------------------------*/
 
 void HypreDoFLinearSystemImpl::_applyForcedValuesToLhs()
+{
+  if (m_use_csr_view64)
+    _applyForcedValuesToLhs(m_csr_view64);
+  else
+    _applyForcedValuesToLhs(m_csr_view);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+template <typename IndexType> void HypreDoFLinearSystemImpl::
+_applyForcedValuesToLhs(CSRFormatViewT<IndexType>& csr_view)
 {
   auto nb_dof = m_dof_family->nbItem();
 
@@ -363,11 +1205,11 @@ void HypreDoFLinearSystemImpl::_applyForcedValuesToLhs()
   auto in_out_forced_info = Accelerator::viewInOut(command, m_dof_forced_info);
   auto in_out_forced_value = Accelerator::viewInOut(command, m_dof_forced_value);
 
-  auto csr_row_size = m_csr_view.nbRow();
-  auto csr_columns_size = m_csr_view.nbColumn();
-  auto in_csr_row = m_csr_view.rows();
-  auto in_csr_columns = m_csr_view.columns();
-  auto in_out_csr_values = m_csr_view.values();
+  auto csr_row_size = csr_view.nbRow();
+  auto csr_columns_size = csr_view.nbColumn();
+  auto in_csr_row = csr_view.rows();
+  auto in_csr_columns = csr_view.columns();
+  auto in_out_csr_values = csr_view.values();
 
   command << RUNCOMMAND_LOOP1(iter, nb_dof)
   {
@@ -376,7 +1218,9 @@ void HypreDoFLinearSystemImpl::_applyForcedValuesToLhs()
       auto begin = in_csr_row[dof_id];
       auto end = dof_id == csr_row_size - 1 ? csr_columns_size : in_csr_row[dof_id + 1];
       auto index = FemUtils::Gpu::Csr::findIndex(begin, end, dof_id, in_csr_columns);
-      in_out_csr_values[index] = in_out_forced_value[(DoFLocalId)dof_id];
+      // The rows of ghost DoFs may be empty (see BSRFormat)
+      if (index >= 0)
+        in_out_csr_values[index] = in_out_forced_value[(DoFLocalId)dof_id];
     }
   };
 }
@@ -387,9 +1231,94 @@ void HypreDoFLinearSystemImpl::_applyForcedValuesToLhs()
 void HypreDoFLinearSystemImpl::
 solve()
 {
-  _applyRowElimination();
+  _selectMatrixValues();
+  _applyElimination();
   _applyForcedValuesToLhs();
+  _doSolve(false);
+}
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Solve the system for all the columns of \a rhs.
+ *
+ * The eliminations are applied to a null RHS to get their contribution,
+ * which is the same for all the RHS. The first solve builds the matrix and
+ * the solver as solve() does. The following ones keep them and only update
+ * the vectors (as with the ReuseAll policy).
+ */
+void HypreDoFLinearSystemImpl::
+solveMultipleRhs(VariableDoFArrayReal& rhs, VariableDoFArrayReal& solution)
+{
+  const Int32 nb_rhs = rhs.arraySize();
+  const Int32 nb_dof = m_dof_family->nbItem();
+
+  m_rhs_variable.fill(0.0);
+  _selectMatrixValues();
+  _applyElimination();
+  _applyForcedValuesToLhs();
+
+  NumArray<Real, MDDim1> rhs_correction(nb_dof);
+  {
+    RunQueue queue = makeQueue(m_runner);
+    auto command = makeCommand(queue);
+    auto in_rhs_variable = Accelerator::viewIn(command, m_rhs_variable);
+    auto out_rhs_correction = Accelerator::viewOut(command, rhs_correction);
+    command << RUNCOMMAND_LOOP1(iter, nb_dof)
+    {
+      auto [i] = iter();
+      out_rhs_correction[i] = in_rhs_variable[DoFLocalId(i)];
+    };
+  }
+
+  SolveReport report;
+  for (Int32 k = 0; k < nb_rhs; ++k) {
+    {
+      RunQueue queue = makeQueue(m_runner);
+      auto command = makeCommand(queue);
+      auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+      auto in_rhs = Accelerator::viewIn(command, rhs);
+      auto in_solution = Accelerator::viewIn(command, solution);
+      auto in_rhs_correction = Accelerator::viewIn(command, rhs_correction);
+      auto out_rhs_variable = Accelerator::viewOut(command, m_rhs_variable);
+      auto out_dof_variable = Accelerator::viewOut(command, m_dof_variable);
+      command << RUNCOMMAND_LOOP1(iter, nb_dof)
+      {
+        auto [i] = iter();
+        DoFLocalId dof_id(i);
+        Real value = in_rhs_correction[i];
+        if (in_elimination_info[dof_id] == ELIMINATE_NONE)
+          value += in_rhs[dof_id][k];
+        out_rhs_variable[dof_id] = value;
+        out_dof_variable[dof_id] = in_solution[dof_id][k];
+      };
+    }
+
+    _doSolve(k > 0);
+
+    ENUMERATE_ (DoF, idof, m_dof_family->allItems().own()) {
+      solution[idof][k] = m_dof_variable[idof];
+    }
+    if (k == 0)
+      report = m_solve_report;
+    else
+      report.merge(m_solve_report);
+  }
+  m_solve_report = report;
+  m_solve_report.nb_rhs = nb_rhs;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Solve the system with the current matrix and RHS.
+ *
+ * If \a is_keep_solver is true, the matrix and the solver created by a
+ * previous call are kept whatever the reuse policy is.
+ */
+void HypreDoFLinearSystemImpl::
+_doSolve(bool is_keep_solver)
+{
 #if HYPRE_RELEASE_NUMBER >= 22700
   HYPRE_MemoryLocation hypre_memory = HYPRE_MEMORY_HOST;
   HYPRE_ExecutionPolicy hypre_exec_policy = HYPRE_EXEC_HOST;
@@ -407,8 +1336,21 @@ solve()
   const Int32 nb_rank = pm->commSize();
   const Int32 my_rank = pm->commRank();
 
-  // TODO: A ne faire qu'un fois sauf si les DoFs évoluent
-  _computeMatrixNumerotation();
+  // The numbering is only computed again if the group of the DoFs has
+  // changed since the last computation (its timestamp is incremented at each
+  // modification). This has to be a collective decision because the
+  // computation of the numbering uses collective operations.
+  // If the solver is kept, nothing has changed since the previous call
+  // (see solveMultipleRhs()) so there is nothing to check.
+  Int32 numbering_changed_flag = 0;
+  if (!is_keep_solver) {
+    numbering_changed_flag = (m_numbering_timestamp != m_dof_family->allItems().timestamp()) ? 1 : 0;
+    if (is_parallel)
+      numbering_changed_flag = pm->reduce(Parallel::ReduceMax, numbering_changed_flag);
+  }
+  const bool is_numbering_changed = (numbering_changed_flag != 0);
+  if (is_numbering_changed)
+    _computeMatrixNumerotation();
 
   bool is_use_device = false;
   if (m_runner) {
@@ -428,6 +1370,10 @@ solve()
   }
 #endif
 
+  // Euclid only runs on the host
+  if (is_use_device && m_solver_method != eHypreSolver::AMG && m_preconditioner == eHyprePreconditioner::Euclid)
+    ARCANE_FATAL("Preconditioner 'euclid' of HypreLinearSystem is not available on accelerator (use 'ilu' instead)");
+
 #if HYPRE_RELEASE_NUMBER >= 22700
   if (is_use_device) {
     m_runner->setAsCurrentDevice();
@@ -465,75 +1411,101 @@ solve()
 
   /* setup IJ matrix A */
 
-  HYPRE_IJMatrix ij_A = nullptr;
-  HYPRE_ParCSRMatrix parcsr_A = nullptr;
-
   const bool do_debug_print = false;
   const bool do_dump_matrix = false;
 
-  Span<const Int32> rows_index_span = m_dof_matrix_numbering.asArray();
-  const Int32 nb_local_row = rows_index_span.size();
+  Span<const HYPRE_BigInt> rows_index_span = m_rows_index.to1DSpan();
+  const Int32 nb_local_row = static_cast<Int32>(rows_index_span.size());
+
+  // Only the number of columns of the rows, the columns and the values
+  // are given to Hypre so the row offsets of the CSR view are not used.
+  Span<const Int32> csr_rows_nb_column = _csrRowsNbColumn();
+  Span<const Int32> csr_columns = _csrColumns();
 
   if (do_debug_print) {
     info() << "ROWS_INDEX=" << rows_index_span;
-    info() << "ROWS=" << m_csr_view.rows();
-    info() << "ROWS_NB_COLUMNS=" << m_csr_view.rowsNbColumn();
-    info() << "COLUMNS=" << m_csr_view.columns();
-    info() << "VALUE=" << m_csr_view.values();
+    info() << "ROWS_NB_COLUMNS=" << csr_rows_nb_column;
+    info() << "COLUMNS=" << csr_columns;
+    info() << "VALUE=" << _csrValues();
+  }
+
+  const HYPRE_BigInt first_row = m_first_own_row;
+  const HYPRE_BigInt last_row = m_first_own_row + m_nb_own_row - 1;
+
+  // Check if we can reuse the Hypre objects created during the previous
+  // call to solve(). This is only possible if the matrix structure has not
+  // changed.
+  // The structure is identified by the version given by the producer of the
+  // CSR view. A view without version is always a new structure. As for the
+  // numbering, the decision is collective.
+  // If the solver is kept, the matrix has not changed since the previous
+  // call so the structure is the same, even for a view without version.
+  const Int64 nb_value = _csrValues().size();
+  const Int64 structure_version = _csrStructureVersion();
+  Int32 structure_changed_flag = 0;
+  Int32 same_structure_flag = 1;
+  if (!is_keep_solver) {
+    structure_changed_flag = (is_numbering_changed || structure_version < 0 || m_cached_structure_version != structure_version) ? 1 : 0;
+    if (is_parallel)
+      structure_changed_flag = pm->reduce(Parallel::ReduceMax, structure_changed_flag);
+    same_structure_flag = (m_ij_A && structure_changed_flag == 0 && m_matrix_structure_version == structure_version) ? 1 : 0;
+    if (is_parallel)
+      same_structure_flag = pm->reduce(Parallel::ReduceMin, same_structure_flag);
+  }
+  const bool is_structure_changed = (structure_changed_flag != 0);
+  const bool is_same_structure = (same_structure_flag != 0);
+  if (is_keep_solver && !m_ij_A)
+    ARCANE_FATAL("Can not keep the Hypre solver because it has not been created");
+  const bool do_rebuild = !is_keep_solver && ((m_reuse_policy == eHypreReusePolicy::Rebuild) || !is_same_structure);
+  const bool do_update_matrix = !is_keep_solver && (do_rebuild || (m_reuse_policy == eHypreReusePolicy::ReuseSetup));
+  info() << "[Hypre-Info] ReusePolicy=" << (int)m_reuse_policy << " rebuild=" << do_rebuild
+         << " update_matrix=" << do_update_matrix;
+
+  if (do_rebuild) {
+    _destroySolver();
+    _destroyMatrix();
   }
 
-  const int first_row = m_first_own_row;
-  const int last_row = m_first_own_row + m_nb_own_row - 1;
+  Real setup_time = 0.0;
+  Real matrix_build_time = 0.0;
+  Int64 nb_transferred_byte = 0;
+  Real m1 = platform::getRealTime();
 
-  info() << "CreateMatrix first_row=" << first_row << " last_row " << last_row;
-  HYPRE_IJMatrixCreate(mpi_comm, first_row, last_row, first_row, last_row, &ij_A);
+  if (do_rebuild) {
+    info() << "CreateMatrix first_row=" << first_row << " last_row " << last_row;
+    HYPRE_IJMatrixCreate(mpi_comm, first_row, last_row, first_row, last_row, &m_ij_A);
+    HYPRE_IJMatrixSetObjectType(m_ij_A, HYPRE_PARCSR);
+    m_matrix_structure_version = structure_version;
+  }
 
-  int* rows_nb_column_data = const_cast<int*>(m_csr_view.rowsNbColumn().data());
+  RunQueue q = makeQueue(m_runner);
 
-  Real m1 = platform::getRealTime();
-  HYPRE_IJMatrixSetObjectType(ij_A, HYPRE_PARCSR);
-#if HYPRE_RELEASE_NUMBER >= 22700
-  HYPRE_IJMatrixInitialize_v2(ij_A, hypre_memory);
-#else
-  HYPRE_IJMatrixInitialize(ij_A);
-#endif
-  // m_csr_view.columns() use matrix coordinates local to sub-domain
+  // The columns of the CSR view use matrix coordinates local to sub-domain
   // We need to translate them to global matrix coordinates
-  Span<const Int32> columns_index_span = m_csr_view.columns();
-  if (is_parallel) {
-    // TODO: Faire sur accélérateur et ne faire qu'une fois si la structure
-    // ne change pas.
-    Int64 nb_column = columns_index_span.size();
-    m_parallel_columns_index.resize(nb_column);
-    for (Int64 i = 0; i < nb_column; ++i) {
-      DoFLocalId lid(columns_index_span[i]);
-      //info() << "I=" << i << " index=" << columns_index_span[i];
-      // Si lid correspond à une entité nulle, alors la valeur de la matrice
-      // ne sera pas utilisée.
-      if (!lid.isNull())
-        m_parallel_columns_index[i] = m_dof_matrix_numbering[lid];
-      else
-        m_parallel_columns_index[i] = 0;
-    }
-    columns_index_span = m_parallel_columns_index.to1DSpan();
-  }
+  if (is_structure_changed)
+    _computeStructureIndexes(q);
+  Span<const HYPRE_BigInt> columns_index_span = m_columns_index.to1DSpan();
+  if (!is_parallel)
+    columns_index_span = _selectHypreSpan(csr_columns, columns_index_span);
+  Span<const HYPRE_Int> rows_nb_column_span = _selectHypreSpan(csr_rows_nb_column, Span<const HYPRE_Int>(m_rows_nb_column.to1DSpan()));
+  HYPRE_Int* rows_nb_column_data = const_cast<HYPRE_Int*>(rows_nb_column_span.data());
 
   if (do_debug_print) {
     info() << "FINAL_COLUMNS=" << columns_index_span;
-    info() << "NbValue=" << m_csr_view.nbValue();
+    info() << "NbValue=" << nb_value;
   }
 
-  Span<const Real> matrix_values = m_csr_view.values();
+  Span<const Real> matrix_values = _csrValues();
 
   if (do_debug_print) {
     ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
       DoF dof = *idof;
-      Int32 nb_col = m_csr_view.rowsNbColumn()[idof.index()];
-      Int32 row_csr_index = m_csr_view.rows()[idof.index()];
+      Int32 nb_col = csr_rows_nb_column[idof.index()];
+      Int64 row_csr_index = _csrRow(idof.index());
       info() << "DoF dof=" << ItemPrinter(dof) << " nb_col=" << nb_col << " row_csr_index=" << row_csr_index
              << " global_row=" << rows_index_span[idof.index()];
       for (Int32 i = 0; i < nb_col; ++i) {
-        Int32 col_index = m_csr_view.columns()[row_csr_index + i];
+        Int32 col_index = csr_columns[row_csr_index + i];
         if (col_index >= 0)
           info() << "COL=" << col_index
                  << " T_COL=" << m_dof_matrix_numbering[DoFLocalId(col_index)]
@@ -546,36 +1518,17 @@ solve()
     }
   }
 
-  if (is_parallel) {
-    // Fill 'm_parallel_rows_index' with only rows we owns
-    // NOTE: This is only needed if matrix structure has changed.
-    Int32 index = 0;
-    ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
-      DoF dof = *idof;
-      if (!dof.isOwn())
-        continue;
-      Int32 nb_col = m_csr_view.rowsNbColumn()[idof.index()];
-      m_parallel_rows_index[index] = rows_index_span[idof.index()];
-      ++index;
-    }
-  }
-
   // Prefetch the memory to the Device to make sure we are using
   // Device memory and not host memory when using UVM
-  NumArray<Int32, MDDim1> na_rows_nb_column_data(mem_ressource);
-  NumArray<Int32, MDDim1> na_rows_index(mem_ressource);
-  NumArray<Int32, MDDim1> na_columns_index(mem_ressource);
-  NumArray<Real, MDDim1> na_matrix_values(mem_ressource);
+  NumArray<Real, ValueExtents> na_matrix_values(mem_ressource);
 
-  const Int32* rows_index_data = rows_index_span.data();
-  const Int32* columns_index_data = columns_index_span.data();
+  const HYPRE_BigInt* rows_index_data = rows_index_span.data();
+  const HYPRE_BigInt* columns_index_data = columns_index_span.data();
   const Real* matrix_values_data = matrix_values.data();
 
-  RunQueue q = makeQueue(m_runner);
-
   if (is_use_device) {
     info() << "Prefetching memory for 'Hypre'";
-    q.prefetchMemory(Accelerator::MemoryPrefetchArgs(ConstMemoryView(m_csr_view.rowsNbColumn())).addAsync());
+    q.prefetchMemory(Accelerator::MemoryPrefetchArgs(ConstMemoryView(rows_nb_column_span)).addAsync());
     q.prefetchMemory(Accelerator::MemoryPrefetchArgs(ConstMemoryView(rows_index_span)).addAsync());
     q.prefetchMemory(Accelerator::MemoryPrefetchArgs(ConstMemoryView(columns_index_span)).addAsync());
     q.prefetchMemory(Accelerator::MemoryPrefetchArgs(ConstMemoryView(matrix_values)).addAsync());
@@ -583,34 +1536,58 @@ solve()
     VariableUtils::prefetchVariableAsync(m_rhs_variable, &q);
     VariableUtils::prefetchVariableAsync(m_dof_variable, &q);
   }
-  Span<const Int32> rows_nb_column_span = m_csr_view.rowsNbColumn();
   if (is_use_device && is_use_device_memory) {
-    _doCopy(na_rows_nb_column_data, rows_nb_column_span, &q);
-    _doCopy(na_rows_index, rows_index_span, &q);
-    _doCopy(na_columns_index, columns_index_span, &q);
-    _doCopy(na_matrix_values, matrix_values, &q);
-
-    rows_nb_column_data = na_rows_nb_column_data.to1DSpan().data();
-    rows_index_data = na_rows_index.to1DSpan().data();
-    columns_index_data = na_columns_index.to1DSpan().data();
+    // The structure of the matrix is only copied if it has changed
+    if (is_structure_changed || !m_is_device_structure_valid) {
+      m_device_rows_nb_column = NumArray<HYPRE_Int, MDDim1>(mem_ressource);
+      m_device_rows_index = NumArray<HYPRE_BigInt, MDDim1>(mem_ressource);
+      m_device_columns_index = NumArray<HYPRE_BigInt, ValueExtents>(mem_ressource);
+      _doCopy(m_device_rows_nb_column, rows_nb_column_span, &q);
+      _doCopy(m_device_rows_index, rows_index_span, &q);
+      _doCopy(m_device_columns_index, columns_index_span, &q);
+      m_is_device_structure_valid = true;
+      nb_transferred_byte += rows_nb_column_span.size() * sizeof(HYPRE_Int);
+      nb_transferred_byte += (rows_index_span.size() + columns_index_span.size()) * sizeof(HYPRE_BigInt);
+    }
+    // Values are only used if the Hypre matrix is updated
+    if (do_update_matrix) {
+      _doCopy(na_matrix_values, matrix_values, &q);
+      nb_transferred_byte += matrix_values.size() * sizeof(Real);
+    }
+
+    rows_nb_column_data = m_device_rows_nb_column.to1DSpan().data();
+    rows_index_data = m_device_rows_index.to1DSpan().data();
+    columns_index_data = m_device_columns_index.to1DSpan().data();
     matrix_values_data = na_matrix_values.to1DSpan().data();
 
     q.barrier();
   }
 
-  {
+  if (do_update_matrix) {
     Timer::Action ta1(tstat, "HypreLinearSystemBuildMatrix");
+    // If the matrix already exists, HYPRE_IJMatrixInitialize() allows
+    // to change the values without changing the structure. In this case
+    // the pointer to the ParCSR matrix does not change and the AMG
+    // hierarchy built with it remains valid.
+#if HYPRE_RELEASE_NUMBER >= 22700
+    HYPRE_IJMatrixInitialize_v2(m_ij_A, hypre_memory);
+#else
+    HYPRE_IJMatrixInitialize(m_ij_A);
+#endif
     /* GPU pointers; efficient in large chunks */
-    HYPRE_IJMatrixSetValues(ij_A,
+    HYPRE_IJMatrixSetValues(m_ij_A,
                             nb_local_row,
                             rows_nb_column_data,
                             rows_index_data,
                             columns_index_data,
                             matrix_values_data);
 
-    HYPRE_IJMatrixAssemble(ij_A);
-    HYPRE_IJMatrixGetObject(ij_A, (void**)&parcsr_A);
+    HYPRE_IJMatrixAssemble(m_ij_A);
+    HYPRE_IJMatrixGetObject(m_ij_A, (void**)&m_parcsr_A);
     Real m2 = platform::getRealTime();
+    matrix_build_time = m2 - m1;
+    // Values and indexes copied by Hypre in its own matrix
+    nb_transferred_byte += matrix_values.size() * (sizeof(Real) + sizeof(HYPRE_BigInt)) + nb_local_row * (sizeof(HYPRE_Int) + sizeof(HYPRE_BigInt));
     info() << "Time to create matrix=" << (m2 - m1);
   }
 
@@ -618,30 +1595,33 @@ solve()
 
   if (do_dump_matrix) {
     String file_name = String("dumpA.") + String::fromNumber(my_rank) + ".txt";
-    HYPRE_IJMatrixPrint(ij_A, file_name.localstr());
+    HYPRE_IJMatrixPrint(m_ij_A, file_name.localstr());
     pm->traceMng()->flush();
     pm->barrier();
   }
 
-  HYPRE_IJVector ij_vector_b = nullptr;
-  HYPRE_ParVector parvector_b = nullptr;
-  HYPRE_IJVector ij_vector_x = nullptr;
-  HYPRE_ParVector parvector_x = nullptr;
+  if (do_rebuild)
+    _destroyVectors();
 
-  hypreCheck("IJVectorCreate", HYPRE_IJVectorCreate(mpi_comm, first_row, last_row, &ij_vector_b));
-  hypreCheck("IJVectorSetObjectType", HYPRE_IJVectorSetObjectType(ij_vector_b, HYPRE_PARCSR));
+  Real v1 = platform::getRealTime();
+  if (!m_ij_vector_b) {
+    hypreCheck("IJVectorCreate", HYPRE_IJVectorCreate(mpi_comm, first_row, last_row, &m_ij_vector_b));
+    hypreCheck("IJVectorSetObjectType", HYPRE_IJVectorSetObjectType(m_ij_vector_b, HYPRE_PARCSR));
+  }
 #if HYPRE_RELEASE_NUMBER >= 22700
-  HYPRE_IJVectorInitialize_v2(ij_vector_b, hypre_memory);
+  HYPRE_IJVectorInitialize_v2(m_ij_vector_b, hypre_memory);
 #else
-  HYPRE_IJVectorInitialize(ij_vector_b);
+  HYPRE_IJVectorInitialize(m_ij_vector_b);
 #endif
 
-  hypreCheck("IJVectorCreate", HYPRE_IJVectorCreate(mpi_comm, first_row, last_row, &ij_vector_x));
-  hypreCheck("IJVectorSetObjectType", HYPRE_IJVectorSetObjectType(ij_vector_x, HYPRE_PARCSR));
+  if (!m_ij_vector_x) {
+    hypreCheck("IJVectorCreate", HYPRE_IJVectorCreate(mpi_comm, first_row, last_row, &m_ij_vector_x));
+    hypreCheck("IJVectorSetObjectType", HYPRE_IJVectorSetObjectType(m_ij_vector_x, HYPRE_PARCSR));
+  }
 #if HYPRE_RELEASE_NUMBER >= 22700
-  HYPRE_IJVectorInitialize_v2(ij_vector_x, hypre_memory);
+  HYPRE_IJVectorInitialize_v2(m_ij_vector_x, hypre_memory);
 #else
-  HYPRE_IJVectorInitialize(ij_vector_x);
+  HYPRE_IJVectorInitialize(m_ij_vector_x);
 #endif
 
   const Real* rhs_data = m_rhs_variable.asArray().data();
@@ -654,100 +1634,100 @@ solve()
     na_result_values.resize(m_dof_variable.asArray().size());
   }
 
-  Real v1 = platform::getRealTime();
   hypreCheck("HYPRE_IJVectorSetValues",
-             HYPRE_IJVectorSetValues(ij_vector_b, nb_local_row, rows_index_data,
+             HYPRE_IJVectorSetValues(m_ij_vector_b, nb_local_row, rows_index_data,
                                      m_rhs_variable.asArray().data()));
 
   hypreCheck("HYPRE_IJVectorSetValues",
-             HYPRE_IJVectorSetValues(ij_vector_x, nb_local_row, rows_index_data,
+             HYPRE_IJVectorSetValues(m_ij_vector_x, nb_local_row, rows_index_data,
                                      m_dof_variable.asArray().data()));
 
   hypreCheck("HYPRE_IJVectorAssemble",
-             HYPRE_IJVectorAssemble(ij_vector_b));
-  HYPRE_IJVectorGetObject(ij_vector_b, (void**)&parvector_b);
+             HYPRE_IJVectorAssemble(m_ij_vector_b));
+  HYPRE_IJVectorGetObject(m_ij_vector_b, (void**)&m_parvector_b);
 
   hypreCheck("HYPRE_IJVectorAssemble",
-             HYPRE_IJVectorAssemble(ij_vector_x));
-  HYPRE_IJVectorGetObject(ij_vector_x, (void**)&parvector_x);
+             HYPRE_IJVectorAssemble(m_ij_vector_x));
+  HYPRE_IJVectorGetObject(m_ij_vector_x, (void**)&m_parvector_x);
   Real v2 = platform::getRealTime();
+  matrix_build_time += v2 - v1;
+  // RHS and initial solution given to Hypre
+  nb_transferred_byte += 2 * nb_local_row * sizeof(Real);
   info() << "Time to create vectors=" << (v2 - v1);
   pm->traceMng()->flush();
 
   if (do_dump_matrix) {
     String file_name_b = String("dumpB.") + String::fromNumber(my_rank) + ".txt";
-    HYPRE_IJVectorPrint(ij_vector_b, file_name_b.localstr());
+    HYPRE_IJVectorPrint(m_ij_vector_b, file_name_b.localstr());
     String file_name_x = String("dumpX.") + String::fromNumber(my_rank) + ".txt";
-    HYPRE_IJVectorPrint(ij_vector_x, file_name_x.localstr());
+    HYPRE_IJVectorPrint(m_ij_vector_x, file_name_x.localstr());
     pm->traceMng()->flush();
     pm->barrier();
   }
 
-  HYPRE_Solver solver = nullptr;
-  HYPRE_Solver precond = nullptr;
-  {
-    Timer::Action ta1(tstat, "HypreSetPrecond");
-    /* setup AMG */
-    HYPRE_ParCSRPCGCreate(mpi_comm, &solver);
-
-    info() << "Info Hypre: AmgCoarsener=" << m_amg_coarsener;
-    info() << "Info Hypre: AmgInterpType=" << m_amg_interp_type;
-    info() << "Info Hypre: AmgSmoother=" << m_amg_smoother;
-
-    /* Set some parameters (See Reference Manual for more parameters) */
-    HYPRE_PCGSetMaxIter(solver, m_max_iter); /* max iterations */
-    HYPRE_PCGSetTol(solver, m_rtol); /* relative conv. tolerance */
-    HYPRE_PCGSetAbsoluteTol(solver, m_atol); /* absolute conv. tolerance */
-    HYPRE_PCGSetTwoNorm(solver, 1); /* use the two norm as the stopping criteria */
-    HYPRE_PCGSetPrintLevel(solver, m_verbosity); /* print solve info */
-    HYPRE_PCGSetLogging(solver, 1); /* needed to get run info later */
+  if (do_rebuild && m_use_rigid_body_modes && m_block_size > 1)
+    _createRigidBodyModes(mpi_comm, q, mem_ressource, is_use_device);
 
+  if (do_rebuild) {
+    Timer::Action ta1(tstat, "HypreSetPrecond");
     v1 = platform::getRealTime();
-    hypreCheck("HYPRE_BoomerAMGCreate", HYPRE_BoomerAMGCreate(&precond));
+    _createSolver(mpi_comm);
     v2 = platform::getRealTime();
-    info() << "Time to call 'HYPRE_BoomerAMGCreate' = " << (v2 - v1);
+    info() << "Time to create solver = " << (v2 - v1);
     pm->traceMng()->flush();
-
-    /* Set Boomer AMG precoditioner Note we try to add only GPU-CPU compatible ones*/
-    HYPRE_BoomerAMGCreate(&precond);
-    HYPRE_BoomerAMGSetPrintLevel(precond, 1); /* print amg solution info */
-    HYPRE_BoomerAMGSetCoarsenType(precond, m_amg_coarsener); /* GPU supported: 8(PMIS) */
-    HYPRE_BoomerAMGSetInterpType(precond, m_amg_interp_type); /* GPU supported: 3, 15, extended+i 6, 14, 18 */
-    //HYPRE_BoomerAMGSetOldDefault(precond);
-    HYPRE_BoomerAMGSetRelaxType(precond, m_amg_smoother); /* GPU support: 3, 4, 6 Sym G.S./Jacobi hybrid, 7, 18, 11, 12*/
-    HYPRE_BoomerAMGSetRelaxOrder(precond, 0); /* must be false */
-    HYPRE_BoomerAMGSetNumSweeps(precond, 1);
-    HYPRE_BoomerAMGSetTol(precond, 0.0); /* conv. tolerance zero */
-    HYPRE_BoomerAMGSetMaxIter(precond, 1); /* do only one iteration! */
-    HYPRE_BoomerAMGSetStrongThreshold(precond, m_amg_threshold); /* amg threshold strength */
-    HYPRE_BoomerAMGSetKeepTranspose(precond, 1); /* for GPU the local interp. trnsp saved*/
-
-    hypreCheck("HYPRE_ParCSRPCGSetPrecond",
-               HYPRE_ParCSRPCGSetPrecond(solver, HYPRE_BoomerAMGSolve, HYPRE_BoomerAMGSetup, precond));
   }
   Real a1 = platform::getRealTime();
-  {
+  if (do_rebuild) {
     Timer::Action ta1(tstat, "HypreSetup");
-    hypreCheck("HYPRE_PCGSetup",
-               HYPRE_ParCSRPCGSetup(solver, parcsr_A, parvector_b, parvector_x));
+    _setupSolver();
   }
   Real a2 = platform::getRealTime();
+  setup_time = a2 - m1;
   info() << "Time to setup =" << (a2 - a1);
   pm->traceMng()->flush();
 
+  Int32 nb_iteration = 0;
+  Real final_residual = 0.0;
+  bool is_converged = true;
   {
     Timer::Action ta1(tstat, "HypreLinearSystemSolve");
-    hypreCheck("HYPRE_PCGSolve",
-               HYPRE_ParCSRPCGSolve(solver, parcsr_A, parvector_b, parvector_x));
+    is_converged = _solveWithSolver(nb_iteration, final_residual);
   }
+  if (!is_converged)
+    pwarning() << "[Hypre-Info] The solver has not converged nb_iteration=" << nb_iteration
+               << " residual=" << final_residual;
   Real b1 = platform::getRealTime();
-  info() << "Time to solve=" << (b1 - a2);
+  Real solve_time = b1 - a2;
+  info() << "Time to solve=" << solve_time;
+
+  ++m_nb_solve;
+  m_total_setup_time += setup_time;
+  m_total_solve_time += solve_time;
+  info() << "[Hypre-Info] Solver=" << (int)m_solver_method
+         << " Preconditioner=" << (int)m_preconditioner
+         << " ReusePolicy=" << (int)m_reuse_policy
+         << " nb_iteration=" << nb_iteration << " residual=" << final_residual
+         << " setup_time=" << setup_time << " solve_time=" << solve_time
+         << " (total for " << m_nb_solve << " solves: setup=" << m_total_setup_time
+         << " solve=" << m_total_solve_time << ")";
   pm->traceMng()->flush();
 
+  // Solution copied back from Hypre
+  nb_transferred_byte += nb_local_row * sizeof(Real);
+  m_solve_report = {};
+  m_solve_report.linear_system_name = "Hypre";
+  m_solve_report.nb_iteration = nb_iteration;
+  m_solve_report.residual = final_residual;
+  m_solve_report.is_converged = is_converged;
+  m_solve_report.matrix_build_time = matrix_build_time;
+  m_solve_report.setup_time = setup_time - matrix_build_time;
+  m_solve_report.solve_time = solve_time;
+  m_solve_report.nb_transferred_byte = nb_transferred_byte;
+
   if (is_parallel) {
     Int32 nb_wanted_row = m_parallel_rows_index.extent0();
     hypreCheck("HYPRE_IJVectorGetValues",
-               HYPRE_IJVectorGetValues(ij_vector_x, nb_wanted_row,
+               HYPRE_IJVectorGetValues(m_ij_vector_x, nb_wanted_row,
                                        m_parallel_rows_index.to1DSpan().data(),
                                        m_result_work_values.to1DSpan().data()));
     ENUMERATE_ (DoF, idof, m_dof_family->allItems().own()) {
@@ -756,7 +1736,7 @@ solve()
   }
   else {
     hypreCheck("HYPRE_IJVectorGetValues",
-               HYPRE_IJVectorGetValues(ij_vector_x, nb_local_row, rows_index_span.data(),
+               HYPRE_IJVectorGetValues(m_ij_vector_x, nb_local_row, rows_index_span.data(),
                                        m_dof_variable.asArray().data()));
   }
 }
@@ -789,6 +1769,12 @@ class HypreDoFLinearSystemFactoryService
     x->setAmgInterpType(options()->amgInterpType());
     x->setAmgSmoother(options()->amgSmoother());
     x->setVerbosityLevel(options()->verbosity());
+    x->setReusePolicy(options()->reusePolicy());
+    x->setSolverMethod(options()->solver());
+    x->setPreconditioner(options()->preconditioner());
+    x->setKrylovDim(options()->krylovDim());
+    x->setAmgNodal(options()->amgNodal());
+    x->setUseRigidBodyModes(options()->amgRigidBodyModes());
     return x;
   }
 };
@@ -0,0 +1,293 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* LinearSystemSnapshot.cc                                     (C) 2022-2025 */
+/*                                                                           */
+/* Snapshot of an assembled linear system (binary or MatrixMarket).          */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "LinearSystemSnapshot.h"
+
+#include "DoFLinearSystem.h"
+
+#include <arcane/utils/FatalErrorException.h>
+
+#include <cstring>
+#include <fstream>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+namespace
+{
+  const char SNAPSHOT_MAGIC[8] = { 'A', 'F', 'E', 'M', 'L', 'S', 'S', '\0' };
+  constexpr Int32 SNAPSHOT_VERSION = 1;
+
+  void _openTextFile(std::ofstream& o, const String& file_name)
+  {
+    o.open(file_name.localstr(), std::ios::trunc);
+    if (!o)
+      ARCANE_FATAL("Can not open MatrixMarket file '{0}'", file_name);
+    o.precision(17);
+  }
+
+  template <typename DataType> void
+  _writeArray(std::ostream& o, const UniqueArray<DataType>& values)
+  {
+    o.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(DataType));
+  }
+
+  template <typename DataType> void
+  _readArray(std::istream& i, UniqueArray<DataType>& values, Int64 size)
+  {
+    values.resize(size);
+    i.read(reinterpret_cast<char*>(values.data()), size * sizeof(DataType));
+  }
+} // namespace
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+String LinearSystemSnapshot::
+binaryFileName(const String& file_prefix, Int32 rank)
+{
+  return String::format("{0}.{1}.lss", file_prefix, rank);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LinearSystemSnapshot::
+write(const String& file_prefix, eLinearSystemSnapshotFormat format) const
+{
+  switch (format) {
+  case eLinearSystemSnapshotFormat::None:
+    break;
+  case eLinearSystemSnapshotFormat::Binary:
+    writeBinary(binaryFileName(file_prefix, comm_rank));
+    break;
+  case eLinearSystemSnapshotFormat::MatrixMarket:
+    writeMatrixMarket(String::format("{0}.{1}", file_prefix, comm_rank));
+    break;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LinearSystemSnapshot::
+_checkSizes() const
+{
+  const Int32 nb_row = nbRow();
+  const Int32 nb_value = nbValue();
+  if (rows_nb_column.size() != nb_row || dof_uids.size() != nb_row || dof_owners.size() != nb_row ||
+      rhs.size() != nb_row || initial_solution.size() != nb_row || solution.size() != nb_row ||
+      forced_info.size() != nb_row || forced_value.size() != nb_row ||
+      elimination_info.size() != nb_row || elimination_value.size() != nb_row)
+    ARCANE_FATAL("Bad size for the arrays of the snapshot (nb_row={0})", nb_row);
+  if (values.size() != nb_value)
+    ARCANE_FATAL("Bad size for the values of the snapshot (size={0} expected={1})", values.size(), nb_value);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LinearSystemSnapshot::
+writeBinary(const String& file_name) const
+{
+  _checkSizes();
+  std::ofstream ofile(file_name.localstr(), std::ios::binary | std::ios::trunc);
+  if (!ofile)
+    ARCANE_FATAL("Can not open snapshot file '{0}'", file_name);
+
+  const Int32 header[6] = { SNAPSHOT_VERSION, comm_rank, comm_size, block_size, nbRow(), nbValue() };
+  ofile.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+  ofile.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+  _writeArray(ofile, dof_uids);
+  _writeArray(ofile, dof_owners);
+  _writeArray(ofile, rows);
+  _writeArray(ofile, rows_nb_column);
+  _writeArray(ofile, columns);
+  _writeArray(ofile, values);
+  _writeArray(ofile, rhs);
+  _writeArray(ofile, initial_solution);
+  _writeArray(ofile, solution);
+  _writeArray(ofile, forced_info);
+  _writeArray(ofile, forced_value);
+  _writeArray(ofile, elimination_info);
+  _writeArray(ofile, elimination_value);
+  if (!ofile)
+    ARCANE_FATAL("Error while writing snapshot file '{0}'", file_name);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void LinearSystemSnapshot::
+readBinary(const String& file_name)
+{
+  std::ifstream ifile(file_name.localstr(), std::ios::binary);
+  if (!ifile)
+    ARCANE_FATAL("Can not open snapshot file '{0}'", file_name);
+
+  char magic[sizeof(SNAPSHOT_MAGIC)];
+  Int32 header[6];
+  ifile.read(magic, sizeof(magic));
+  ifile.read(reinterpret_cast<char*>(header), sizeof(header));
+  if (!ifile || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0)
+    ARCANE_FATAL("File '{0}' is not a linear system snapshot", file_name);
+  if (header[0] != SNAPSHOT_VERSION)
+    ARCANE_FATAL("Bad version '{0}' for snapshot file '{1}' (expected={2})", header[0], file_name, SNAPSHOT_VERSION);
+
+  comm_rank = header[1];
+  comm_size = header[2];
+  block_size = header[3];
+  const Int32 nb_row = header[4];
+  const Int32 nb_value = header[5];
+  if (nb_row < 0 || nb_value < 0)
+    ARCANE_FATAL("Bad sizes in snapshot file '{0}' (nb_row={1} nb_value={2})", file_name, nb_row, nb_value);
+
+  // The arrays have to fill exactly the rest of the file. It is checked
+  // before any allocation so that a corrupted header can not give huge sizes.
+  const std::streamoff data_begin = ifile.tellg();
+  ifile.seekg(0, std::ios::end);
+  const Int64 nb_data_byte = static_cast<Int64>(ifile.tellg() - data_begin);
+  ifile.seekg(data_begin);
+  const Int64 nb_byte_per_row = sizeof(Int64) + 3 * sizeof(Int32) + 5 * sizeof(Real) + 2 * sizeof(Byte);
+  const Int64 nb_byte_per_value = sizeof(Int32) + sizeof(Real);
+  const Int64 nb_expected_byte = nb_byte_per_row * nb_row + nb_byte_per_value * nb_value;
+  if (!ifile || nb_data_byte != nb_expected_byte)
+    ARCANE_FATAL("Bad size for snapshot file '{0}' (nb_row={1} nb_value={2} nb_byte={3} expected={4})",
+                 file_name, nb_row, nb_value, nb_data_byte, nb_expected_byte);
+
+  _readArray(ifile, dof_uids, nb_row);
+  _readArray(ifile, dof_owners, nb_row);
+  _readArray(ifile, rows, nb_row);
+  _readArray(ifile, rows_nb_column, nb_row);
+  _readArray(ifile, columns, nb_value);
+  _readArray(ifile, values, nb_value);
+  _readArray(ifile, rhs, nb_row);
+  _readArray(ifile, initial_solution, nb_row);
+  _readArray(ifile, solution, nb_row);
+  _readArray(ifile, forced_info, nb_row);
+  _readArray(ifile, forced_value, nb_row);
+  _readArray(ifile, elimination_info, nb_row);
+  _readArray(ifile, elimination_value, nb_row);
+  if (!ifile)
+    ARCANE_FATAL("Error while reading snapshot file '{0}' (file is truncated)", file_name);
+
+  // The row indexes have to be consistent with the number of values
+  for (Int32 r = 0; r < nb_row; ++r) {
+    if (rows[r] < 0 || rows_nb_column[r] < 0 || static_cast<Int64>(rows[r]) + rows_nb_column[r] > nb_value)
+      ARCANE_FATAL("Bad row index in snapshot file '{0}' (row={1} index={2} nb_column={3} nb_value={4})",
+                   file_name, r, rows[r], rows_nb_column[r], nb_value);
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Write the system actually solved in MatrixMarket format.
+ *
+ * The forced values replace the diagonal, the eliminated rows become
+ * identity rows and the eliminated columns are moved to the RHS, as done
+ * by the implementations of DoFLinearSystem. Indexes are the local ids
+ * plus one.
+ */
+void LinearSystemSnapshot::
+writeMatrixMarket(const String& file_prefix) const
+{
+  _checkSizes();
+  const Int32 nb_row = nbRow();
+
+  UniqueArray<Int32> out_rows;
+  UniqueArray<Int32> out_columns;
+  UniqueArray<Real> out_values;
+  UniqueArray<Real> out_rhs(rhs);
+  for (Int32 r = 0; r < nb_row; ++r) {
+    if (dof_uids[r] < 0 || dof_owners[r] != comm_rank)
+      continue;
+    if (elimination_info[r] != ELIMINATE_NONE) {
+      out_rows.add(r);
+      out_columns.add(r);
+      out_values.add(1.0);
+      out_rhs[r] = elimination_value[r];
+      continue;
+    }
+    bool has_diagonal = false;
+    for (Int32 i = rows[r], n = rows[r] + rows_nb_column[r]; i < n; ++i) {
+      Int32 c = columns[i];
+      if (c < 0)
+        continue;
+      Real v = values[i];
+      if (c == r) {
+        has_diagonal = true;
+        if (forced_info[r])
+          v = forced_value[r];
+      }
+      else if (elimination_info[c] == ELIMINATE_ROW_COLUMN) {
+        out_rhs[r] -= v * elimination_value[c];
+        continue;
+      }
+      out_rows.add(r);
+      out_columns.add(c);
+      out_values.add(v);
+    }
+    if (forced_info[r] && !has_diagonal) {
+      out_rows.add(r);
+      out_columns.add(r);
+      out_values.add(forced_value[r]);
+    }
+  }
+
+  {
+    std::ofstream o;
+    _openTextFile(o, file_prefix + ".mtx");
+    o << "%%MatrixMarket matrix coordinate real general\n";
+    o << "% ArcaneFem linear system rank=" << comm_rank << " nb_rank=" << comm_size
+      << " block_size=" << block_size << "\n";
+    o << nb_row << " " << nb_row << " " << out_values.size() << "\n";
+    for (Int32 i = 0, n = out_values.size(); i < n; ++i)
+      o << (out_rows[i] + 1) << " " << (out_columns[i] + 1) << " " << out_values[i] << "\n";
+  }
+
+  auto write_vector = [&](const String& file_name, ConstArrayView<Real> v) {
+    std::ofstream o;
+    _openTextFile(o, file_name);
+    o << "%%MatrixMarket matrix array real general\n";
+    o << v.size() << " 1\n";
+    for (Real x : v)
+      o << x << "\n";
+  };
+  write_vector(file_prefix + ".rhs.mtx", out_rhs.constView());
+  write_vector(file_prefix + ".solution.mtx", solution.constView());
+
+  {
+    std::ofstream o;
+    _openTextFile(o, file_prefix + ".dofs.mtx");
+    o << "%%MatrixMarket matrix array integer general\n";
+    o << "% Column 1: unique id of the DoF, column 2: owner\n";
+    o << nb_row << " 2\n";
+    for (Int64 uid : dof_uids)
+      o << uid << "\n";
+    for (Int32 owner : dof_owners)
+      o << owner << "\n";
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,132 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* LinearSystemSnapshot.h                                      (C) 2022-2025 */
+/*                                                                           */
+/* Snapshot of an assembled linear system (binary or MatrixMarket).          */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+#ifndef FEMUTILS_LINEARSYSTEMSNAPSHOT_H
+#define FEMUTILS_LINEARSYSTEMSNAPSHOT_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <arcane/utils/UniqueArray.h>
+#include <arcane/utils/String.h>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+//! Format of the files written by LinearSystemSnapshot
+enum class eLinearSystemSnapshotFormat
+{
+  //! No snapshot
+  None,
+  //! Compact binary file which can be replayed (extension '.lss')
+  Binary,
+  //! MatrixMarket files (extension '.mtx') for interoperability
+  MatrixMarket
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Snapshot of the linear system of one sub-domain.
+ *
+ * It contains the CSR matrix given by DoFLinearSystem::setCSRValues() as
+ * it was before the solve (the eliminations and the forced values are not
+ * applied to the matrix and are stored separately), the RHS, the initial
+ * and the final solution and the numbering of the DoFs. All the arrays
+ * are indexed by the local id of the DoFs and the columns of the matrix
+ * are local ids (a null local id is a padding value).
+ *
+ * The binary file uses the native endianness. It contains a header
+ * (magic string 'AFEMLSS', version, rank, number of ranks, block size,
+ * number of rows and number of values) followed by the arrays in the
+ * order of the fields of this class.
+ *
+ * The MatrixMarket files contain the system actually solved: the forced
+ * values and the eliminations are applied. Only the rows of the own DoFs
+ * are written.
+ */
+class LinearSystemSnapshot
+{
+ public:
+
+  //! Rank of the sub-domain
+  Int32 comm_rank = 0;
+  //! Number of sub-domains
+  Int32 comm_size = 1;
+  //! Number of DoFs per node (see DoFLinearSystem::setBlockSize())
+  Int32 block_size = 1;
+
+  //! Unique ids of the DoFs (-1 if there is no DoF for the local id)
+  UniqueArray<Int64> dof_uids;
+  //! Owner of the DoFs
+  UniqueArray<Int32> dof_owners;
+
+  UniqueArray<Int32> rows;
+  UniqueArray<Int32> rows_nb_column;
+  UniqueArray<Int32> columns;
+  UniqueArray<Real> values;
+
+  UniqueArray<Real> rhs;
+  UniqueArray<Real> initial_solution;
+  UniqueArray<Real> solution;
+
+  UniqueArray<Byte> forced_info;
+  UniqueArray<Real> forced_value;
+  UniqueArray<Byte> elimination_info;
+  UniqueArray<Real> elimination_value;
+
+ public:
+
+  Int32 nbRow() const { return rows.size(); }
+  Int32 nbValue() const { return columns.size(); }
+
+  /*!
+   * \brief Write the snapshot in the format \a format.
+   *
+   * The name of the files is \a file_prefix followed by the rank.
+   */
+  void write(const String& file_prefix, eLinearSystemSnapshotFormat format) const;
+
+  //! Write the binary file \a file_name
+  void writeBinary(const String& file_name) const;
+
+  //! Read the binary file \a file_name
+  void readBinary(const String& file_name);
+
+  /*!
+   * \brief Write the MatrixMarket files.
+   *
+   * The matrix is written in '<file_prefix>.mtx', the vectors in
+   * '<file_prefix>.rhs.mtx' and '<file_prefix>.solution.mtx' and the
+   * unique ids and owners of the DoFs in '<file_prefix>.dofs.mtx'.
+   */
+  void writeMatrixMarket(const String& file_prefix) const;
+
+  //! Name of the binary file of the rank \a rank for the prefix \a file_prefix
+  static String binaryFileName(const String& file_prefix, Int32 rank);
+
+ private:
+
+  void _checkSizes() const;
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -0,0 +1,207 @@
+// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* MatrixFreeOperator.h                                        (C) 2022-2025 */
+/*                                                                           */
+/* Linear operator computed on the fly from the element matrices.            */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#ifndef MATRIXFREEOPERATOR_H
+#define MATRIXFREEOPERATOR_H
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <memory>
+
+#include <arccore/trace/TraceAccessor.h>
+
+#include <arcane/core/UnstructuredMeshConnectivity.h>
+#include <arcane/core/IndexedItemConnectivityView.h>
+#include <arcane/core/ItemEnumerator.h>
+#include <arcane/core/ItemTypes.h>
+#include <arcane/core/IMesh.h>
+#include <arcane/core/Item.h>
+
+#include <arcane/utils/PlatformUtils.h>
+
+#include <arcane/accelerator/RunCommandEnumerate.h>
+#include <arcane/accelerator/RunCommandLoop.h>
+#include <arcane/accelerator/core/RunQueue.h>
+#include <arcane/accelerator/Atomic.h>
+
+#include "DoFLinearSystem.h"
+#include "FemDoFsOnNodes.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Matrix-free linear operator for DoFs on nodes.
+ *
+ * The global matrix is never stored. Each application of the operator
+ * loops over the cells, computes the element matrix with the
+ * `compute_element_matrix` kernel (the same kernel as the one given to
+ * BSRFormat::assembleBilinear()) and accumulates the product with the
+ * input vector in the rows of the own nodes.
+ *
+ * This trades memory bandwidth for flops: the memory used is only the
+ * mesh and the vectors, which allows bigger meshes per node.
+ *
+ * @note The contributions of the cells are accumulated with atomic
+ * operations.
+ */
+/*---------------------------------------------------------------------------*/
+
+template <int NB_DOF, class Function>
+class MatrixFreeOperator
+: public TraceAccessor
+, public IDoFLinearOperator
+{
+ public:
+
+  MatrixFreeOperator(ITraceMng* tm, IMesh* mesh, const RunQueue& queue,
+                     const FemDoFsOnNodes& dofs_on_nodes, Function compute_element_matrix)
+  : TraceAccessor(tm)
+  , m_mesh(mesh)
+  , m_queue(queue)
+  , m_dofs_on_nodes(dofs_on_nodes)
+  , m_compute_element_matrix(compute_element_matrix)
+  {
+    ARCANE_CHECK_POINTER(mesh);
+  }
+
+ public:
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Computes y = A.x by looping over the cells.
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void apply(Span<const Real> x, Span<Real> y) override
+  {
+    UnstructuredMeshConnectivityView connectivity_view(m_mesh);
+    auto cell_node_cv = connectivity_view.cellNode();
+    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    auto node_dof(m_dofs_on_nodes.nodeDoFConnectivityView());
+    auto compute_element_matrix = m_compute_element_matrix;
+
+    {
+      auto command = makeCommand(m_queue);
+      command << RUNCOMMAND_LOOP1(iter, y.size())
+      {
+        auto [i] = iter();
+        y[i] = 0.0;
+      };
+    }
+
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
+    {
+      auto element_matrix = compute_element_matrix(cell);
+
+      Int32 row_node_idx = 0;
+      for (NodeLocalId row_node_lid : cell_node_cv.nodes(cell)) {
+        if (nodes_infos.isOwn(row_node_lid)) {
+          for (Int32 i = 0; i < NB_DOF; ++i) {
+            Real sum = 0.0;
+            Int32 col_node_idx = 0;
+            for (NodeLocalId col_node_lid : cell_node_cv.nodes(cell)) {
+              for (Int32 j = 0; j < NB_DOF; ++j)
+                sum += element_matrix(NB_DOF * row_node_idx + i, NB_DOF * col_node_idx + j) * x[node_dof.dofId(col_node_lid, j)];
+              ++col_node_idx;
+            }
+            Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(y[node_dof.dofId(row_node_lid, i)], sum);
+          }
+        }
+        ++row_node_idx;
+      }
+    };
+  }
+
+  /*---------------------------------------------------------------------------*/
+  /**
+   * @brief Extracts the diagonal of the operator (for Jacobi preconditioning).
+   */
+  /*---------------------------------------------------------------------------*/
+
+  void computeDiagonal(Span<Real> diagonal) override
+  {
+    auto startTime = platform::getRealTime();
+
+    UnstructuredMeshConnectivityView connectivity_view(m_mesh);
+    auto cell_node_cv = connectivity_view.cellNode();
+    ItemGenericInfoListView nodes_infos(m_mesh->nodeFamily());
+    auto node_dof(m_dofs_on_nodes.nodeDoFConnectivityView());
+    auto compute_element_matrix = m_compute_element_matrix;
+
+    {
+      auto command = makeCommand(m_queue);
+      command << RUNCOMMAND_LOOP1(iter, diagonal.size())
+      {
+        auto [i] = iter();
+        diagonal[i] = 0.0;
+      };
+    }
+
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_ENUMERATE(Cell, cell, m_mesh->allCells())
+    {
+      auto element_matrix = compute_element_matrix(cell);
+
+      Int32 node_idx = 0;
+      for (NodeLocalId node_lid : cell_node_cv.nodes(cell)) {
+        if (nodes_infos.isOwn(node_lid)) {
+          for (Int32 i = 0; i < NB_DOF; ++i) {
+            Real value = element_matrix(NB_DOF * node_idx + i, NB_DOF * node_idx + i);
+            Accelerator::doAtomic<Accelerator::eAtomicOperation::Add>(diagonal[node_dof.dofId(node_lid, i)], value);
+          }
+        }
+        ++node_idx;
+      }
+    };
+
+    info() << "[ArcaneFem-Timer] Time to compute matrix-free diagonal = " << (platform::getRealTime() - startTime);
+  }
+
+ private:
+
+  IMesh* m_mesh = nullptr;
+  RunQueue m_queue;
+  const FemDoFsOnNodes& m_dofs_on_nodes;
+  Function m_compute_element_matrix;
+};
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Creates a MatrixFreeOperator for the kernel `compute_element_matrix`.
+ */
+/*---------------------------------------------------------------------------*/
+
+template <int NB_DOF, class Function>
+std::unique_ptr<IDoFLinearOperator>
+makeMatrixFreeOperator(ITraceMng* tm, IMesh* mesh, const RunQueue& queue,
+                       const FemDoFsOnNodes& dofs_on_nodes, Function compute_element_matrix)
+{
+  return std::make_unique<MatrixFreeOperator<NB_DOF, Function>>(tm, mesh, queue, dofs_on_nodes, compute_element_matrix);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
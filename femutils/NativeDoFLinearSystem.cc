@@ -0,0 +1,1486 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2024 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* NativeDoFLinearSystem.cc                                         (C) 2024 */
+/*                                                                           */
+/* Linear system: Matrix A + Vector x + Vector b for Ax=b.                   */
+/* Krylov solvers using the accelerator API of Arcane.                       */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "DoFLinearSystem.h"
+
+#include <arcane/utils/FatalErrorException.h>
+#include <arcane/utils/NotImplementedException.h>
+#include <arcane/utils/PlatformUtils.h>
+#include <arcane/utils/NumArray.h>
+#include <arcane/utils/MDDim.h>
+
+#include <arcane/core/ServiceFactory.h>
+#include <arcane/core/VariableTypes.h>
+#include <arcane/core/IParallelMng.h>
+#include <arcane/core/IItemFamily.h>
+
+#include <arcane/accelerator/core/Runner.h>
+#include <arcane/accelerator/core/RunQueue.h>
+#include <arcane/accelerator/RunCommandLoop.h>
+#include <arcane/accelerator/Reduce.h>
+
+#include "FemUtils.h"
+#include "IDoFLinearSystemFactory.h"
+#include "ArcaneFemFunctionsGpu.h"
+
+namespace Arcane::FemUtils
+{
+//! Krylov solver of NativeLinearSystem
+enum class eNativeSolver
+{
+  CG,
+  BiCGSTAB,
+  //! Restarted GMRES with right preconditioning
+  GMRES
+};
+
+//! Preconditioner of NativeLinearSystem
+enum class eNativePreconditioner
+{
+  None,
+  Jacobi,
+  //! Inverse of the diagonal blocks (one block per node)
+  BlockJacobi,
+  //! Chebyshev polynomial of the Jacobi preconditioned matrix
+  Chebyshev
+};
+} // namespace Arcane::FemUtils
+
+#include "NativeDoFLinearSystemFactory_axl.h"
+
+#include <cmath>
+
+// NOTE:
+// DoF family must be compacted (i.e maxLocalId()==nbItem()) and sorted
+// for this implementation to works. With block-jacobi, the DoFs of a
+// node have to be contiguous (which is the case with FemDoFsOnNodes).
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+using namespace Arcane;
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Linear system solved with Krylov methods written with RunCommand.
+ *
+ * The matrix is the CSR matrix given by setCSRValues(). Each sub-domain
+ * owns the rows of its own DoFs. The vectors are stored for all the DoFs
+ * (own and ghost) and the input vector of the matrix-vector product is
+ * synchronized before each product. Dot products are only computed on own
+ * DoFs and are then reduced on all the sub-domains.
+ *
+ * If a linear operator is given with setLinearOperator(), the CSR matrix
+ * is not used (matrix-free mode or symmetric BSR matrix). The matrix-vector
+ * product calls the operator and the forced values and eliminations are
+ * applied around it.
+ */
+class NativeDoFLinearSystemImpl
+: public TraceAccessor
+, public DoFLinearSystemImpl
+{
+  //! Maximum size of the blocks for the block Jacobi preconditioner
+  static constexpr Int32 MAX_BLOCK_SIZE = 4;
+
+ public:
+
+  NativeDoFLinearSystemImpl(IItemFamily* dof_family, const String& solver_name)
+  : TraceAccessor(dof_family->traceMng())
+  , m_dof_family(dof_family)
+  , m_rhs_variable(VariableBuildInfo(dof_family, solver_name + "RHSVariable"))
+  , m_dof_variable(VariableBuildInfo(dof_family, solver_name + "SolutionVariable"))
+  , m_dof_forced_info(VariableBuildInfo(dof_family, solver_name + "DoFForcedInfo"))
+  , m_dof_forced_value(VariableBuildInfo(dof_family, solver_name + "DoFForcedValue"))
+  , m_dof_elimination_info(VariableBuildInfo(dof_family, solver_name + "DoFEliminationInfo"))
+  , m_dof_elimination_value(VariableBuildInfo(dof_family, solver_name + "DoFEliminationValue"))
+  , m_work_variable(VariableBuildInfo(dof_family, solver_name + "NativeWorkVariable"))
+  {
+    info() << "Creating NativeDoFLinearSystemImpl()";
+    m_dof_forced_info.fill(false);
+    m_dof_elimination_info.fill(ELIMINATE_NONE);
+    m_dof_elimination_value.fill(0.0);
+  }
+
+ public:
+
+  void matrixAddValue(DoFLocalId row, DoFLocalId column, Real value) override
+  {
+    if (m_linear_operator)
+      ARCANE_FATAL("matrixAddValue() can not be used with a linear operator");
+    m_assembled_csr_view.values()[_indexValue(row, column)] += value;
+  }
+
+  void matrixSetValue(DoFLocalId row, DoFLocalId column, Real value) override
+  {
+    if (m_linear_operator) {
+      // Only the diagonal can be changed (for Dirichlet via penalty)
+      if (row != column)
+        ARCANE_FATAL("matrixSetValue() can only set the diagonal with a linear operator");
+      m_dof_forced_info[row] = true;
+      m_dof_forced_value[row] = value;
+      return;
+    }
+    m_assembled_csr_view.values()[_indexValue(row, column)] = value;
+  }
+
+  void eliminateRow(DoFLocalId row, Real value) override
+  {
+    m_dof_elimination_info[row] = ELIMINATE_ROW;
+    m_dof_elimination_value[row] = value;
+  }
+
+  void eliminateRowColumn(DoFLocalId row, Real value) override
+  {
+    m_dof_elimination_info[row] = ELIMINATE_ROW_COLUMN;
+    m_dof_elimination_value[row] = value;
+  }
+
+  void solve() override;
+
+  VariableDoFReal& solutionVariable() override { return m_dof_variable; }
+  VariableDoFReal& rhsVariable() override { return m_rhs_variable; }
+
+  void setSolverCommandLineArguments(const CommandLineArguments&) override {}
+
+  void clearValues() override
+  {
+    info() << "[Native-Info]: Clear values";
+    m_csr_view = {};
+    m_assembled_csr_view = {};
+    m_dof_forced_info.fill(false);
+    m_dof_elimination_info.fill(ELIMINATE_NONE);
+    m_dof_elimination_value.fill(0);
+  }
+
+  CSRFormatView& getCSRValues() override { return m_assembled_csr_view; };
+  VariableDoFBool& getForcedInfo() override { return m_dof_forced_info; }
+  VariableDoFReal& getForcedValue() override { return m_dof_forced_value; }
+  VariableDoFByte& getEliminationInfo() override { return m_dof_elimination_info; }
+  VariableDoFReal& getEliminationValue() override { return m_dof_elimination_value; }
+
+  void setCSRValues(const CSRFormatView& csr_view) override
+  {
+    m_assembled_csr_view = csr_view;
+    m_csr_view = csr_view;
+  }
+  bool hasSetCSRValues() const override { return true; }
+  void setCSRValues64(const CSRFormatView64&) override
+  {
+    ARCANE_THROW(NotImplementedException, "CSR matrix with 64-bit row offsets");
+  }
+  bool hasSetCSRValues64() const override { return false; }
+
+  void setLinearOperator(IDoFLinearOperator* linear_operator) override { m_linear_operator = linear_operator; }
+  bool hasSetLinearOperator() const override { return true; }
+  void solveMultipleRhs(VariableDoFArrayReal& rhs, VariableDoFArrayReal& solution) override;
+  bool hasSolveMultipleRhs() const override { return true; }
+  const SolveReport& solveReport() const override { return m_solve_report; }
+
+  void setRunner(Runner* r) override { m_runner = r; }
+  Runner* runner() const override { return m_runner; }
+
+  void setBlockSize(Int32 block_size) override { m_block_size = block_size; }
+
+  void setSolverMethod(eNativeSolver v) { m_solver_method = v; }
+  void setPreconditioner(eNativePreconditioner v) { m_preconditioner = v; }
+  void setRelTolerance(Real v) { m_rtol = v; }
+  void setAbsTolerance(Real v) { m_atol = v; }
+  void setMaxIter(Int32 v) { m_max_iter = v; }
+  void setKrylovDim(Int32 v) { m_krylov_dim = v; }
+  void setChebyshevDegree(Int32 v) { m_chebyshev_degree = v; }
+  void setChebyshevEigenRatio(Real v) { m_chebyshev_eigen_ratio = v; }
+  void setVerbosityLevel(Int32 v) { m_verbosity = v; }
+
+  // NOTE: The following methods launch kernels and have to be public
+  // to be used with CUDA.
+
+  void _setupSystem(Real& matrix_build_time, Real& setup_time);
+  SolveReport _solveRhs(Span<const Real> b, Span<Real> x);
+  void _selectMatrixValues();
+  void _applyElimination();
+  void _applyForcedValuesToLhs();
+  void _setupLinearOperator();
+  void _spmv(Span<const Real> x, Span<Real> y);
+  void _applyLinearOperator(Span<const Real> x, Span<Real> y);
+  void _residual(Span<const Real> b, Span<const Real> x, Span<Real> r);
+  Real _dot(Span<const Real> a, Span<const Real> b);
+  void _axpy(Real alpha, Span<const Real> x, Span<Real> y);
+  void _xpby(Span<const Real> x, Real beta, Span<Real> y);
+  void _scale(Real alpha, Span<const Real> x, Span<Real> y);
+  void _copy(Span<const Real> x, Span<Real> y);
+  void _setupPreconditioner();
+  void _computeInverseDiagonal();
+  void _computeInverseBlockDiagonal();
+  void _estimateMaxEigenValue();
+  void _applyPreconditioner(Span<const Real> r, Span<Real> z);
+  void _applyDiagonal(Span<const Real> r, Span<Real> z);
+  void _applyBlockDiagonal(Span<const Real> r, Span<Real> z);
+  void _applyChebyshev(Span<const Real> r, Span<Real> z);
+
+ private:
+
+  IItemFamily* m_dof_family = nullptr;
+  VariableDoFReal m_rhs_variable;
+  VariableDoFReal m_dof_variable;
+  VariableDoFBool m_dof_forced_info;
+  VariableDoFReal m_dof_forced_value;
+  VariableDoFByte m_dof_elimination_info;
+  VariableDoFReal m_dof_elimination_value;
+  //! Variable used to synchronize the input vector of the matrix-vector product
+  VariableDoFReal m_work_variable;
+  Runner* m_runner = nullptr;
+  RunQueue m_queue;
+
+  //! Matrix given by setCSRValues(), never modified by solve()
+  CSRFormatView m_assembled_csr_view;
+  //! Matrix used by the solver (see _selectMatrixValues())
+  CSRFormatView m_csr_view;
+  //! Values of m_csr_view if the matrix has eliminations or forced values
+  NumArray<Real, MDDim1> m_matrix_values;
+  SolveReport m_solve_report;
+  //! Linear operator used instead of the CSR matrix (may be null)
+  IDoFLinearOperator* m_linear_operator = nullptr;
+  //! Diagonal of the linear operator with forced values and eliminations
+  NumArray<Real, MDDim1> m_operator_diagonal;
+  //! Correction of the diagonal of the linear operator for forced values
+  NumArray<Real, MDDim1> m_operator_forced_correction;
+
+  IParallelMng* m_parallel_mng = nullptr;
+  bool m_is_parallel = false;
+  Int32 m_nb_row = 0;
+  Int32 m_block_size = 1;
+  //! 1 if the DoF is owned by this sub-domain
+  NumArray<Byte, MDDim1> m_is_own;
+
+  //! Inverse of the diagonal (Jacobi and Chebyshev)
+  NumArray<Real, MDDim1> m_inverse_diagonal;
+  //! Inverse of the diagonal blocks (block Jacobi)
+  NumArray<Real, MDDim1> m_inverse_block_diagonal;
+  //! Work vectors for the preconditioners
+  NumArray<Real, MDDim1> m_precond_work1;
+  NumArray<Real, MDDim1> m_precond_work2;
+  //! Estimation of the largest eigenvalue of D^-1.A (Chebyshev)
+  Real m_max_eigen_value = 0.0;
+
+  eNativeSolver m_solver_method = eNativeSolver::CG;
+  eNativePreconditioner m_preconditioner = eNativePreconditioner::Jacobi;
+  Real m_rtol = 1.0e-8;
+  Real m_atol = 0.0;
+  Int32 m_max_iter = 1000;
+  Int32 m_krylov_dim = 30;
+  Int32 m_chebyshev_degree = 3;
+  Real m_chebyshev_eigen_ratio = 30.0;
+  Int32 m_verbosity = 1;
+
+ private:
+
+  Int32 _indexValue(DoFLocalId row_lid, DoFLocalId column_lid)
+  {
+    Int32 begin = m_assembled_csr_view.rows()[row_lid];
+    Int32 end = begin + m_assembled_csr_view.rowsNbColumn()[row_lid];
+    for (Int32 i = begin; i < end; ++i)
+      if (m_assembled_csr_view.columns()[i] == column_lid)
+        return i;
+    ARCANE_FATAL("No value for (row={0},column={1}) in the matrix", row_lid.localId(), column_lid.localId());
+  }
+
+  bool _isConverged(Real residual_norm, Real rhs_norm) const
+  {
+    return residual_norm <= math::max(m_rtol * rhs_norm, m_atol);
+  }
+
+  void _printIteration(const char* name, Int32 iteration, Real residual_norm, Real rhs_norm)
+  {
+    if (m_verbosity > 1)
+      info() << "[Native-Info] " << name << " iteration=" << iteration
+             << " residual=" << (residual_norm / rhs_norm);
+  }
+
+  Int32 _solveCG(Span<const Real> b, Span<Real> x, Real rhs_norm, Real& residual_norm);
+  Int32 _solveBiCGSTAB(Span<const Real> b, Span<Real> x, Real rhs_norm, Real& residual_norm);
+  Int32 _solveGMRES(Span<const Real> b, Span<Real> x, Real rhs_norm, Real& residual_norm);
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Select the values of the matrix used by the solver.
+ *
+ * The view given by setCSRValues() may share its values with the assembled
+ * matrix (see BSRMatrix::toCsr()). If some DoFs are eliminated or forced,
+ * the values are copied so that the eliminations do not change the
+ * assembled matrix, which can then be solved again or used for other
+ * products. Otherwise, the values of the view are used without copy.
+ */
+void NativeDoFLinearSystemImpl::
+_selectMatrixValues()
+{
+  // Ghost DoFs have to know if they are eliminated because they may
+  // be used as column in our rows.
+  if (m_is_parallel) {
+    m_dof_elimination_info.synchronize();
+    m_dof_elimination_value.synchronize();
+  }
+
+  Int32 nb_modified_row = 0;
+  {
+    auto command = makeCommand(m_queue);
+    Accelerator::ReducerSum2<Int32> reducer(command);
+    auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+    auto in_forced_info = Accelerator::viewIn(command, m_dof_forced_info);
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row, reducer)
+    {
+      auto [i] = iter();
+      DoFLocalId dof_id(i);
+      if (in_elimination_info[dof_id] != ELIMINATE_NONE || in_forced_info[dof_id])
+        reducer.combine(1);
+    };
+    nb_modified_row = reducer.reducedValue();
+  }
+
+  m_csr_view = m_assembled_csr_view;
+  if (nb_modified_row == 0)
+    return;
+
+  Span<const Real> in_values = m_assembled_csr_view.values();
+  Int64 nb_value = in_values.size();
+  m_matrix_values.resize(nb_value);
+  {
+    auto command = makeCommand(m_queue);
+    Span<Real> out_values = m_matrix_values.to1DSpan();
+    command << RUNCOMMAND_LOOP1(iter, nb_value)
+    {
+      auto [i] = iter();
+      out_values[i] = in_values[i];
+    };
+  }
+  m_csr_view = CSRFormatView(m_assembled_csr_view.rows(), m_assembled_csr_view.rowsNbColumn(),
+                             m_assembled_csr_view.columns(), m_matrix_values.to1DSpan());
+  m_csr_view.setStructureVersion(m_assembled_csr_view.structureVersion());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Apply row and row-column elimination to the CSR matrix.
+ *
+ * For an eliminated row \a r, the row becomes the identity row and the
+ * RHS is set to the elimination value. For a row-column elimination, the
+ * values of the column \a r in the other rows are also removed and moved
+ * to the RHS (b_i -= a_ir * value).
+ */
+void NativeDoFLinearSystemImpl::
+_applyElimination()
+{
+  auto command = makeCommand(m_queue);
+  auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+  auto in_elimination_value = Accelerator::viewIn(command, m_dof_elimination_value);
+  auto in_out_rhs_variable = Accelerator::viewInOut(command, m_rhs_variable);
+
+  Span<const Int32> in_csr_row = m_csr_view.rows();
+  Span<const Int32> in_csr_row_nb_column = m_csr_view.rowsNbColumn();
+  Span<const Int32> in_csr_columns = m_csr_view.columns();
+  Span<Real> in_out_csr_values = m_csr_view.values();
+
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [thread_id] = iter();
+    DoFLocalId dof_id(thread_id);
+    auto elimination_info = in_elimination_info[dof_id];
+    Int32 begin = in_csr_row[dof_id];
+    Int32 end = begin + in_csr_row_nb_column[dof_id];
+    if (elimination_info == ELIMINATE_ROW || elimination_info == ELIMINATE_ROW_COLUMN) {
+      for (Int32 i = begin; i < end; ++i)
+        in_out_csr_values[i] = (in_csr_columns[i] == dof_id) ? 1.0 : 0.0;
+      in_out_rhs_variable[dof_id] = in_elimination_value[dof_id];
+    }
+    else {
+      Real rhs_value = in_out_rhs_variable[dof_id];
+      for (Int32 i = begin; i < end; ++i) {
+        DoFLocalId column_id(in_csr_columns[i]);
+        if (column_id.isNull() || column_id == dof_id)
+          continue;
+        if (in_elimination_info[column_id] == ELIMINATE_ROW_COLUMN) {
+          rhs_value -= in_out_csr_values[i] * in_elimination_value[column_id];
+          in_out_csr_values[i] = 0.0;
+        }
+      }
+      in_out_rhs_variable[dof_id] = rhs_value;
+    }
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+_applyForcedValuesToLhs()
+{
+  auto command = makeCommand(m_queue);
+  auto in_forced_info = Accelerator::viewIn(command, m_dof_forced_info);
+  auto in_forced_value = Accelerator::viewIn(command, m_dof_forced_value);
+
+  Span<const Int32> in_csr_row = m_csr_view.rows();
+  Span<const Int32> in_csr_row_nb_column = m_csr_view.rowsNbColumn();
+  Span<const Int32> in_csr_columns = m_csr_view.columns();
+  Span<Real> in_out_csr_values = m_csr_view.values();
+
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [dof_id] = iter();
+    if (in_forced_info[DoFLocalId(dof_id)]) {
+      Int32 begin = in_csr_row[dof_id];
+      Int32 end = begin + in_csr_row_nb_column[dof_id];
+      Int32 index = FemUtils::Gpu::Csr::findIndex(begin, end, dof_id, in_csr_columns);
+      // The rows of ghost DoFs may be empty (see BSRFormat)
+      if (index >= 0)
+        in_out_csr_values[index] = in_forced_value[DoFLocalId(dof_id)];
+    }
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute y = A.x.
+ *
+ * In parallel \a x is first copied in a variable which is synchronized
+ * so that ghost values are up to date. Only the values of \a y for own
+ * DoFs are relevant.
+ */
+void NativeDoFLinearSystemImpl::
+_spmv(Span<const Real> x, Span<Real> y)
+{
+  if (m_linear_operator) {
+    _applyLinearOperator(x, y);
+    return;
+  }
+
+  Span<const Real> in_x = x;
+  if (m_is_parallel) {
+    Span<Real> work = m_work_variable.asArray();
+    _copy(x, work);
+    m_work_variable.synchronize();
+    in_x = m_work_variable.asArray();
+  }
+
+  auto command = makeCommand(m_queue);
+  Span<const Int32> in_csr_row = m_csr_view.rows();
+  Span<const Int32> in_csr_row_nb_column = m_csr_view.rowsNbColumn();
+  Span<const Int32> in_csr_columns = m_csr_view.columns();
+  Span<const Real> in_csr_values = m_csr_view.values();
+
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [row] = iter();
+    Int32 begin = in_csr_row[row];
+    Int32 end = begin + in_csr_row_nb_column[row];
+    Real sum = 0.0;
+    for (Int32 i = begin; i < end; ++i) {
+      Int32 column = in_csr_columns[i];
+      if (column >= 0)
+        sum += in_csr_values[i] * in_x[column];
+    }
+    y[row] = sum;
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Prepare the matrix-free mode.
+ *
+ * Compute the diagonal of the operator and apply the eliminations to the
+ * RHS. For row-column elimination, the eliminated values are moved to the
+ * RHS with one application of the operator (b -= A.x_eliminated).
+ */
+void NativeDoFLinearSystemImpl::
+_setupLinearOperator()
+{
+  if (m_is_parallel) {
+    m_dof_elimination_info.synchronize();
+    m_dof_elimination_value.synchronize();
+  }
+
+  m_operator_diagonal.resize(m_nb_row);
+  m_operator_forced_correction.resize(m_nb_row);
+  Span<Real> diagonal = m_operator_diagonal.to1DSpan();
+  Span<Real> forced_correction = m_operator_forced_correction.to1DSpan();
+  m_linear_operator->computeDiagonal(diagonal);
+
+  Span<Real> work = m_work_variable.asArray();
+  {
+    auto command = makeCommand(m_queue);
+    auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+    auto in_elimination_value = Accelerator::viewIn(command, m_dof_elimination_value);
+    auto in_forced_info = Accelerator::viewIn(command, m_dof_forced_info);
+    auto in_forced_value = Accelerator::viewIn(command, m_dof_forced_value);
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+    {
+      auto [i] = iter();
+      DoFLocalId dof_id(i);
+      auto elimination_info = in_elimination_info[dof_id];
+      work[i] = (elimination_info == ELIMINATE_ROW_COLUMN) ? in_elimination_value[dof_id] : 0.0;
+      Real correction = 0.0;
+      if (elimination_info == ELIMINATE_ROW || elimination_info == ELIMINATE_ROW_COLUMN)
+        diagonal[i] = 1.0;
+      else if (in_forced_info[dof_id]) {
+        correction = in_forced_value[dof_id] - diagonal[i];
+        diagonal[i] = in_forced_value[dof_id];
+      }
+      forced_correction[i] = correction;
+    };
+  }
+
+  // Apply the operator to the eliminated values (without the fix-up of
+  // _applyLinearOperator() because the columns have to be kept here).
+  NumArray<Real, MDDim1> lifting(m_nb_row);
+  Span<Real> lifting_span = lifting.to1DSpan();
+  if (m_is_parallel)
+    m_work_variable.synchronize();
+  m_linear_operator->apply(work, lifting_span);
+
+  auto command = makeCommand(m_queue);
+  auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+  auto in_elimination_value = Accelerator::viewIn(command, m_dof_elimination_value);
+  auto in_out_rhs_variable = Accelerator::viewInOut(command, m_rhs_variable);
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    DoFLocalId dof_id(i);
+    auto elimination_info = in_elimination_info[dof_id];
+    if (elimination_info == ELIMINATE_ROW || elimination_info == ELIMINATE_ROW_COLUMN)
+      in_out_rhs_variable[dof_id] = in_elimination_value[dof_id];
+    else
+      in_out_rhs_variable[dof_id] = in_out_rhs_variable[dof_id] - lifting_span[i];
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute y = A.x with the linear operator.
+ *
+ * The columns of row-column eliminated DoFs are removed by setting the
+ * corresponding values of \a x to zero. The rows of eliminated DoFs are
+ * the identity and the diagonal of forced DoFs is replaced by the forced
+ * value.
+ */
+void NativeDoFLinearSystemImpl::
+_applyLinearOperator(Span<const Real> x, Span<Real> y)
+{
+  Span<Real> work = m_work_variable.asArray();
+  {
+    auto command = makeCommand(m_queue);
+    auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+    {
+      auto [i] = iter();
+      work[i] = (in_elimination_info[DoFLocalId(i)] == ELIMINATE_ROW_COLUMN) ? 0.0 : x[i];
+    };
+  }
+  if (m_is_parallel)
+    m_work_variable.synchronize();
+
+  m_linear_operator->apply(work, y);
+
+  auto command = makeCommand(m_queue);
+  auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+  Span<const Real> forced_correction = m_operator_forced_correction.to1DSpan();
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    auto elimination_info = in_elimination_info[DoFLocalId(i)];
+    if (elimination_info == ELIMINATE_ROW || elimination_info == ELIMINATE_ROW_COLUMN)
+      y[i] = x[i];
+    else
+      y[i] += forced_correction[i] * x[i];
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Compute r = b - A.x
+void NativeDoFLinearSystemImpl::
+_residual(Span<const Real> b, Span<const Real> x, Span<Real> r)
+{
+  _spmv(x, r);
+  auto command = makeCommand(m_queue);
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    r[i] = b[i] - r[i];
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Dot product of \a a and \a b on all the own DoFs of all the sub-domains
+Real NativeDoFLinearSystemImpl::
+_dot(Span<const Real> a, Span<const Real> b)
+{
+  auto command = makeCommand(m_queue);
+  Accelerator::ReducerSum2<Real> reducer(command);
+  Span<const Byte> is_own = m_is_own.to1DSpan();
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row, reducer)
+  {
+    auto [i] = iter();
+    if (is_own[i])
+      reducer.combine(a[i] * b[i]);
+  };
+  Real v = reducer.reducedValue();
+  if (m_is_parallel)
+    v = m_parallel_mng->reduce(Parallel::ReduceSum, v);
+  return v;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+//! Compute y = y + alpha.x
+void NativeDoFLinearSystemImpl::
+_axpy(Real alpha, Span<const Real> x, Span<Real> y)
+{
+  auto command = makeCommand(m_queue);
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    y[i] += alpha * x[i];
+  };
+}
+
+//! Compute y = x + beta.y
+void NativeDoFLinearSystemImpl::
+_xpby(Span<const Real> x, Real beta, Span<Real> y)
+{
+  auto command = makeCommand(m_queue);
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    y[i] = x[i] + beta * y[i];
+  };
+}
+
+//! Compute y = alpha.x
+void NativeDoFLinearSystemImpl::
+_scale(Real alpha, Span<const Real> x, Span<Real> y)
+{
+  auto command = makeCommand(m_queue);
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    y[i] = alpha * x[i];
+  };
+}
+
+//! Compute y = x
+void NativeDoFLinearSystemImpl::
+_copy(Span<const Real> x, Span<Real> y)
+{
+  auto command = makeCommand(m_queue);
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    y[i] = x[i];
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+_setupPreconditioner()
+{
+  switch (m_preconditioner) {
+  case eNativePreconditioner::None:
+    break;
+  case eNativePreconditioner::Jacobi:
+    _computeInverseDiagonal();
+    break;
+  case eNativePreconditioner::BlockJacobi:
+    _computeInverseBlockDiagonal();
+    break;
+  case eNativePreconditioner::Chebyshev:
+    _computeInverseDiagonal();
+    _estimateMaxEigenValue();
+    break;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+_computeInverseDiagonal()
+{
+  m_inverse_diagonal.resize(m_nb_row);
+  if (m_linear_operator) {
+    auto command = makeCommand(m_queue);
+    Span<const Real> in_diagonal = m_operator_diagonal.to1DSpan();
+    Span<Real> out_inverse_diagonal = m_inverse_diagonal.to1DSpan();
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+    {
+      auto [row] = iter();
+      Real diagonal = in_diagonal[row];
+      out_inverse_diagonal[row] = (diagonal != 0.0) ? (1.0 / diagonal) : 1.0;
+    };
+    return;
+  }
+  auto command = makeCommand(m_queue);
+  Span<const Int32> in_csr_row = m_csr_view.rows();
+  Span<const Int32> in_csr_row_nb_column = m_csr_view.rowsNbColumn();
+  Span<const Int32> in_csr_columns = m_csr_view.columns();
+  Span<const Real> in_csr_values = m_csr_view.values();
+  Span<Real> out_inverse_diagonal = m_inverse_diagonal.to1DSpan();
+
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [row] = iter();
+    Int32 begin = in_csr_row[row];
+    Int32 index = FemUtils::Gpu::Csr::findIndex(begin, begin + in_csr_row_nb_column[row], row, in_csr_columns);
+    Real diagonal = (index >= 0) ? in_csr_values[index] : 0.0;
+    out_inverse_diagonal[row] = (diagonal != 0.0) ? (1.0 / diagonal) : 1.0;
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the inverse of the diagonal blocks of the matrix.
+ *
+ * The block of a node is the (block_size x block_size) sub-matrix
+ * of its DoFs. It is inverted with Gauss-Jordan elimination with partial
+ * pivoting. If a block is singular, the inverse of its diagonal is used.
+ */
+void NativeDoFLinearSystemImpl::
+_computeInverseBlockDiagonal()
+{
+  if (m_linear_operator)
+    ARCANE_FATAL("Preconditioner 'block-jacobi' needs an assembled matrix (not available with a linear operator)");
+  const Int32 block_size = m_block_size;
+  if (block_size > MAX_BLOCK_SIZE)
+    ARCANE_FATAL("Block size '{0}' is too big for block-jacobi (max={1})", block_size, MAX_BLOCK_SIZE);
+  if ((m_nb_row % block_size) != 0)
+    ARCANE_FATAL("The number of rows '{0}' is not a multiple of the block size '{1}'", m_nb_row, block_size);
+  const Int32 nb_block = m_nb_row / block_size;
+  m_inverse_block_diagonal.resize(nb_block * block_size * block_size);
+
+  auto command = makeCommand(m_queue);
+  Span<const Int32> in_csr_row = m_csr_view.rows();
+  Span<const Int32> in_csr_row_nb_column = m_csr_view.rowsNbColumn();
+  Span<const Int32> in_csr_columns = m_csr_view.columns();
+  Span<const Real> in_csr_values = m_csr_view.values();
+  Span<Real> out_inverse = m_inverse_block_diagonal.to1DSpan();
+
+  command << RUNCOMMAND_LOOP1(iter, nb_block)
+  {
+    auto [block] = iter();
+    const Int32 first_row = block * block_size;
+    Real a[MAX_BLOCK_SIZE][MAX_BLOCK_SIZE];
+    Real inv[MAX_BLOCK_SIZE][MAX_BLOCK_SIZE];
+    for (Int32 i = 0; i < block_size; ++i) {
+      for (Int32 j = 0; j < block_size; ++j) {
+        a[i][j] = 0.0;
+        inv[i][j] = (i == j) ? 1.0 : 0.0;
+      }
+      Int32 begin = in_csr_row[first_row + i];
+      Int32 end = begin + in_csr_row_nb_column[first_row + i];
+      for (Int32 k = begin; k < end; ++k) {
+        Int32 j = in_csr_columns[k] - first_row;
+        if (j >= 0 && j < block_size)
+          a[i][j] += in_csr_values[k];
+      }
+    }
+
+    bool is_singular = false;
+    for (Int32 c = 0; c < block_size && !is_singular; ++c) {
+      Int32 pivot = c;
+      for (Int32 i = c + 1; i < block_size; ++i)
+        if (math::abs(a[i][c]) > math::abs(a[pivot][c]))
+          pivot = i;
+      if (a[pivot][c] == 0.0) {
+        is_singular = true;
+        break;
+      }
+      if (pivot != c) {
+        for (Int32 j = 0; j < block_size; ++j) {
+          Real t = a[c][j];
+          a[c][j] = a[pivot][j];
+          a[pivot][j] = t;
+          t = inv[c][j];
+          inv[c][j] = inv[pivot][j];
+          inv[pivot][j] = t;
+        }
+      }
+      const Real inv_pivot = 1.0 / a[c][c];
+      for (Int32 j = 0; j < block_size; ++j) {
+        a[c][j] *= inv_pivot;
+        inv[c][j] *= inv_pivot;
+      }
+      for (Int32 i = 0; i < block_size; ++i) {
+        if (i == c)
+          continue;
+        const Real f = a[i][c];
+        for (Int32 j = 0; j < block_size; ++j) {
+          a[i][j] -= f * a[c][j];
+          inv[i][j] -= f * inv[c][j];
+        }
+      }
+    }
+
+    const Int32 offset = block * block_size * block_size;
+    for (Int32 i = 0; i < block_size; ++i) {
+      for (Int32 j = 0; j < block_size; ++j) {
+        Real v = inv[i][j];
+        if (is_singular) {
+          // Use the inverse of the diagonal of the original block
+          v = 0.0;
+          if (i == j) {
+            Int32 begin = in_csr_row[first_row + i];
+            Int32 index = FemUtils::Gpu::Csr::findIndex(begin, begin + in_csr_row_nb_column[first_row + i], first_row + i, in_csr_columns);
+            Real d = (index >= 0) ? in_csr_values[index] : 0.0;
+            v = (d != 0.0) ? (1.0 / d) : 1.0;
+          }
+        }
+        out_inverse[offset + i * block_size + j] = v;
+      }
+    }
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Estimate the largest eigenvalue of D^-1.A with power iterations.
+ */
+void NativeDoFLinearSystemImpl::
+_estimateMaxEigenValue()
+{
+  const Int32 nb_power_iteration = 10;
+  NumArray<Real, MDDim1> v(m_nb_row);
+  NumArray<Real, MDDim1> w(m_nb_row);
+  Span<Real> v_span = v.to1DSpan();
+  Span<Real> w_span = w.to1DSpan();
+
+  {
+    // Deterministic starting vector with components of both signs
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+    {
+      auto [i] = iter();
+      v_span[i] = static_cast<Real>((i * 7919) % 17 - 8) / 8.0 + 0.1;
+    };
+  }
+
+  Real eigen_value = 1.0;
+  Real v_norm = math::sqrt(_dot(v_span, v_span));
+  for (Int32 k = 0; k < nb_power_iteration && v_norm > 0.0; ++k) {
+    _scale(1.0 / v_norm, v_span, v_span);
+    _spmv(v_span, w_span);
+    _applyDiagonal(w_span, v_span);
+    v_norm = math::sqrt(_dot(v_span, v_span));
+    eigen_value = v_norm;
+  }
+  // Safety factor because the power method underestimates the eigenvalue
+  m_max_eigen_value = 1.1 * eigen_value;
+  if (m_verbosity > 0)
+    info() << "[Native-Info] Chebyshev max_eigen_value=" << m_max_eigen_value
+           << " min_eigen_value=" << (m_max_eigen_value / m_chebyshev_eigen_ratio);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+_applyPreconditioner(Span<const Real> r, Span<Real> z)
+{
+  switch (m_preconditioner) {
+  case eNativePreconditioner::None:
+    _copy(r, z);
+    break;
+  case eNativePreconditioner::Jacobi:
+    _applyDiagonal(r, z);
+    break;
+  case eNativePreconditioner::BlockJacobi:
+    _applyBlockDiagonal(r, z);
+    break;
+  case eNativePreconditioner::Chebyshev:
+    _applyChebyshev(r, z);
+    break;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+_applyDiagonal(Span<const Real> r, Span<Real> z)
+{
+  auto command = makeCommand(m_queue);
+  Span<const Real> inverse_diagonal = m_inverse_diagonal.to1DSpan();
+  command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+  {
+    auto [i] = iter();
+    z[i] = inverse_diagonal[i] * r[i];
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+_applyBlockDiagonal(Span<const Real> r, Span<Real> z)
+{
+  const Int32 block_size = m_block_size;
+  const Int32 nb_block = m_nb_row / block_size;
+  auto command = makeCommand(m_queue);
+  Span<const Real> inverse = m_inverse_block_diagonal.to1DSpan();
+  command << RUNCOMMAND_LOOP1(iter, nb_block)
+  {
+    auto [block] = iter();
+    const Int32 first_row = block * block_size;
+    const Int32 offset = block * block_size * block_size;
+    for (Int32 i = 0; i < block_size; ++i) {
+      Real sum = 0.0;
+      for (Int32 j = 0; j < block_size; ++j)
+        sum += inverse[offset + i * block_size + j] * r[first_row + j];
+      z[first_row + i] = sum;
+    }
+  };
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Apply the Chebyshev polynomial preconditioner.
+ *
+ * Compute z = p(D^-1.A) D^-1.r where p is the Chebyshev polynomial on the
+ * interval [max_eigen_value / eigen_ratio, max_eigen_value]. The
+ * polynomial is fixed so the preconditioner can be used with CG.
+ */
+void NativeDoFLinearSystemImpl::
+_applyChebyshev(Span<const Real> r, Span<Real> z)
+{
+  const Real max_eigen_value = m_max_eigen_value;
+  const Real min_eigen_value = max_eigen_value / m_chebyshev_eigen_ratio;
+  const Real theta = 0.5 * (max_eigen_value + min_eigen_value);
+  const Real delta = 0.5 * (max_eigen_value - min_eigen_value);
+  const Real sigma = theta / delta;
+  Real rho = 1.0 / sigma;
+
+  m_precond_work1.resize(m_nb_row);
+  m_precond_work2.resize(m_nb_row);
+  Span<Real> d = m_precond_work1.to1DSpan();
+  Span<Real> residual = m_precond_work2.to1DSpan();
+  Span<const Real> inverse_diagonal = m_inverse_diagonal.to1DSpan();
+
+  // d = D^-1.r / theta and z = d
+  {
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+    {
+      auto [i] = iter();
+      Real v = inverse_diagonal[i] * r[i] / theta;
+      d[i] = v;
+      z[i] = v;
+    };
+  }
+
+  for (Int32 k = 1; k < m_chebyshev_degree; ++k) {
+    _residual(r, z, residual);
+    const Real new_rho = 1.0 / (2.0 * sigma - rho);
+    const Real d_factor = new_rho * rho;
+    const Real r_factor = 2.0 * new_rho / delta;
+    auto command = makeCommand(m_queue);
+    command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+    {
+      auto [i] = iter();
+      Real v = d_factor * d[i] + r_factor * inverse_diagonal[i] * residual[i];
+      d[i] = v;
+      z[i] += v;
+    };
+    rho = new_rho;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Preconditioned conjugate gradient.
+ */
+Int32 NativeDoFLinearSystemImpl::
+_solveCG(Span<const Real> b, Span<Real> x, Real rhs_norm, Real& residual_norm)
+{
+  NumArray<Real, MDDim1> r_array(m_nb_row);
+  NumArray<Real, MDDim1> z_array(m_nb_row);
+  NumArray<Real, MDDim1> p_array(m_nb_row);
+  NumArray<Real, MDDim1> q_array(m_nb_row);
+  Span<Real> r = r_array.to1DSpan();
+  Span<Real> z = z_array.to1DSpan();
+  Span<Real> p = p_array.to1DSpan();
+  Span<Real> q = q_array.to1DSpan();
+
+  _residual(b, x, r);
+  residual_norm = math::sqrt(_dot(r, r));
+  if (_isConverged(residual_norm, rhs_norm))
+    return 0;
+
+  _applyPreconditioner(r, z);
+  _copy(z, p);
+  Real rz = _dot(r, z);
+
+  Int32 iteration = 0;
+  while (iteration < m_max_iter) {
+    ++iteration;
+    _spmv(p, q);
+    const Real pq = _dot(p, q);
+    if (pq == 0.0)
+      break;
+    const Real alpha = rz / pq;
+    _axpy(alpha, p, x);
+    _axpy(-alpha, q, r);
+    residual_norm = math::sqrt(_dot(r, r));
+    _printIteration("CG", iteration, residual_norm, rhs_norm);
+    if (_isConverged(residual_norm, rhs_norm))
+      break;
+    _applyPreconditioner(r, z);
+    const Real new_rz = _dot(r, z);
+    const Real beta = new_rz / rz;
+    rz = new_rz;
+    _xpby(z, beta, p);
+  }
+  return iteration;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Right preconditioned BiCGSTAB.
+ */
+Int32 NativeDoFLinearSystemImpl::
+_solveBiCGSTAB(Span<const Real> b, Span<Real> x, Real rhs_norm, Real& residual_norm)
+{
+  NumArray<Real, MDDim1> r_array(m_nb_row);
+  NumArray<Real, MDDim1> r_hat_array(m_nb_row);
+  NumArray<Real, MDDim1> p_array(m_nb_row);
+  NumArray<Real, MDDim1> p_hat_array(m_nb_row);
+  NumArray<Real, MDDim1> v_array(m_nb_row);
+  NumArray<Real, MDDim1> s_hat_array(m_nb_row);
+  NumArray<Real, MDDim1> t_array(m_nb_row);
+  Span<Real> r = r_array.to1DSpan();
+  Span<Real> r_hat = r_hat_array.to1DSpan();
+  Span<Real> p = p_array.to1DSpan();
+  Span<Real> p_hat = p_hat_array.to1DSpan();
+  Span<Real> v = v_array.to1DSpan();
+  Span<Real> s_hat = s_hat_array.to1DSpan();
+  Span<Real> t = t_array.to1DSpan();
+
+  _residual(b, x, r);
+  residual_norm = math::sqrt(_dot(r, r));
+  if (_isConverged(residual_norm, rhs_norm))
+    return 0;
+  _copy(r, r_hat);
+
+  Real rho = 1.0;
+  Real alpha = 1.0;
+  Real omega = 1.0;
+  Int32 iteration = 0;
+  while (iteration < m_max_iter) {
+    ++iteration;
+    const Real new_rho = _dot(r_hat, r);
+    if (new_rho == 0.0)
+      break;
+    if (iteration == 1)
+      _copy(r, p);
+    else {
+      // p = r + beta * (p - omega * v)
+      const Real beta = (new_rho / rho) * (alpha / omega);
+      auto command = makeCommand(m_queue);
+      command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+      {
+        auto [i] = iter();
+        p[i] = r[i] + beta * (p[i] - omega * v[i]);
+      };
+    }
+    rho = new_rho;
+
+    _applyPreconditioner(p, p_hat);
+    _spmv(p_hat, v);
+    const Real r_hat_v = _dot(r_hat, v);
+    if (r_hat_v == 0.0)
+      break;
+    alpha = rho / r_hat_v;
+
+    // s = r - alpha * v (stored in r)
+    _axpy(-alpha, v, r);
+    _axpy(alpha, p_hat, x);
+    residual_norm = math::sqrt(_dot(r, r));
+    if (_isConverged(residual_norm, rhs_norm)) {
+      _printIteration("BiCGSTAB", iteration, residual_norm, rhs_norm);
+      break;
+    }
+
+    _applyPreconditioner(r, s_hat);
+    _spmv(s_hat, t);
+    const Real tt = _dot(t, t);
+    omega = (tt != 0.0) ? (_dot(t, r) / tt) : 0.0;
+    _axpy(omega, s_hat, x);
+    _axpy(-omega, t, r);
+    residual_norm = math::sqrt(_dot(r, r));
+    _printIteration("BiCGSTAB", iteration, residual_norm, rhs_norm);
+    if (_isConverged(residual_norm, rhs_norm) || omega == 0.0)
+      break;
+  }
+  return iteration;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Restarted GMRES with right preconditioning.
+ *
+ * The orthogonalization uses the modified Gram-Schmidt method and the
+ * Hessenberg matrix is reduced with Givens rotations.
+ */
+Int32 NativeDoFLinearSystemImpl::
+_solveGMRES(Span<const Real> b, Span<Real> x, Real rhs_norm, Real& residual_norm)
+{
+  const Int32 m = math::max(m_krylov_dim, 1);
+  const Int32 nb_row = m_nb_row;
+  NumArray<Real, MDDim2> basis(m + 1, nb_row);
+  NumArray<Real, MDDim1> w_array(nb_row);
+  NumArray<Real, MDDim1> z_array(nb_row);
+  Span<Real> w = w_array.to1DSpan();
+  Span<Real> z = z_array.to1DSpan();
+  auto basis_vector = [&](Int32 j) { return basis.to1DSpan().subSpan(j * nb_row, nb_row); };
+
+  UniqueArray<Real> h((m + 1) * m);
+  UniqueArray<Real> g(m + 1);
+  UniqueArray<Real> cs(m);
+  UniqueArray<Real> sn(m);
+  UniqueArray<Real> y(m);
+
+  Int32 iteration = 0;
+  bool is_converged = false;
+  while (!is_converged && iteration < m_max_iter) {
+    Span<Real> v0 = basis_vector(0);
+    _residual(b, x, v0);
+    Real beta = math::sqrt(_dot(v0, v0));
+    residual_norm = beta;
+    if (_isConverged(residual_norm, rhs_norm))
+      break;
+    _scale(1.0 / beta, v0, v0);
+    g.fill(0.0);
+    g[0] = beta;
+
+    Int32 nb_vector = 0;
+    for (Int32 j = 0; j < m && iteration < m_max_iter; ++j) {
+      ++iteration;
+      _applyPreconditioner(basis_vector(j), z);
+      _spmv(z, w);
+      for (Int32 i = 0; i <= j; ++i) {
+        Span<Real> vi = basis_vector(i);
+        Real hij = _dot(w, vi);
+        h[i * m + j] = hij;
+        _axpy(-hij, vi, w);
+      }
+      Real h_next = math::sqrt(_dot(w, w));
+      h[(j + 1) * m + j] = h_next;
+      if (h_next != 0.0)
+        _scale(1.0 / h_next, w, basis_vector(j + 1));
+
+      // Apply the previous rotations to the new column
+      for (Int32 i = 0; i < j; ++i) {
+        Real a = h[i * m + j];
+        Real c = h[(i + 1) * m + j];
+        h[i * m + j] = cs[i] * a + sn[i] * c;
+        h[(i + 1) * m + j] = -sn[i] * a + cs[i] * c;
+      }
+      // Compute the new rotation
+      Real a = h[j * m + j];
+      Real c = h[(j + 1) * m + j];
+      Real norm = math::sqrt(a * a + c * c);
+      cs[j] = (norm != 0.0) ? (a / norm) : 1.0;
+      sn[j] = (norm != 0.0) ? (c / norm) : 0.0;
+      h[j * m + j] = norm;
+      h[(j + 1) * m + j] = 0.0;
+      g[j + 1] = -sn[j] * g[j];
+      g[j] = cs[j] * g[j];
+
+      nb_vector = j + 1;
+      residual_norm = math::abs(g[j + 1]);
+      _printIteration("GMRES", iteration, residual_norm, rhs_norm);
+      if (_isConverged(residual_norm, rhs_norm) || h_next == 0.0) {
+        is_converged = _isConverged(residual_norm, rhs_norm);
+        break;
+      }
+    }
+
+    // Solve the upper triangular system H.y = g
+    for (Int32 i = nb_vector - 1; i >= 0; --i) {
+      Real v = g[i];
+      for (Int32 k = i + 1; k < nb_vector; ++k)
+        v -= h[i * m + k] * y[k];
+      y[i] = (h[i * m + i] != 0.0) ? (v / h[i * m + i]) : 0.0;
+    }
+    // x = x + M^-1.(V.y)
+    _scale(0.0, w, w);
+    for (Int32 i = 0; i < nb_vector; ++i)
+      _axpy(y[i], basis_vector(i), w);
+    _applyPreconditioner(w, z);
+    _axpy(1.0, z, x);
+  }
+  // Compute the true residual
+  _residual(b, x, w);
+  residual_norm = math::sqrt(_dot(w, w));
+  return iteration;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+/*!
+ * \brief Apply the eliminations and the forced values to the matrix and
+ * setup the preconditioner.
+ */
+void NativeDoFLinearSystemImpl::
+_setupSystem(Real& matrix_build_time, Real& setup_time)
+{
+  if (!m_linear_operator && m_assembled_csr_view.nbRow() == 0)
+    ARCANE_FATAL("NativeLinearSystem needs the matrix in CSR format (call setCSRValues()) or a linear operator");
+
+  m_parallel_mng = m_dof_family->parallelMng();
+  m_is_parallel = m_parallel_mng->isParallel();
+  m_nb_row = m_dof_family->nbItem();
+  m_queue = makeQueue(m_runner);
+
+  Real build_begin = platform::getRealTime();
+  if (m_linear_operator) {
+    _setupLinearOperator();
+  }
+  else {
+    if (m_assembled_csr_view.nbRow() != m_nb_row)
+      ARCANE_FATAL("Bad number of rows in CSR matrix (nb_row={0} nb_dof={1})", m_assembled_csr_view.nbRow(), m_nb_row);
+    _selectMatrixValues();
+    _applyElimination();
+    _applyForcedValuesToLhs();
+  }
+  matrix_build_time = platform::getRealTime() - build_begin;
+
+  m_is_own.resize(m_nb_row);
+  m_is_own.fill(0);
+  ENUMERATE_DOF (idof, m_dof_family->allItems().own()) {
+    m_is_own[idof.itemLocalId()] = 1;
+  }
+
+  Real setup_begin = platform::getRealTime();
+  _setupPreconditioner();
+  setup_time = platform::getRealTime() - setup_begin;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Solve A.x = b with the solver set up by _setupSystem().
+ *
+ * The values of \a x are used as initial guess.
+ */
+SolveReport NativeDoFLinearSystemImpl::
+_solveRhs(Span<const Real> b, Span<Real> x)
+{
+  Real rhs_norm = math::sqrt(_dot(b, b));
+  if (rhs_norm == 0.0)
+    rhs_norm = 1.0;
+
+  Real solve_begin = platform::getRealTime();
+  Real residual_norm = 0.0;
+  Int32 nb_iteration = 0;
+  switch (m_solver_method) {
+  case eNativeSolver::CG:
+    nb_iteration = _solveCG(b, x, rhs_norm, residual_norm);
+    break;
+  case eNativeSolver::BiCGSTAB:
+    nb_iteration = _solveBiCGSTAB(b, x, rhs_norm, residual_norm);
+    break;
+  case eNativeSolver::GMRES:
+    nb_iteration = _solveGMRES(b, x, rhs_norm, residual_norm);
+    break;
+  }
+  Real solve_time = platform::getRealTime() - solve_begin;
+
+  const bool is_converged = _isConverged(residual_norm, rhs_norm);
+
+  // The solver works directly on the CSR view and the DoF variables so
+  // there is no transfer (the values copied by _selectMatrixValues() stay
+  // in the memory of the queue).
+  SolveReport report;
+  report.linear_system_name = "Native";
+  report.nb_iteration = nb_iteration;
+  report.residual = residual_norm / rhs_norm;
+  report.is_converged = is_converged;
+  report.solve_time = solve_time;
+  report.nb_transferred_byte = 0;
+  if (m_verbosity > 0)
+    info() << "[Native-Info] Solver=" << (int)m_solver_method
+           << " MatrixFree=" << (m_linear_operator != nullptr)
+           << " Preconditioner=" << (int)m_preconditioner
+           << " nb_iteration=" << nb_iteration << " residual=" << report.residual
+           << " converged=" << is_converged << " solve_time=" << solve_time;
+  if (!is_converged)
+    pwarning() << "[Native-Info] Linear solver did not converge nb_iteration=" << nb_iteration
+               << " residual=" << report.residual;
+  return report;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void NativeDoFLinearSystemImpl::
+solve()
+{
+  Real matrix_build_time = 0.0;
+  Real setup_time = 0.0;
+  _setupSystem(matrix_build_time, setup_time);
+
+  // The current solution is used as initial guess
+  NumArray<Real, MDDim1> x_array(m_nb_row);
+  Span<Real> x = x_array.to1DSpan();
+  _copy(m_dof_variable.asArray(), x);
+
+  m_solve_report = _solveRhs(m_rhs_variable.asArray(), x);
+  m_solve_report.matrix_build_time = matrix_build_time;
+  m_solve_report.setup_time = setup_time;
+
+  _copy(x, m_dof_variable.asArray());
+  if (m_is_parallel)
+    m_dof_variable.synchronize();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Solve the system for all the columns of \a rhs.
+ *
+ * The system is set up with a null RHS so that the RHS variable only
+ * contains the contribution of the eliminations, which is the same for all
+ * the RHS. Then the Krylov solver is called for each RHS with the same
+ * matrix and preconditioner.
+ */
+void NativeDoFLinearSystemImpl::
+solveMultipleRhs(VariableDoFArrayReal& rhs, VariableDoFArrayReal& solution)
+{
+  const Int32 nb_rhs = rhs.arraySize();
+
+  m_rhs_variable.fill(0.0);
+  Real matrix_build_time = 0.0;
+  Real setup_time = 0.0;
+  _setupSystem(matrix_build_time, setup_time);
+
+  NumArray<Real, MDDim1> b_array(m_nb_row);
+  NumArray<Real, MDDim1> x_array(m_nb_row);
+  Span<Real> b = b_array.to1DSpan();
+  Span<Real> x = x_array.to1DSpan();
+
+  for (Int32 k = 0; k < nb_rhs; ++k) {
+    {
+      auto command = makeCommand(m_queue);
+      auto in_elimination_info = Accelerator::viewIn(command, m_dof_elimination_info);
+      auto in_rhs_correction = Accelerator::viewIn(command, m_rhs_variable);
+      auto in_rhs = Accelerator::viewIn(command, rhs);
+      auto in_solution = Accelerator::viewIn(command, solution);
+      command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+      {
+        auto [i] = iter();
+        DoFLocalId dof_id(i);
+        Real value = in_rhs_correction[dof_id];
+        if (in_elimination_info[dof_id] == ELIMINATE_NONE)
+          value += in_rhs[dof_id][k];
+        b[i] = value;
+        x[i] = in_solution[dof_id][k];
+      };
+    }
+
+    SolveReport report = _solveRhs(b, x);
+    if (k == 0)
+      m_solve_report = report;
+    else
+      m_solve_report.merge(report);
+
+    {
+      auto command = makeCommand(m_queue);
+      auto out_solution = Accelerator::viewOut(command, solution);
+      command << RUNCOMMAND_LOOP1(iter, m_nb_row)
+      {
+        auto [i] = iter();
+        out_solution[DoFLocalId(i)][k] = x[i];
+      };
+    }
+  }
+  if (m_is_parallel)
+    solution.synchronize();
+
+  m_solve_report.matrix_build_time = matrix_build_time;
+  m_solve_report.setup_time = setup_time;
+  m_solve_report.nb_rhs = nb_rhs;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+class NativeDoFLinearSystemFactoryService
+: public ArcaneNativeDoFLinearSystemFactoryObject
+{
+ public:
+
+  explicit NativeDoFLinearSystemFactoryService(const ServiceBuildInfo& sbi)
+  : ArcaneNativeDoFLinearSystemFactoryObject(sbi)
+  {
+  }
+
+  DoFLinearSystemImpl*
+  createInstance(ISubDomain* sd, IItemFamily* dof_family, const String& solver_name) override
+  {
+    auto* x = new NativeDoFLinearSystemImpl(dof_family, solver_name);
+    x->setSolverMethod(options()->solver());
+    x->setPreconditioner(options()->preconditioner());
+    x->setRelTolerance(options()->rtol());
+    x->setAbsTolerance(options()->atol());
+    x->setMaxIter(options()->maxIter());
+    x->setKrylovDim(options()->krylovDim());
+    x->setChebyshevDegree(options()->chebyshevDegree());
+    x->setChebyshevEigenRatio(options()->chebyshevEigenRatio());
+    x->setVerbosityLevel(options()->verbosity());
+    return x;
+  }
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_SERVICE_NATIVEDOFLINEARSYSTEMFACTORY(NativeLinearSystem,
+                                                     NativeDoFLinearSystemFactoryService);
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
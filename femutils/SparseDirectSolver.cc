@@ -0,0 +1,445 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SparseDirectSolver.cc                                       (C) 2022-2025 */
+/*                                                                           */
+/* Sparse LU/LDLt direct solver with fill-reducing ordering.                 */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "SparseDirectSolver.h"
+
+#include <arcane/utils/FatalErrorException.h>
+#include <arcane/utils/PlatformUtils.h>
+#include <arcane/utils/Math.h>
+
+#include <algorithm>
+#include <functional>
+#include <iterator>
+#include <queue>
+#include <vector>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+bool SparseDirectSolver::
+factorize(Int32 nb_row, Span<const Int32> rows_index,
+          Span<const Int32> columns, Span<const Real> values)
+{
+  if (rows_index.size() != (nb_row + 1))
+    ARCANE_FATAL("Bad size for rows index (size={0} expected={1})", rows_index.size(), nb_row + 1);
+
+  const bool is_same_structure = m_is_factorized && nb_row == m_nb_row &&
+  std::equal(rows_index.begin(), rows_index.end(), m_rows_index.begin(), m_rows_index.end()) &&
+  std::equal(columns.begin(), columns.end(), m_columns.begin(), m_columns.end());
+
+  if (is_same_structure && m_is_reuse_factorization &&
+      std::equal(values.begin(), values.end(), m_values.begin(), m_values.end())) {
+    info() << "[SparseDirect-Info] Matrix has not changed. Reusing factorization";
+    return false;
+  }
+
+  Real begin_time = platform::getRealTime();
+  if (!is_same_structure) {
+    m_is_factorized = false;
+    m_nb_row = nb_row;
+    m_rows_index.copy(rows_index);
+    m_columns.copy(columns);
+    _computeOrdering();
+    _computeSymmetricStructure();
+    _computeSymbolicFactorization();
+  }
+  Real symbolic_time = platform::getRealTime() - begin_time;
+
+  m_values.copy(values);
+  _fillSymmetricValues();
+  _computeNumericFactorization();
+  m_is_factorized = true;
+  Real numeric_time = platform::getRealTime() - begin_time - symbolic_time;
+
+  info() << "[SparseDirect-Info] nb_row=" << m_nb_row << " nb_value=" << m_columns.size()
+         << " nb_factor_value=" << nbFactorValue() << " symmetric=" << m_is_symmetric
+         << " reuse_symbolic=" << is_same_structure << " symbolic_time=" << symbolic_time
+         << " numeric_time=" << numeric_time;
+  return true;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void SparseDirectSolver::
+clear()
+{
+  m_is_factorized = false;
+  m_nb_row = 0;
+  m_rows_index.clear();
+  m_columns.clear();
+  m_values.clear();
+  m_factor_rows.clear();
+  m_l_values.clear();
+  m_u_values.clear();
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void SparseDirectSolver::
+_computeOrdering()
+{
+  const Int32 nb_row = m_nb_row;
+  m_permutation.resize(nb_row);
+  if (m_ordering == eSparseDirectOrdering::MinimumDegree)
+    _computeMinimumDegreeOrdering();
+  else
+    for (Int32 i = 0; i < nb_row; ++i)
+      m_permutation[i] = i;
+
+  m_inverse_permutation.resize(nb_row);
+  for (Int32 i = 0; i < nb_row; ++i)
+    m_inverse_permutation[m_permutation[i]] = i;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Minimum degree ordering.
+ *
+ * The graph used is the one of A+At. At each step the node with the
+ * smallest degree is eliminated and its neighbors become a clique
+ * (elimination graph). The nodes with the same degree are taken in the
+ * order of their index so the ordering is deterministic.
+ */
+void SparseDirectSolver::
+_computeMinimumDegreeOrdering()
+{
+  const Int32 nb_row = m_nb_row;
+  std::vector<std::vector<Int32>> adjacency(nb_row);
+  for (Int32 r = 0; r < nb_row; ++r) {
+    for (Int32 i = m_rows_index[r], n = m_rows_index[r + 1]; i < n; ++i) {
+      Int32 c = m_columns[i];
+      if (c == r)
+        continue;
+      adjacency[r].push_back(c);
+      adjacency[c].push_back(r);
+    }
+  }
+  for (auto& x : adjacency) {
+    std::sort(x.begin(), x.end());
+    x.erase(std::unique(x.begin(), x.end()), x.end());
+  }
+
+  using DegreeAndNode = std::pair<Int32, Int32>;
+  std::priority_queue<DegreeAndNode, std::vector<DegreeAndNode>, std::greater<DegreeAndNode>> queue;
+  for (Int32 r = 0; r < nb_row; ++r)
+    queue.push(std::make_pair(static_cast<Int32>(adjacency[r].size()), r));
+
+  UniqueArray<Byte> is_eliminated(nb_row);
+  is_eliminated.fill(0);
+  std::vector<Int32> merged;
+  Int32 index = 0;
+  while (!queue.empty()) {
+    auto [degree, p] = queue.top();
+    queue.pop();
+    // Entries with an old degree are skipped (lazy update of the queue)
+    if (is_eliminated[p] || degree != static_cast<Int32>(adjacency[p].size()))
+      continue;
+    is_eliminated[p] = 1;
+    m_permutation[index] = p;
+    ++index;
+
+    // Neighbors only contain non eliminated nodes because
+    // eliminated nodes are removed from the lists below.
+    const std::vector<Int32>& neighbors = adjacency[p];
+    for (Int32 u : neighbors) {
+      merged.clear();
+      std::set_union(adjacency[u].begin(), adjacency[u].end(), neighbors.begin(), neighbors.end(),
+                     std::back_inserter(merged));
+      merged.erase(std::remove_if(merged.begin(), merged.end(), [=](Int32 x) { return x == u || x == p; }),
+                   merged.end());
+      adjacency[u].swap(merged);
+      queue.push(std::make_pair(static_cast<Int32>(adjacency[u].size()), u));
+    }
+    adjacency[p].clear();
+    adjacency[p].shrink_to_fit();
+  }
+  if (index != nb_row)
+    ARCANE_FATAL("Internal error in minimum degree ordering (index={0} nb_row={1})", index, nb_row);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the structure of the upper part of P.(A+At).Pt by column.
+ *
+ * The diagonal is always present. Each value of the CSR matrix is
+ * associated to one entry of this structure (upper or lower value) so that
+ * the values can be filled again without searching.
+ */
+void SparseDirectSolver::
+_computeSymmetricStructure()
+{
+  const Int32 nb_row = m_nb_row;
+  const Int32 nb_value = m_columns.size();
+
+  struct Entry
+  {
+    Int32 row;
+    Int32 value_index;
+    bool is_lower;
+  };
+
+  // Bucket the values by column of the permuted matrix. One more entry
+  // per column is used for the diagonal.
+  UniqueArray<Int32> bucket_index(nb_row + 1);
+  bucket_index.fill(0);
+  for (Int32 r = 0; r < nb_row; ++r) {
+    Int32 pr = m_inverse_permutation[r];
+    for (Int32 i = m_rows_index[r], n = m_rows_index[r + 1]; i < n; ++i) {
+      Int32 pc = m_inverse_permutation[m_columns[i]];
+      ++bucket_index[math::max(pr, pc) + 1];
+    }
+  }
+  for (Int32 k = 0; k < nb_row; ++k)
+    bucket_index[k + 1] += bucket_index[k] + 1;
+
+  std::vector<Entry> entries(nb_value + nb_row);
+  UniqueArray<Int32> position(nb_row);
+  for (Int32 k = 0; k < nb_row; ++k) {
+    entries[bucket_index[k]] = Entry{ k, -1, false };
+    position[k] = bucket_index[k] + 1;
+  }
+  for (Int32 r = 0; r < nb_row; ++r) {
+    Int32 pr = m_inverse_permutation[r];
+    for (Int32 i = m_rows_index[r], n = m_rows_index[r + 1]; i < n; ++i) {
+      Int32 pc = m_inverse_permutation[m_columns[i]];
+      if (pr <= pc)
+        entries[position[pc]++] = Entry{ pr, i, false };
+      else
+        entries[position[pr]++] = Entry{ pc, i, true };
+    }
+  }
+
+  m_value_positions.resize(nb_value);
+  m_sym_columns_index.resize(nb_row + 1);
+  m_sym_rows.clear();
+  m_sym_rows.reserve(nb_value / 2 + nb_row);
+  m_sym_columns_index[0] = 0;
+  for (Int32 k = 0; k < nb_row; ++k) {
+    auto begin = entries.begin() + bucket_index[k];
+    auto end = entries.begin() + bucket_index[k + 1];
+    std::sort(begin, end, [](const Entry& a, const Entry& b) { return a.row < b.row; });
+    Int32 last_row = -1;
+    for (auto x = begin; x != end; ++x) {
+      if (x->row != last_row) {
+        m_sym_rows.add(x->row);
+        last_row = x->row;
+      }
+      Int32 sym_index = m_sym_rows.size() - 1;
+      if (x->value_index >= 0)
+        m_value_positions[x->value_index] = (x->is_lower) ? -(sym_index + 1) : sym_index;
+    }
+    m_sym_columns_index[k + 1] = m_sym_rows.size();
+  }
+  m_upper_values.resize(m_sym_rows.size());
+  m_lower_values.resize(m_sym_rows.size());
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute the elimination tree and the number of values of each
+ * column of L.
+ */
+void SparseDirectSolver::
+_computeSymbolicFactorization()
+{
+  const Int32 nb_row = m_nb_row;
+  m_parent.resize(nb_row);
+  UniqueArray<Int32> flag(nb_row);
+  UniqueArray<Int32> nb_value_in_column(nb_row);
+  nb_value_in_column.fill(0);
+
+  for (Int32 k = 0; k < nb_row; ++k) {
+    m_parent[k] = -1;
+    flag[k] = k;
+    for (Int32 p = m_sym_columns_index[k], n = m_sym_columns_index[k + 1]; p < n; ++p) {
+      Int32 i = m_sym_rows[p];
+      if (i >= k)
+        continue;
+      // Follow the path from i to the root of the sub-tree in the elimination tree
+      for (; flag[i] != k; i = m_parent[i]) {
+        if (m_parent[i] == -1)
+          m_parent[i] = k;
+        ++nb_value_in_column[i];
+        flag[i] = k;
+      }
+    }
+  }
+
+  m_factor_columns_index.resize(nb_row + 1);
+  m_factor_columns_index[0] = 0;
+  for (Int32 k = 0; k < nb_row; ++k)
+    m_factor_columns_index[k + 1] = m_factor_columns_index[k] + nb_value_in_column[k];
+  Int32 nb_factor_value = m_factor_columns_index[nb_row];
+  m_factor_rows.resize(nb_factor_value);
+  m_l_values.resize(nb_factor_value);
+  m_u_values.resize(nb_factor_value);
+  m_diagonal.resize(nb_row);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void SparseDirectSolver::
+_fillSymmetricValues()
+{
+  m_upper_values.fill(0.0);
+  m_lower_values.fill(0.0);
+  for (Int32 i = 0, n = m_values.size(); i < n; ++i) {
+    Int32 pos = m_value_positions[i];
+    if (pos >= 0)
+      m_upper_values[pos] += m_values[i];
+    else
+      m_lower_values[-pos - 1] += m_values[i];
+  }
+
+  m_is_symmetric = true;
+  for (Int32 k = 0; k < m_nb_row && m_is_symmetric; ++k)
+    for (Int32 p = m_sym_columns_index[k], n = m_sym_columns_index[k + 1]; p < n; ++p)
+      if (m_sym_rows[p] != k && m_upper_values[p] != m_lower_values[p]) {
+        m_is_symmetric = false;
+        break;
+      }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Compute L, U and the diagonal of U (up-looking algorithm).
+ *
+ * At step k, the column k of U is computed by solving L.y = A(:,k) and
+ * the row k of L by solving Ut.z = A(k,:). The non-zero values of y and z
+ * are given by the paths in the elimination tree from the rows of A(:,k)
+ * to k. If the matrix is symmetric, L(k,i) = U(i,k)/U(i,i) and the second
+ * solve is not needed.
+ */
+void SparseDirectSolver::
+_computeNumericFactorization()
+{
+  const Int32 nb_row = m_nb_row;
+  UniqueArray<Real> y(nb_row);
+  UniqueArray<Real> z(nb_row);
+  y.fill(0.0);
+  z.fill(0.0);
+  UniqueArray<Int32> pattern(nb_row);
+  UniqueArray<Int32> flag(nb_row);
+  UniqueArray<Int32> nb_value_in_column(nb_row);
+  const bool is_symmetric = m_is_symmetric;
+
+  for (Int32 k = 0; k < nb_row; ++k) {
+    Int32 top = nb_row;
+    flag[k] = k;
+    nb_value_in_column[k] = 0;
+    for (Int32 p = m_sym_columns_index[k], n = m_sym_columns_index[k + 1]; p < n; ++p) {
+      Int32 i = m_sym_rows[p];
+      y[i] += m_upper_values[p];
+      if (i < k)
+        z[i] += m_lower_values[p];
+      Int32 len = 0;
+      for (; flag[i] != k; i = m_parent[i]) {
+        pattern[len++] = i;
+        flag[i] = k;
+      }
+      while (len > 0)
+        pattern[--top] = pattern[--len];
+    }
+
+    Real d = y[k];
+    y[k] = 0.0;
+    for (; top < nb_row; ++top) {
+      Int32 i = pattern[top];
+      Real yi = y[i];
+      Real zi = z[i];
+      y[i] = 0.0;
+      z[i] = 0.0;
+      Int32 begin = m_factor_columns_index[i];
+      Int32 end = begin + nb_value_in_column[i];
+      Real l_ki = 0.0;
+      if (is_symmetric) {
+        for (Int32 p = begin; p < end; ++p)
+          y[m_factor_rows[p]] -= m_l_values[p] * yi;
+        l_ki = yi / m_diagonal[i];
+      }
+      else {
+        l_ki = zi / m_diagonal[i];
+        for (Int32 p = begin; p < end; ++p) {
+          Int32 r = m_factor_rows[p];
+          y[r] -= m_l_values[p] * yi;
+          z[r] -= m_u_values[p] * l_ki;
+        }
+      }
+      d -= l_ki * yi;
+      m_factor_rows[end] = k;
+      m_l_values[end] = l_ki;
+      m_u_values[end] = yi;
+      ++nb_value_in_column[i];
+    }
+    if (d == 0.0)
+      ARCANE_FATAL("Zero pivot in sparse direct factorization (row={0})", m_permutation[k]);
+    m_diagonal[k] = d;
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void SparseDirectSolver::
+solve(Span<const Real> b, Span<Real> x)
+{
+  if (!m_is_factorized)
+    ARCANE_FATAL("The matrix has to be factorized before calling solve()");
+  const Int32 nb_row = m_nb_row;
+  m_work.resize(nb_row);
+  Span<Real> w = m_work.span();
+
+  for (Int32 j = 0; j < nb_row; ++j)
+    w[j] = b[m_permutation[j]];
+
+  // Forward substitution with L (unit diagonal)
+  for (Int32 j = 0; j < nb_row; ++j) {
+    Real wj = w[j];
+    if (wj == 0.0)
+      continue;
+    for (Int32 p = m_factor_columns_index[j], n = m_factor_columns_index[j + 1]; p < n; ++p)
+      w[m_factor_rows[p]] -= m_l_values[p] * wj;
+  }
+
+  // Backward substitution with U
+  for (Int32 j = nb_row - 1; j >= 0; --j) {
+    Real s = w[j];
+    for (Int32 p = m_factor_columns_index[j], n = m_factor_columns_index[j + 1]; p < n; ++p)
+      s -= m_u_values[p] * w[m_factor_rows[p]];
+    w[j] = s / m_diagonal[j];
+  }
+
+  for (Int32 j = 0; j < nb_row; ++j)
+    x[m_permutation[j]] = w[j];
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
@@ -0,0 +1,154 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* SparseDirectSolver.h                                        (C) 2022-2025 */
+/*                                                                           */
+/* Sparse LU/LDLt direct solver with fill-reducing ordering.                 */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+#ifndef FEMUTILS_SPARSEDIRECTSOLVER_H
+#define FEMUTILS_SPARSEDIRECTSOLVER_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <arcane/utils/TraceAccessor.h>
+#include <arcane/utils/UniqueArray.h>
+#include <arcane/utils/ArrayView.h>
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+namespace Arcane::FemUtils
+{
+
+//! Ordering of the unknowns used by SparseDirectSolver
+enum class eSparseDirectOrdering
+{
+  //! Keep the numbering of the DoFs
+  Natural,
+  //! Minimum degree ordering on the graph of the matrix
+  MinimumDegree
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+/*!
+ * \brief Sparse direct solver for a CSR matrix.
+ *
+ * The matrix is factorized as P.A.Pt = L.U where P is a fill-reducing
+ * permutation, L is unit lower triangular and U is upper triangular. The
+ * structure of L and U is computed from the symmetrized structure of A
+ * (elimination tree), so the factorization is done without pivoting: it is
+ * suited to the matrices of finite element problems. If A is symmetric,
+ * U = D.Lt and only L is computed (LDLt factorization).
+ *
+ * The instance keeps the factorization between two calls to factorize():
+ * - if the structure of the matrix has not changed, the ordering and the
+ *   symbolic factorization are reused,
+ * - if the values have not changed either, the factorization is reused and
+ *   solve() only does the forward and backward substitutions.
+ */
+class SparseDirectSolver
+: public TraceAccessor
+{
+ public:
+
+  explicit SparseDirectSolver(ITraceMng* tm)
+  : TraceAccessor(tm)
+  {}
+
+ public:
+
+  void setOrdering(eSparseDirectOrdering v) { m_ordering = v; }
+  //! If false, the factorization is done again at each call to factorize()
+  void setReuseFactorization(bool v) { m_is_reuse_factorization = v; }
+
+  /*!
+   * \brief Factorize the CSR matrix (\a rows_index, \a columns, \a values).
+   *
+   * \a rows_index has \a nb_row+1 values. The columns of a row have to be
+   * sorted. Returns true if the numeric factorization has been done and
+   * false if the previous factorization has been reused.
+   */
+  bool factorize(Int32 nb_row, Span<const Int32> rows_index,
+                 Span<const Int32> columns, Span<const Real> values);
+
+  //! Solve A.x = b with the current factorization
+  void solve(Span<const Real> b, Span<Real> x);
+
+  //! Number of values of L (without the diagonal)
+  Int64 nbFactorValue() const { return m_factor_rows.size(); }
+
+  //! Clear the factorization
+  void clear();
+
+ private:
+
+  eSparseDirectOrdering m_ordering = eSparseDirectOrdering::MinimumDegree;
+  bool m_is_reuse_factorization = true;
+  bool m_is_symmetric = false;
+  bool m_is_factorized = false;
+  Int32 m_nb_row = 0;
+
+  //! Copy of the matrix used for the current factorization
+  UniqueArray<Int32> m_rows_index;
+  UniqueArray<Int32> m_columns;
+  UniqueArray<Real> m_values;
+
+  //! Permutation: m_permutation[new_index] = old_index
+  UniqueArray<Int32> m_permutation;
+  UniqueArray<Int32> m_inverse_permutation;
+
+  /*!
+   * \brief Symmetrized structure of the permuted matrix.
+   *
+   * For the column k, it contains the rows i<=k of the permuted matrix.
+   * m_upper_values contains A(i,k) and m_lower_values contains A(k,i).
+   */
+  UniqueArray<Int32> m_sym_columns_index;
+  UniqueArray<Int32> m_sym_rows;
+  UniqueArray<Real> m_upper_values;
+  UniqueArray<Real> m_lower_values;
+  //! Position of each value of the CSR matrix in m_upper_values (>=0) or in m_lower_values (<0)
+  UniqueArray<Int32> m_value_positions;
+
+  //! Elimination tree
+  UniqueArray<Int32> m_parent;
+  /*!
+   * \brief Factors stored by column of L.
+   *
+   * The column j of L contains the rows k>j. At the same position
+   * m_u_values contains U(j,k).
+   */
+  UniqueArray<Int32> m_factor_columns_index;
+  UniqueArray<Int32> m_factor_rows;
+  UniqueArray<Real> m_l_values;
+  UniqueArray<Real> m_u_values;
+  UniqueArray<Real> m_diagonal;
+
+  //! Work vector for solve()
+  UniqueArray<Real> m_work;
+
+ private:
+
+  void _computeOrdering();
+  void _computeMinimumDegreeOrdering();
+  void _computeSymmetricStructure();
+  void _computeSymbolicFactorization();
+  void _fillSymmetricValues();
+  void _computeNumericFactorization();
+};
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+} // namespace Arcane::FemUtils
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#endif
@@ -76,8 +76,14 @@ void FemModule::_initBsr()
   info() << "[ArcaneFem-Info] Started module  compute()";
   Real elapsedTime = platform::getRealTime();
 
-  bool use_csr_in_linearsystem = options()->linearSystem.serviceName() == "HypreLinearSystem";
-  m_bsr_format.initialize(defaultMesh(), use_csr_in_linearsystem, options()->bsrAtomicFree());
+  String linear_system_name = options()->linearSystem.serviceName();
+  bool use_csr_in_linearsystem = linear_system_name == "HypreLinearSystem" || linear_system_name == "AlephLinearSystem" || linear_system_name == "NativeLinearSystem";
+  auto assembly_strategy = eBSRAssemblyStrategy::Atomic;
+  if (options()->bsrColored())
+    assembly_strategy = eBSRAssemblyStrategy::Colored;
+  else if (options()->bsrAtomicFree())
+    assembly_strategy = (options()->bsrElementCache()) ? eBSRAssemblyStrategy::AtomicFreeCached : eBSRAssemblyStrategy::AtomicFree;
+  m_bsr_format.initialize(defaultMesh(), use_csr_in_linearsystem, assembly_strategy, options()->bsrSymmetric());
   m_bsr_format.computeSparsity();
 
   elapsedTime = platform::getRealTime() - elapsedTime;
@@ -105,7 +111,7 @@ _doStationarySolve()
   _getMaterialParameters();
   _assembleBilinearOperator();
 
-  if (m_use_bsr || m_use_bsr_atomic_free)
+  if (m_use_bsr || m_use_bsr_atomic_free || m_use_bsr_colored)
     m_bsr_format.toLinearSystem(m_linear_system);
 
   _assembleLinearOperator();
@@ -135,6 +141,7 @@ _getMaterialParameters()
 
   m_use_bsr = options()->bsr;
   m_use_bsr_atomic_free = options()->bsrAtomicFree();
+  m_use_bsr_colored = options()->bsrColored();
 
   elapsedTime = platform::getRealTime() - elapsedTime;
   _printArcaneFemTime("[ArcaneFem-Timer] get-material-params", elapsedTime);
@@ -168,6 +175,8 @@ void FemModule::_assembleDirichletsGpu()
       FemUtils::Gpu::BoundaryConditions::applyDirichletViaPenaltyVectorial(m_dofs_on_nodes, m_linear_system, mesh_ptr, queue, group, options()->penalty(), u_dirichlet_string);
     else if (method == "RowElimination")
       FemUtils::Gpu::BoundaryConditions::applyDirichletViaRowEliminationVectorial(m_dofs_on_nodes, m_linear_system, mesh_ptr, queue, group, u_dirichlet_string);
+    else if (method == "RowColumnElimination")
+      FemUtils::Gpu::BoundaryConditions::applyDirichletViaRowColumnEliminationVectorial(m_dofs_on_nodes, m_linear_system, mesh_ptr, queue, group, u_dirichlet_string);
     else
       ARCANE_THROW(Arccore::NotImplementedException, "Method is not supported.");
   }
@@ -186,6 +195,8 @@ void FemModule::_assembleDirichletsGpu()
       FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaPenaltyVectorial(m_dofs_on_nodes, m_linear_system, mesh(), queue, group, options()->penalty(), u_dirichlet_string);
     else if (method == "RowElimination")
       FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaRowEliminationVectorial(m_dofs_on_nodes, m_linear_system, mesh_ptr, queue, group, u_dirichlet_string);
+    else if (method == "RowColumnElimination")
+      FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaRowColumnEliminationVectorial(m_dofs_on_nodes, m_linear_system, mesh_ptr, queue, group, u_dirichlet_string);
     else
       ARCANE_THROW(Arccore::NotImplementedException, "Method is not supported.");
   }
@@ -272,9 +283,10 @@ _assembleLinearOperator()
     }
   }
 
-  auto use_hypre = options()->linearSystem.serviceName() == "HypreLinearSystem";
-  if (use_hypre) {
-    // The rest of the assembly can be handled on Gpu because of Hypre solver.
+  auto linear_system_name = options()->linearSystem.serviceName();
+  auto use_gpu_dirichlet = linear_system_name == "HypreLinearSystem" || linear_system_name == "NativeLinearSystem";
+  if (use_gpu_dirichlet) {
+    // The rest of the assembly can be handled on Gpu because of Hypre/Native solver.
     _assembleDirichletsGpu();
     return;
   }
@@ -438,7 +450,7 @@ _assembleBilinearOperator()
   info() << "[ArcaneFem-Info] Started module  _assembleBilinearOperator()";
   Real elapsedTime = platform::getRealTime();
 
-  if (m_use_bsr || m_use_bsr_atomic_free) {
+  if (m_use_bsr || m_use_bsr_atomic_free || m_use_bsr_colored) {
     _initBsr();
 
     UnstructuredMeshConnectivityView m_connectivity_view(mesh());
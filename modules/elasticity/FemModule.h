@@ -89,6 +89,7 @@ class FemModule
 
   bool m_use_bsr = false;
   bool m_use_bsr_atomic_free = false;
+  bool m_use_bsr_colored = false;
 
   void _getMaterialParameters();
   void _assembleBilinearOperatorTRIA3();
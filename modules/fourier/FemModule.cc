@@ -30,6 +30,15 @@ startInit()
   m_dofs_on_nodes.initialize(mesh(), 1);
   m_dof_family = m_dofs_on_nodes.dofFamily();
 
+  if (options()->bsr() || options()->bsrAtomicFree()) {
+    String linear_system_name = options()->linearSystem.serviceName();
+    auto use_csr_in_linear_system = linear_system_name == "HypreLinearSystem" || linear_system_name == "AlephLinearSystem" || linear_system_name == "NativeLinearSystem";
+    auto assembly_strategy = eBSRAssemblyStrategy::Atomic;
+    if (options()->bsrAtomicFree())
+      assembly_strategy = (options()->bsrElementCache()) ? eBSRAssemblyStrategy::AtomicFreeCached : eBSRAssemblyStrategy::AtomicFree;
+    m_bsr_format.initialize(mesh(), use_csr_in_linear_system, assembly_strategy);
+  }
+
   BC::IArcaneFemBC* bc = options()->boundaryConditions();
 
   for (BC::IManufacturedSolution* bs : bc->manufacturedSolutions()) {
@@ -88,6 +97,8 @@ compute()
     m_linear_system.setSolverCommandLineArguments(args);
   }
   info() << "NB_CELL=" << allCells().size() << " NB_FACE=" << allFaces().size();
+  if (options()->bsr() || options()->bsrAtomicFree())
+    m_bsr_format.computeSparsity();
   _doStationarySolve();
 }
 
@@ -109,6 +120,8 @@ _doStationarySolve()
 {
   _getMaterialParameters();
   _assembleBilinearOperator();
+  if (options()->bsr() || options()->bsrAtomicFree())
+    m_bsr_format.toLinearSystem(m_linear_system);
   _assembleLinearOperator();
   _solve();
   _validateResults();
@@ -223,11 +236,12 @@ FixedMatrix<3, 3> FemModule::
 _computeElementMatrixTria3(Cell cell)
 {
   Real area = ArcaneFemFunctions::MeshOperation::computeAreaTria3(cell, m_node_coord);
+  Real cell_lambda = m_cell_lambda[cell];
 
   Real3 dxU = ArcaneFemFunctions::FeOperation2D::computeGradientXTria3(cell, m_node_coord);
   Real3 dyU = ArcaneFemFunctions::FeOperation2D::computeGradientYTria3(cell, m_node_coord);
 
-  return area * lambda * (dxU ^ dxU) + area * lambda * (dyU ^ dyU);
+  return area * cell_lambda * (dxU ^ dxU) + area * cell_lambda * (dyU ^ dyU);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -237,11 +251,12 @@ FixedMatrix<4, 4> FemModule::
 _computeElementMatrixQuad4(Cell cell)
 {
   Real area = ArcaneFemFunctions::MeshOperation::computeAreaQuad4(cell, m_node_coord);
+  Real cell_lambda = m_cell_lambda[cell];
 
   Real4 dxU = ArcaneFemFunctions::FeOperation2D::computeGradientXQuad4(cell, m_node_coord);
   Real4 dyU = ArcaneFemFunctions::FeOperation2D::computeGradientYQuad4(cell, m_node_coord);
 
-  return area * lambda * (dxU ^ dxU) + area * lambda * (dyU ^ dyU);
+  return area * cell_lambda * (dxU ^ dxU) + area * cell_lambda * (dyU ^ dyU);
 }
 
 /*---------------------------------------------------------------------------*/
@@ -253,7 +268,9 @@ _computeElementMatrixQuad4(Cell cell)
 void FemModule::
 _assembleBilinearOperator()
 {
-  if (options()->meshType == "QUAD4")
+  if (options()->bsr() || options()->bsrAtomicFree())
+    _assembleBilinearOperatorBsr();
+  else if (options()->meshType == "QUAD4")
     _assembleBilinear<4>([this](const Cell& cell) {
       return _computeElementMatrixQuad4(cell);
     });
@@ -265,6 +282,28 @@ _assembleBilinearOperator()
     ARCANE_FATAL("Non supported meshType");
 }
 
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Assembles the bilinear operator matrix in the BSR format.
+ *
+ * The element matrices are computed on the host, so the default queue
+ * has to be a host one.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_assembleBilinearOperatorBsr()
+{
+  CellInfoListView cells(mesh()->cellFamily());
+
+  if (options()->meshType == "QUAD4")
+    m_bsr_format.assembleBilinear([this, cells](CellLocalId cell_lid) { return _computeElementMatrixQuad4(cells[cell_lid]); });
+  else if (options()->meshType == "TRIA3")
+    m_bsr_format.assembleBilinear([this, cells](CellLocalId cell_lid) { return _computeElementMatrixTria3(cells[cell_lid]); });
+  else
+    ARCANE_FATAL("Non supported meshType");
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief Assembles the bilinear operator matrix for the FEM linear system.
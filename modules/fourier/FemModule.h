@@ -28,6 +28,8 @@
 #include <arcane/ICaseMng.h>
 #include <arcane/core/IStandardFunction.h>
 
+#include <arcane/accelerator/core/IAcceleratorMng.h>
+
 #include "IArcaneFemBC.h"
 #include "IDoFLinearSystemFactory.h"
 #include "Fem_axl.h"
@@ -35,6 +37,7 @@
 #include "DoFLinearSystem.h"
 #include "FemDoFsOnNodes.h"
 #include "ArcaneFemFunctions.h"
+#include "BSRFormat.h"
 
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
@@ -60,6 +63,7 @@ class FemModule
   explicit FemModule(const ModuleBuildInfo& mbi)
   : ArcaneFemObject(mbi)
   , m_dofs_on_nodes(mbi.subDomain()->traceMng())
+  , m_bsr_format(mbi.subDomain()->traceMng(), *(mbi.subDomain()->acceleratorMng()->defaultQueue()), m_dofs_on_nodes)
   {
     ICaseMng* cm = mbi.subDomain()->caseMng();
     cm->setTreatWarningAsError(true);
@@ -79,10 +83,12 @@ class FemModule
   DoFLinearSystem m_linear_system;
   IItemFamily* m_dof_family = nullptr;
   FemDoFsOnNodes m_dofs_on_nodes;
+  BSRFormat<1> m_bsr_format;
 
   void _doStationarySolve();
   void _getMaterialParameters();
   void _assembleBilinearOperator();
+  void _assembleBilinearOperatorBsr();
   void _solve();
   void _assembleLinearOperator();
   void _validateResults();
@@ -30,9 +30,15 @@ startInit()
   m_dofs_on_nodes.initialize(mesh(), 1);
   m_dof_family = m_dofs_on_nodes.dofFamily();
 
-  if (options()->bsr() || options()->bsrAtomicFree()) {
-    auto use_csr_in_linear_system = options()->linearSystem.serviceName() == "HypreLinearSystem";
-    m_bsr_format.initialize(defaultMesh(), use_csr_in_linear_system, options()->bsrAtomicFree());
+  if (!options()->matrixFree() && (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored())) {
+    String linear_system_name = options()->linearSystem.serviceName();
+    auto use_csr_in_linear_system = linear_system_name == "HypreLinearSystem" || linear_system_name == "AlephLinearSystem" || linear_system_name == "NativeLinearSystem";
+    auto assembly_strategy = eBSRAssemblyStrategy::Atomic;
+    if (options()->bsrColored())
+      assembly_strategy = eBSRAssemblyStrategy::Colored;
+    else if (options()->bsrAtomicFree())
+      assembly_strategy = (options()->bsrElementCache()) ? eBSRAssemblyStrategy::AtomicFreeCached : eBSRAssemblyStrategy::AtomicFree;
+    m_bsr_format.initialize(defaultMesh(), use_csr_in_linear_system, assembly_strategy);
   }
 
   elapsedTime = platform::getRealTime() - elapsedTime;
@@ -71,7 +77,11 @@ compute()
     m_linear_system.setSolverCommandLineArguments(args);
   }
 
-  if (options()->bsr() || options()->bsrAtomicFree())
+  if (options()->matrixFree()) {
+    if (!m_linear_system.hasSetLinearOperator())
+      ARCANE_FATAL("Option 'matrix-free' is not supported by linear system '{0}'", options()->linearSystem.serviceName());
+  }
+  else if (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored())
     m_bsr_format.computeSparsity();
 
   _doStationarySolve();
@@ -98,7 +108,10 @@ void FemModule::
 _doStationarySolve()
 {
   _getMaterialParameters();
-  _assembleBilinearOperator();
+  if (options()->matrixFree())
+    _initMatrixFreeOperator();
+  else
+    _assembleBilinearOperator();
   _assembleLinearOperator();
   _solve();
   _updateVariables();
@@ -137,7 +150,7 @@ _assembleLinearOperator()
   info() << "[ArcaneFem-Info] Started module _assembleLinearOperator()";
   Real elapsedTime = platform::getRealTime();
 
-  if (options()->bsr || options()->bsrAtomicFree())
+  if (!options()->matrixFree() && (options()->bsr || options()->bsrAtomicFree() || options()->bsrColored()))
     m_bsr_format.toLinearSystem(m_linear_system);
 
   VariableDoFReal& rhs_values(m_linear_system.rhsVariable()); // Temporary variable to keep values for the RHS
@@ -161,6 +174,38 @@ _assembleLinearOperator()
   _printArcaneFemTime("[ArcaneFem-Timer] rhs-vector-assembly", elapsedTime);
 }
 
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Creates the matrix-free operator and gives it to the linear system.
+ *
+ * No matrix is assembled: the element matrices are computed on the fly at
+ * each application. The Dirichlet penalty set on the diagonal by the
+ * boundary conditions is handled by the linear system.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_initMatrixFreeOperator()
+{
+  info() << "[ArcaneFem-Info] Started module _initMatrixFreeOperator()";
+  Real elapsedTime = platform::getRealTime();
+
+  UnstructuredMeshConnectivityView m_connectivity_view(mesh());
+  auto cn_cv = m_connectivity_view.cellNode();
+  auto m_queue = subDomain()->acceleratorMng()->defaultQueue();
+  auto command = makeCommand(m_queue);
+  auto in_node_coord = ax::viewIn(command, m_node_coord);
+
+  if (mesh()->dimension() == 3)
+    m_matrix_free_operator = makeMatrixFreeOperator<1>(traceMng(), mesh(), *m_queue, m_dofs_on_nodes, [=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return computeElementMatrixTetra4Gpu(cell_lid, cn_cv, in_node_coord); });
+  else
+    m_matrix_free_operator = makeMatrixFreeOperator<1>(traceMng(), mesh(), *m_queue, m_dofs_on_nodes, [=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return computeElementMatrixTria3Gpu(cell_lid, cn_cv, in_node_coord); });
+  m_linear_system.setLinearOperator(m_matrix_free_operator.get());
+
+  elapsedTime = platform::getRealTime() - elapsedTime;
+  _printArcaneFemTime("[ArcaneFem-Timer] matrix-free-operator-init", elapsedTime);
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief Calls the right function for LHS assembly
@@ -173,7 +218,7 @@ _assembleBilinearOperator()
   info() << "[ArcaneFem-Info] Started module _assembleBilinearOperator()";
   Real elapsedTime = platform::getRealTime();
 
-  if (options()->bsr() || options()->bsrAtomicFree()) {
+  if (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored()) {
     UnstructuredMeshConnectivityView m_connectivity_view(mesh());
     auto cn_cv = m_connectivity_view.cellNode();
     auto m_queue = subDomain()->acceleratorMng()->defaultQueue();
@@ -40,6 +40,7 @@
 // GPU includes
 #include "ArcaneFemFunctionsGpu.h"
 #include "BSRFormat.h"
+#include "MatrixFreeOperator.h"
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
@@ -78,6 +79,7 @@ class FemModule
   VersionInfo versionInfo() const override { return VersionInfo(1, 0, 0); }
 
   void _assembleBilinearOperator();
+  void _initMatrixFreeOperator();
 
  private:
 
@@ -85,6 +87,7 @@ class FemModule
   IItemFamily* m_dof_family = nullptr;
   FemDoFsOnNodes m_dofs_on_nodes;
   BSRFormat<1> m_bsr_format;
+  std::unique_ptr<IDoFLinearOperator> m_matrix_free_operator;
 
   void _doStationarySolve();
   void _getMaterialParameters();
@@ -176,4 +179,18 @@ _computeElementMatrixTetra4(Cell cell)
   return volume * (dxU ^ dxU) + volume * (dyU ^ dyU) + volume * (dzU ^ dzU);
 }
 
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCCORE_HOST_DEVICE FixedMatrix<4, 4> computeElementMatrixTetra4Gpu(CellLocalId cell_lid, const IndexedCellNodeConnectivityView& cn_cv, const ax::VariableNodeReal3InView& in_node_coord)
+{
+  Real volume = FemUtils::Gpu::MeshOperation::computeVolumeTetra4(cell_lid, cn_cv, in_node_coord);
+
+  Real4 dxU = FemUtils::Gpu::FeOperation3D::computeGradientXTetra4(cell_lid, cn_cv, in_node_coord);
+  Real4 dyU = FemUtils::Gpu::FeOperation3D::computeGradientYTetra4(cell_lid, cn_cv, in_node_coord);
+  Real4 dzU = FemUtils::Gpu::FeOperation3D::computeGradientZTetra4(cell_lid, cn_cv, in_node_coord);
+
+  return volume * (dxU ^ dxU) + volume * (dyU ^ dyU) + volume * (dzU ^ dzU);
+}
+
 #endif
\ No newline at end of file
@@ -27,12 +27,21 @@ startInit()
   info() << "[ArcaneFem-Module] startInit()";
   Real elapsedTime = platform::getRealTime();
 
-  m_dofs_on_nodes.initialize(mesh(), 1);
+  m_dofs_on_nodes.initialize(mesh(), 1, FemDoFsOnNodes::renumberingFromName(options()->nodeRenumbering()));
   m_dof_family = m_dofs_on_nodes.dofFamily();
 
-  if (options()->bsr() || options()->bsrAtomicFree()) {
-    auto use_csr_in_linear_system = options()->linearSystem.serviceName() == "HypreLinearSystem";
-    m_bsr_format.initialize(mesh(), use_csr_in_linear_system, options()->bsrAtomicFree());
+  if (!options()->matrixFree() && (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored())) {
+    String linear_system_name = options()->linearSystem.serviceName();
+    auto use_csr_in_linear_system = linear_system_name == "HypreLinearSystem" || linear_system_name == "AlephLinearSystem" || linear_system_name == "NativeLinearSystem";
+    auto assembly_strategy = eBSRAssemblyStrategy::Atomic;
+    if (options()->bsrColored())
+      assembly_strategy = eBSRAssemblyStrategy::Colored;
+    else if (options()->bsrAtomicFree())
+      assembly_strategy = (options()->bsrElementCache()) ? eBSRAssemblyStrategy::AtomicFreeCached : eBSRAssemblyStrategy::AtomicFree;
+    if (options()->bsrIndex64())
+      m_bsr_format_index64.initialize(mesh(), use_csr_in_linear_system, assembly_strategy, options()->bsrSymmetric());
+    else
+      m_bsr_format.initialize(mesh(), use_csr_in_linear_system, assembly_strategy, options()->bsrSymmetric());
   }
 
   elapsedTime = platform::getRealTime() - elapsedTime;
@@ -63,6 +72,8 @@ compute()
   m_linear_system.reset();
   m_linear_system.setLinearSystemFactory(options()->linearSystem());
   m_linear_system.initialize(subDomain(), acceleratorMng()->defaultRunner(), m_dofs_on_nodes.dofFamily(), "Solver");
+  if (options()->solveReportFile.isPresent())
+    m_linear_system.setSolveReportFileName(options()->solveReportFile());
 
   // Test for adding parameters for PETSc.
   // This is only used for the first call.
@@ -73,8 +84,16 @@ compute()
     m_linear_system.setSolverCommandLineArguments(args);
   }
 
-  if (options()->bsr() || options()->bsrAtomicFree)
-    m_bsr_format.computeSparsity();
+  if (options()->matrixFree()) {
+    if (!m_linear_system.hasSetLinearOperator())
+      ARCANE_FATAL("Option 'matrix-free' is not supported by linear system '{0}'", options()->linearSystem.serviceName());
+  }
+  else if (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored()) {
+    if (options()->bsrIndex64())
+      m_bsr_format_index64.computeSparsity();
+    else
+      m_bsr_format.computeSparsity();
+  }
 
   _doStationarySolve();
 
@@ -92,6 +111,7 @@ compute()
  *   2. _assembleBilinearOperator()  Assembles the FEM  matrix A
  *   3. _assembleLinearOperator()    Assembles the FEM RHS vector b
  *   4. _solve()                     Solves for solution vector u = A^-1*b
+ *      (or _solveMultipleRhs() which does 3. and 4. for each source)
  *   5. _updateVariables()           Updates FEM variables u = x
  *   6. _validateResults()           Regression test
  */
@@ -101,17 +121,38 @@ void FemModule::
 _doStationarySolve()
 {
   _getMaterialParameters();
-  _assembleBilinearOperator();
-
-  if (options()->bsr() || options()->bsrAtomicFree())
-    m_bsr_format.toLinearSystem(m_linear_system);
 
-  if (options()->linearSystem.serviceName() == "HypreLinearSystem")
-    _assembleLinearOperatorGpu();
-  else
-    _assembleLinearOperator();
+  if (options()->matrixFree())
+    _initMatrixFreeOperator();
+  else {
+    _assembleBilinearOperator();
+    if (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored()) {
+      if (options()->bsrIndex64())
+        m_bsr_format_index64.toLinearSystem(m_linear_system);
+      else
+        m_bsr_format.toLinearSystem(m_linear_system);
+    }
+  }
 
-  _solve();
+  if (options()->multiRhsF.size() > 0)
+    _solveMultipleRhs();
+  else {
+    auto linear_system_name = options()->linearSystem.serviceName();
+    const bool is_gpu_linear_system = (linear_system_name == "HypreLinearSystem" || linear_system_name == "NativeLinearSystem");
+    const Int32 nb_solve = options()->nbSolve();
+    if (nb_solve > 1 && !is_gpu_linear_system)
+      ARCANE_FATAL("Option 'nb-solve' is not supported by linear system '{0}'", linear_system_name);
+
+    // The matrix is assembled once and solved 'nb-solve' times
+    for (Int32 i = 0; i < nb_solve; ++i) {
+      if (is_gpu_linear_system)
+        _assembleLinearOperatorGpu();
+      else
+        _assembleLinearOperator();
+
+      _solve();
+    }
+  }
   _updateVariables();
   _validateResults();
 }
@@ -137,7 +178,8 @@ _getMaterialParameters()
 /*---------------------------------------------------------------------------*/
 /**
  * @brief FEM linear operator for the current simulation step.
- * GPU compatible. Currently working with HypreDoFLinearSystem.
+ * GPU compatible. Currently working with HypreDoFLinearSystem and
+ * NativeDoFLinearSystem.
  *
  * This method constructs the linear  system by  assembling the LHS matrix
  * and  RHS vector, applying various boundary conditions and source terms.
@@ -164,7 +206,7 @@ void FemModule::_assembleLinearOperatorGpu()
   auto mesh_ptr = mesh();
 
   auto applyBoundaryConditions = [&](auto BCFunctions) {
-    if (options()->f.isPresent())
+    if (options()->f.isPresent() || options()->multiRhsF.size() > 0)
       BCFunctions.applyConstantSourceToRhs(f, m_dofs_on_nodes, m_node_coord, rhs_values, mesh_ptr, queue);
 
     BC::IArcaneFemBC* bc = options()->boundaryConditions();
@@ -173,11 +215,29 @@ void FemModule::_assembleLinearOperatorGpu()
       for (BC::INeumannBoundaryCondition* bs : bc->neumannBoundaryConditions())
         BCFunctions.applyNeumannToRhs(bs, m_dofs_on_nodes, m_node_coord, rhs_values, mesh_ptr, queue);
 
-      for (BC::IDirichletBoundaryCondition* bs : bc->dirichletBoundaryConditions())
-        FemUtils::Gpu::BoundaryConditions::applyDirichletViaPenalty(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+      for (BC::IDirichletBoundaryCondition* bs : bc->dirichletBoundaryConditions()) {
+        const String method = bs->getEnforceDirichletMethod();
+        if (method == "Penalty")
+          FemUtils::Gpu::BoundaryConditions::applyDirichletViaPenalty(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+        else if (method == "RowElimination")
+          FemUtils::Gpu::BoundaryConditions::applyDirichletViaRowElimination(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+        else if (method == "RowColumnElimination")
+          FemUtils::Gpu::BoundaryConditions::applyDirichletViaRowColumnElimination(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+        else
+          ARCANE_THROW(Arccore::NotImplementedException, "Method is not supported.");
+      }
 
-      for (BC::IDirichletPointCondition* bs : bc->dirichletPointConditions())
-        FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaPenalty(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+      for (BC::IDirichletPointCondition* bs : bc->dirichletPointConditions()) {
+        const String method = bs->getEnforceDirichletMethod();
+        if (method == "Penalty")
+          FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaPenalty(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+        else if (method == "RowElimination")
+          FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaRowElimination(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+        else if (method == "RowColumnElimination")
+          FemUtils::Gpu::BoundaryConditions::applyPointDirichletViaRowColumnElimination(bs, m_dofs_on_nodes, m_linear_system, mesh_ptr, queue);
+        else
+          ARCANE_THROW(Arccore::NotImplementedException, "Method is not supported.");
+      }
     }
   };
 
@@ -246,6 +306,27 @@ void FemModule::_assembleLinearOperator()
   _printArcaneFemTime("[ArcaneFem-Timer] rhs-vector-assembly", elapsedTime);
 }
 
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Assembles the LHS in \a bsr_format (32-bit or 64-bit indexes).
+ */
+/*---------------------------------------------------------------------------*/
+
+template <typename BSRFormatType> void FemModule::
+_assembleBilinearOperatorBsr(BSRFormatType& bsr_format)
+{
+  UnstructuredMeshConnectivityView m_connectivity_view(mesh());
+  auto cn_cv = m_connectivity_view.cellNode();
+  auto queue = subDomain()->acceleratorMng()->defaultQueue();
+  auto command = makeCommand(queue);
+  auto in_node_coord = ax::viewIn(command, m_node_coord);
+
+  if (mesh()->dimension() == 2)
+    bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return _computeElementMatrixTria3Gpu(cell_lid, cn_cv, in_node_coord); });
+  else
+    bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return _computeElementMatrixTetra4Gpu(cell_lid, cn_cv, in_node_coord); });
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief Calls the right function for LHS assembly given as mesh type.
@@ -258,17 +339,11 @@ _assembleBilinearOperator()
   info() << "[ArcaneFem-Module] _assembleBilinearOperator()";
   Real elapsedTime = platform::getRealTime();
 
-  if (options()->bsr() || options()->bsrAtomicFree()) {
-    UnstructuredMeshConnectivityView m_connectivity_view(mesh());
-    auto cn_cv = m_connectivity_view.cellNode();
-    auto queue = subDomain()->acceleratorMng()->defaultQueue();
-    auto command = makeCommand(queue);
-    auto in_node_coord = ax::viewIn(command, m_node_coord);
-
-    if (mesh()->dimension() == 2)
-      m_bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return _computeElementMatrixTria3Gpu(cell_lid, cn_cv, in_node_coord); });
+  if (options()->bsr() || options()->bsrAtomicFree() || options()->bsrColored()) {
+    if (options()->bsrIndex64())
+      _assembleBilinearOperatorBsr(m_bsr_format_index64);
     else
-      m_bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return _computeElementMatrixTetra4Gpu(cell_lid, cn_cv, in_node_coord); });
+      _assembleBilinearOperatorBsr(m_bsr_format);
   }
   else {
     if (mesh()->dimension() == 3)
@@ -285,6 +360,37 @@ _assembleBilinearOperator()
   _printArcaneFemTime("[ArcaneFem-Timer] lhs-matrix-assembly", elapsedTime);
 }
 
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Creates the matrix-free operator and gives it to the linear system.
+ *
+ * No matrix is assembled: the element matrices are computed on the fly
+ * by the same kernels as the BSR assembly at each application.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_initMatrixFreeOperator()
+{
+  info() << "[ArcaneFem-Module] _initMatrixFreeOperator()";
+  Real elapsedTime = platform::getRealTime();
+
+  UnstructuredMeshConnectivityView m_connectivity_view(mesh());
+  auto cn_cv = m_connectivity_view.cellNode();
+  auto queue = subDomain()->acceleratorMng()->defaultQueue();
+  auto command = makeCommand(queue);
+  auto in_node_coord = ax::viewIn(command, m_node_coord);
+
+  if (mesh()->dimension() == 2)
+    m_matrix_free_operator = makeMatrixFreeOperator<1>(traceMng(), mesh(), *queue, m_dofs_on_nodes, [=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return _computeElementMatrixTria3Gpu(cell_lid, cn_cv, in_node_coord); });
+  else
+    m_matrix_free_operator = makeMatrixFreeOperator<1>(traceMng(), mesh(), *queue, m_dofs_on_nodes, [=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return _computeElementMatrixTetra4Gpu(cell_lid, cn_cv, in_node_coord); });
+  m_linear_system.setLinearOperator(m_matrix_free_operator.get());
+
+  elapsedTime = platform::getRealTime() - elapsedTime;
+  _printArcaneFemTime("[ArcaneFem-Timer] matrix-free-operator-init", elapsedTime);
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief Assembles the bilinear operator matrix for the FEM linear system.
@@ -340,6 +446,60 @@ _solve()
   _printArcaneFemTime("[ArcaneFem-Timer] solve-linear-system", elapsedTime);
 }
 
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Solves the linear system for 'f' and each source of 'multi-rhs-f'.
+ *
+ * The matrix is assembled once by the caller. The RHS vector of each source
+ * is assembled in a column of the RHS array variable of the linear system
+ * and all the RHS are solved with a single setup of the solver.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_solveMultipleRhs()
+{
+  info() << "[ArcaneFem-Module] _solveMultipleRhs()";
+  Real elapsedTime = platform::getRealTime();
+
+  if (!m_linear_system.hasSolveMultipleRhs())
+    ARCANE_FATAL("Option 'multi-rhs-f' is not supported by linear system '{0}'", options()->linearSystem.serviceName());
+
+  const Int32 nb_rhs = 1 + options()->multiRhsF.size();
+  m_linear_system.setNbRhs(nb_rhs);
+
+  VariableDoFArrayReal& rhs_array(m_linear_system.rhsArrayVariable());
+  VariableDoFReal& rhs_values(m_linear_system.rhsVariable());
+  const Real f0 = f;
+  for (Int32 k = 0; k < nb_rhs; ++k) {
+    f = (k == 0) ? f0 : options()->multiRhsF[k - 1];
+    _assembleLinearOperatorGpu();
+    ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
+      rhs_array[idof][k] = rhs_values[idof];
+    }
+  }
+  f = f0;
+
+  VariableDoFArrayReal& solution_array(m_linear_system.solutionArrayVariable());
+  solution_array.fill(0.0);
+  m_linear_system.solveMultipleRhs();
+
+  // The solution for 'f' is also put in the solution variable for _updateVariables()
+  VariableDoFReal& dof_u(m_linear_system.solutionVariable());
+  auto node_dof(m_dofs_on_nodes.nodeDoFConnectivityView());
+  m_u_multi_rhs.resize(nb_rhs);
+  ENUMERATE_ (Node, inode, ownNodes()) {
+    DoFLocalId dof_id = node_dof.dofId(*inode, 0);
+    for (Int32 k = 0; k < nb_rhs; ++k)
+      m_u_multi_rhs[inode][k] = solution_array[dof_id][k];
+    dof_u[dof_id] = solution_array[dof_id][0];
+  }
+  m_u_multi_rhs.synchronize();
+
+  elapsedTime = platform::getRealTime() - elapsedTime;
+  _printArcaneFemTime("[ArcaneFem-Timer] solve-multiple-rhs", elapsedTime);
+}
+
 /*---------------------------------------------------------------------------*/
 /**
  * @brief Update the FEM variables.
@@ -39,6 +39,7 @@
 #include "FemDoFsOnNodes.h"
 #include "IArcaneFemBC.h"
 #include "BSRFormat.h"
+#include "MatrixFreeOperator.h"
 #include "FemUtils.h"
 
 #include "Fem_axl.h"
@@ -69,6 +70,7 @@ class FemModule
   : ArcaneFemObject(mbi)
   , m_dofs_on_nodes(mbi.subDomain()->traceMng())
   , m_bsr_format(mbi.subDomain()->traceMng(), *(mbi.subDomain()->acceleratorMng()->defaultQueue()), m_dofs_on_nodes)
+  , m_bsr_format_index64(mbi.subDomain()->traceMng(), *(mbi.subDomain()->acceleratorMng()->defaultQueue()), m_dofs_on_nodes)
   {
     ICaseMng* cm = mbi.subDomain()->caseMng();
     cm->setTreatWarningAsError(true);
@@ -80,11 +82,17 @@ class FemModule
   VersionInfo versionInfo() const override { return VersionInfo(1, 0, 0); }
 
   void _assembleBilinearOperator();
+  template <typename BSRFormatType>
+  void _assembleBilinearOperatorBsr(BSRFormatType& bsr_format);
   void _assembleLinearOperatorGpu();
+  void _initMatrixFreeOperator();
 
  private:
 
   BSRFormat<1> m_bsr_format;
+  //! BSR format with 64-bit indexes (option 'bsr-index64')
+  BSRFormat<1, Int64> m_bsr_format_index64;
+  std::unique_ptr<IDoFLinearOperator> m_matrix_free_operator;
   DoFLinearSystem m_linear_system;
   IItemFamily* m_dof_family = nullptr;
   FemDoFsOnNodes m_dofs_on_nodes;
@@ -94,6 +102,7 @@ class FemModule
   void _doStationarySolve();
   void _getMaterialParameters();
   void _solve();
+  void _solveMultipleRhs();
   void _assembleLinearOperator();
 
   void _updateVariables();
@@ -0,0 +1,327 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* FemModule.cc                                                (C) 2022-2025 */
+/*                                                                           */
+/* Replay of the linear system snapshots written by DoFLinearSystem.         */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include "FemModule.h"
+
+#include <arcane/IParallelMng.h>
+#include <arcane/VariableTypes.h>
+#include <arcane/mesh/DoFFamily.h>
+
+#include <iomanip>
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Reads the snapshot and creates the DoFs and the matrix.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+startInit()
+{
+  info() << "[ArcaneFem-Info] Started module startInit()";
+  Real elapsedTime = platform::getRealTime();
+
+  _readSnapshot();
+  _createDoFs();
+  _buildMatrix();
+  // Kept by the reset of the linear system done before each solve
+  if (options()->solveReportFile.isPresent())
+    m_linear_system.setSolveReportFileName(options()->solveReportFile());
+
+  elapsedTime = platform::getRealTime() - elapsedTime;
+  _printArcaneFemTime("[ArcaneFem-Timer] initialize", elapsedTime);
+}
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Solves the linear system 'nb-repeat' times and stops the code.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+compute()
+{
+  info() << "[ArcaneFem-Info] Started module compute()";
+  Real elapsedTime = platform::getRealTime();
+
+  subDomain()->timeLoopMng()->stopComputeLoop(true);
+
+  const Int32 nb_repeat = options()->nbRepeat();
+  if (nb_repeat < 1)
+    ARCANE_FATAL("Invalid value '{0}' for option 'nb-repeat'", nb_repeat);
+  if (options()->nbRhs() < 1)
+    ARCANE_FATAL("Invalid value '{0}' for option 'nb-rhs'", options()->nbRhs());
+
+  Real min_time = 0.0;
+  Real max_time = 0.0;
+  Real sum_time = 0.0;
+  for (Int32 i = 0; i < nb_repeat; ++i) {
+    _solve();
+    const SolveReport& r = m_linear_system.solveReport();
+    info() << "[Replay-Info] repeat=" << i << " linear_system=" << r.linear_system_name
+           << " nb_iteration=" << r.nb_iteration << " residual=" << r.residual
+           << " converged=" << r.convergedFlag() << " matrix_build_time=" << r.matrix_build_time
+           << " setup_time=" << r.setup_time << " solve_time=" << r.solve_time
+           << " total_time=" << r.total_time;
+    min_time = (i == 0) ? r.total_time : math::min(min_time, r.total_time);
+    max_time = math::max(max_time, r.total_time);
+    sum_time += r.total_time;
+  }
+  _printArcaneFemTime("[ArcaneFem-Timer] replay-min", min_time);
+  _printArcaneFemTime("[ArcaneFem-Timer] replay-max", max_time);
+  _printArcaneFemTime("[ArcaneFem-Timer] replay-average", sum_time / nb_repeat);
+
+  Real difference = _computeSolutionDifference();
+  info() << "[Replay-Info] Maximum relative difference with the solution of the snapshot = " << difference;
+  if (options()->solutionTolerance.isPresent()) {
+    Real tolerance = options()->solutionTolerance();
+    if (difference > tolerance)
+      ARCANE_FATAL("Difference with the solution of the snapshot '{0}' is greater than the tolerance '{1}'",
+                   difference, tolerance);
+  }
+
+  elapsedTime = platform::getRealTime() - elapsedTime;
+  _printArcaneFemTime("[ArcaneFem-Timer] compute", elapsedTime);
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_readSnapshot()
+{
+  IParallelMng* pm = parallelMng();
+  String file_name = LinearSystemSnapshot::binaryFileName(options()->snapshotPrefix(), pm->commRank());
+  info() << "[Replay-Info] Reading snapshot file '" << file_name << "'";
+  m_snapshot.readBinary(file_name);
+  if (m_snapshot.comm_size != pm->commSize() || m_snapshot.comm_rank != pm->commRank())
+    ARCANE_FATAL("Snapshot '{0}' has been written by rank '{1}' of '{2}' ranks (current rank={3} nb_rank={4})",
+                 file_name, m_snapshot.comm_rank, m_snapshot.comm_size, pm->commRank(), pm->commSize());
+  info() << "[Replay-Info] nb_row=" << m_snapshot.nbRow() << " nb_value=" << m_snapshot.nbValue()
+         << " block_size=" << m_snapshot.block_size;
+}
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Creates the DoFs with the unique ids and owners of the snapshot.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_createDoFs()
+{
+  IItemFamily* dof_family_interface = mesh()->findItemFamily(Arcane::IK_DoF, "ReplayDoFFamily", true);
+  mesh::DoFFamily* dof_family = ARCANE_CHECK_POINTER(dynamic_cast<mesh::DoFFamily*>(dof_family_interface));
+  m_dof_family = dof_family_interface;
+
+  const Int32 my_rank = parallelMng()->commRank();
+  const Int32 nb_row = m_snapshot.nbRow();
+  UniqueArray<Int32> own_rows;
+  UniqueArray<Int64> own_uids;
+  UniqueArray<Int32> ghost_rows;
+  UniqueArray<Int64> ghost_uids;
+  UniqueArray<Int32> ghost_owners;
+  for (Int32 r = 0; r < nb_row; ++r) {
+    Int64 uid = m_snapshot.dof_uids[r];
+    if (uid < 0)
+      continue;
+    Int32 owner = m_snapshot.dof_owners[r];
+    if (owner == my_rank) {
+      own_rows.add(r);
+      own_uids.add(uid);
+    }
+    else {
+      ghost_rows.add(r);
+      ghost_uids.add(uid);
+      ghost_owners.add(owner);
+    }
+  }
+
+  UniqueArray<Int32> own_lids(own_uids.size());
+  UniqueArray<Int32> ghost_lids(ghost_uids.size());
+  dof_family->addDoFs(own_uids, own_lids);
+  dof_family->addGhostDoFs(ghost_uids, ghost_lids, ghost_owners);
+  dof_family->endUpdate();
+  dof_family->computeSynchronizeInfos();
+
+  m_snapshot_to_lid.resize(nb_row);
+  m_snapshot_to_lid.fill(-1);
+  for (Int32 i = 0, n = own_rows.size(); i < n; ++i)
+    m_snapshot_to_lid[own_rows[i]] = own_lids[i];
+  for (Int32 i = 0, n = ghost_rows.size(); i < n; ++i)
+    m_snapshot_to_lid[ghost_rows[i]] = ghost_lids[i];
+
+  info() << "[Replay-Info] nb_own_dof=" << own_uids.size() << " nb_ghost_dof=" << ghost_uids.size();
+}
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Builds the CSR matrix with the local ids of the created DoFs.
+ *
+ * The local ids of the DoFs may be different from the ones of the
+ * snapshot so the rows are reordered and the columns are renumbered.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_buildMatrix()
+{
+  const Int32 nb_lid = m_dof_family->maxLocalId();
+  const Int32 nb_row = m_snapshot.nbRow();
+  UniqueArray<Int32> lid_to_snapshot(nb_lid);
+  lid_to_snapshot.fill(-1);
+  for (Int32 r = 0; r < nb_row; ++r)
+    if (m_snapshot_to_lid[r] >= 0)
+      lid_to_snapshot[m_snapshot_to_lid[r]] = r;
+
+  Int32 nb_value = 0;
+  for (Int32 lid = 0; lid < nb_lid; ++lid)
+    if (lid_to_snapshot[lid] >= 0)
+      nb_value += m_snapshot.rows_nb_column[lid_to_snapshot[lid]];
+
+  m_rows.resize(nb_lid);
+  m_rows_nb_column.resize(nb_lid);
+  m_columns.resize(nb_value);
+  m_values.resize(nb_value);
+  m_reference_values.resize(nb_value);
+  Int32 index = 0;
+  for (Int32 lid = 0; lid < nb_lid; ++lid) {
+    m_rows[lid] = index;
+    Int32 r = lid_to_snapshot[lid];
+    Int32 nb_column = (r >= 0) ? m_snapshot.rows_nb_column[r] : 0;
+    m_rows_nb_column[lid] = nb_column;
+    for (Int32 k = 0; k < nb_column; ++k) {
+      Int32 i = m_snapshot.rows[r] + k;
+      Int32 column = m_snapshot.columns[i];
+      m_columns[index] = (column < 0) ? -1 : m_snapshot_to_lid[column];
+      m_reference_values[index] = m_snapshot.values[i];
+      ++index;
+    }
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Builds the linear system from the snapshot and solves it.
+ *
+ * The linear system is created again at each call so that each solve
+ * includes the setup of the solver. The values of the matrix are copied
+ * so that each solve starts from the values of the snapshot.
+ *
+ * If 'nb-rhs' is greater than 1, the RHS of the snapshot is put in all the
+ * columns of the RHS array variable and they are solved together with
+ * solveMultipleRhs(). The solution of the last RHS is then checked.
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_solve()
+{
+  m_linear_system.reset();
+  m_linear_system.setLinearSystemFactory(options()->linearSystem());
+  m_linear_system.initialize(subDomain(), acceleratorMng()->defaultRunner(), m_dof_family, "Replay");
+  // Do not write again the snapshot which is replayed
+  m_linear_system.setSnapshotFormat(eLinearSystemSnapshotFormat::None);
+  m_linear_system.setBlockSize(m_snapshot.block_size);
+
+  VariableDoFReal& rhs_variable(m_linear_system.rhsVariable());
+  VariableDoFReal& solution_variable(m_linear_system.solutionVariable());
+  VariableDoFBool& forced_info(m_linear_system.getForcedInfo());
+  VariableDoFReal& forced_value(m_linear_system.getForcedValue());
+  VariableDoFByte& elimination_info(m_linear_system.getEliminationInfo());
+  VariableDoFReal& elimination_value(m_linear_system.getEliminationValue());
+  for (Int32 r = 0, n = m_snapshot.nbRow(); r < n; ++r) {
+    Int32 lid = m_snapshot_to_lid[r];
+    if (lid < 0)
+      continue;
+    DoFLocalId dof(lid);
+    rhs_variable[dof] = m_snapshot.rhs[r];
+    solution_variable[dof] = m_snapshot.initial_solution[r];
+    forced_info[dof] = (m_snapshot.forced_info[r] != 0);
+    forced_value[dof] = m_snapshot.forced_value[r];
+    elimination_info[dof] = m_snapshot.elimination_info[r];
+    elimination_value[dof] = m_snapshot.elimination_value[r];
+  }
+
+  for (Int32 i = 0, n = m_reference_values.size(); i < n; ++i)
+    m_values[i] = m_reference_values[i];
+
+  CSRFormatView csr_view(m_rows.to1DSpan(), m_rows_nb_column.to1DSpan(), m_columns.to1DSpan(), m_values.to1DSpan());
+  m_linear_system.setCSRValues(csr_view);
+
+  const Int32 nb_rhs = options()->nbRhs();
+  if (nb_rhs == 1) {
+    m_linear_system.solve();
+    return;
+  }
+
+  if (!m_linear_system.hasSolveMultipleRhs())
+    ARCANE_FATAL("Option 'nb-rhs' is not supported by linear system '{0}'", options()->linearSystem.serviceName());
+  m_linear_system.setNbRhs(nb_rhs);
+  VariableDoFArrayReal& rhs_array(m_linear_system.rhsArrayVariable());
+  VariableDoFArrayReal& solution_array(m_linear_system.solutionArrayVariable());
+  ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
+    for (Int32 k = 0; k < nb_rhs; ++k) {
+      rhs_array[idof][k] = rhs_variable[idof];
+      solution_array[idof][k] = solution_variable[idof];
+    }
+  }
+  m_linear_system.solveMultipleRhs();
+  ENUMERATE_ (DoF, idof, m_dof_family->allItems()) {
+    solution_variable[idof] = solution_array[idof][nb_rhs - 1];
+  }
+}
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Maximum difference between the computed solution and the one of
+ * the snapshot, relative to the maximum of the solution of the snapshot.
+ */
+/*---------------------------------------------------------------------------*/
+
+Real FemModule::
+_computeSolutionDifference()
+{
+  const Int32 my_rank = parallelMng()->commRank();
+  VariableDoFReal& solution_variable(m_linear_system.solutionVariable());
+  Real max_difference = 0.0;
+  Real max_reference = 0.0;
+  for (Int32 r = 0, n = m_snapshot.nbRow(); r < n; ++r) {
+    Int32 lid = m_snapshot_to_lid[r];
+    if (lid < 0 || m_snapshot.dof_owners[r] != my_rank)
+      continue;
+    Real reference = m_snapshot.solution[r];
+    max_difference = math::max(max_difference, math::abs(solution_variable[DoFLocalId(lid)] - reference));
+    max_reference = math::max(max_reference, math::abs(reference));
+  }
+  max_difference = parallelMng()->reduce(Parallel::ReduceMax, max_difference);
+  max_reference = parallelMng()->reduce(Parallel::ReduceMax, max_reference);
+  return (max_reference > 0.0) ? (max_difference / max_reference) : max_difference;
+}
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Function to prints the execution time `value` of phase `label`
+ */
+/*---------------------------------------------------------------------------*/
+
+void FemModule::
+_printArcaneFemTime(const String label, const Real value)
+{
+  info() << std::left << std::setw(40) << label << " = " << value;
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+ARCANE_REGISTER_MODULE_FEM(FemModule);
@@ -0,0 +1,92 @@
+﻿// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+//-----------------------------------------------------------------------------
+// Copyright 2000-2025 CEA (www.cea.fr) IFPEN (www.ifpenergiesnouvelles.com)
+// See the top-level COPYRIGHT file for details.
+// SPDX-License-Identifier: Apache-2.0
+//-----------------------------------------------------------------------------
+/*---------------------------------------------------------------------------*/
+/* FemModule.h                                                 (C) 2022-2025 */
+/*                                                                           */
+/* FemModule class definition.                                               */
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+#ifndef FEMMODULES_H
+#define FEMMODULES_H
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+#include <arcane/utils/NumArray.h>
+
+#include <arcane/ITimeLoopMng.h>
+#include <arcane/IMesh.h>
+#include <arcane/IItemFamily.h>
+#include <arcane/ICaseMng.h>
+
+#include "arcane/accelerator/core/IAcceleratorMng.h"
+
+#include "IDoFLinearSystemFactory.h"
+#include "Fem_axl.h"
+#include "DoFLinearSystem.h"
+#include "LinearSystemSnapshot.h"
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
+using namespace Arcane;
+using namespace Arcane::FemUtils;
+
+/*---------------------------------------------------------------------------*/
+/**
+ * @brief Module to solve again a linear system written by DoFLinearSystem.
+ *
+ * The snapshot of each rank is read and its DoFs are created with the same
+ * unique ids and owners. Then the linear system is built from the CSR
+ * matrix of the snapshot and solved 'nb-repeat' times with the linear
+ * system service of the case. The mesh of the case is not used so any
+ * small mesh can be given but the number of ranks has to be the same as
+ * the one used to write the snapshot.
+ */
+/*---------------------------------------------------------------------------*/
+
+class FemModule
+: public ArcaneFemObject
+{
+ public:
+
+  explicit FemModule(const ModuleBuildInfo& mbi)
+  : ArcaneFemObject(mbi)
+  {
+    ICaseMng* cm = mbi.subDomain()->caseMng();
+    cm->setTreatWarningAsError(true);
+    cm->setAllowUnkownRootElelement(false);
+  }
+
+  void startInit() override; //! Method called at the beginning of the simulation
+  void compute() override; //! Method called at each iteration
+  VersionInfo versionInfo() const override { return VersionInfo(1, 0, 0); }
+
+ private:
+
+  DoFLinearSystem m_linear_system;
+  IItemFamily* m_dof_family = nullptr;
+  LinearSystemSnapshot m_snapshot;
+
+  //! Local id of the DoF for each row of the snapshot (-1 if no DoF)
+  UniqueArray<Int32> m_snapshot_to_lid;
+  //! CSR matrix of the snapshot using the local ids of m_dof_family
+  NumArray<Int32, MDDim1> m_rows;
+  NumArray<Int32, MDDim1> m_rows_nb_column;
+  NumArray<Int32, MDDim1> m_columns;
+  UniqueArray<Real> m_reference_values;
+  NumArray<Real, MDDim1> m_values;
+
+  void _readSnapshot();
+  void _createDoFs();
+  void _buildMatrix();
+  void _solve();
+  Real _computeSolutionDifference();
+
+  void _printArcaneFemTime(const String label, const Real value);
+};
+
+#endif
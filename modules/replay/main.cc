@@ -0,0 +1,13 @@
+// -*- tab-width: 2; indent-tabs-mode: nil; coding: utf-8-with-signature -*-
+#include <arcane/launcher/ArcaneLauncher.h>
+
+using namespace Arcane;
+
+int main(int argc, char* argv[])
+{
+  ArcaneLauncher::init(CommandLineArguments(&argc, &argv));
+  auto& app_build_info = ArcaneLauncher::applicationBuildInfo();
+  app_build_info.setCodeName("Replay");
+  app_build_info.setCodeVersion(VersionInfo(1, 0, 0));
+  return ArcaneLauncher::run();
+}
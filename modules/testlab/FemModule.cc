@@ -50,6 +50,25 @@ void FemModule::_dumpTimeStats()
 
   m_time_stats->dumpStatsJSON(json_writer);
 
+  if (m_spmv_bandwidth > 0.0)
+    json_writer.write("spmvBandwidthGBs", m_spmv_bandwidth);
+
+  {
+    // Report of the last linear solve (all solves are in 'solve-report-file' if present)
+    const SolveReport& report = m_linear_system.solveReport();
+    JSONWriter::Object o(json_writer, "solveReport");
+    json_writer.write("linearSystem", report.linear_system_name);
+    json_writer.write("nbRhs", report.nb_rhs);
+    json_writer.write("nbIteration", report.nb_iteration);
+    json_writer.write("residual", report.residual);
+    json_writer.write("isConverged", report.convergedFlag());
+    json_writer.write("matrixBuildTime", report.matrix_build_time);
+    json_writer.write("setupTime", report.setup_time);
+    json_writer.write("solveTime", report.solve_time);
+    json_writer.write("totalTime", report.total_time);
+    json_writer.write("nbTransferredByte", report.nb_transferred_byte);
+  }
+
   json_writer.endObject();
 
   dump_file << json_writer.getBuffer();
@@ -78,6 +97,8 @@ compute()
   m_linear_system.setLinearSystemFactory(options()->linearSystem());
 
   m_linear_system.initialize(subDomain(), acceleratorMng()->defaultRunner(), m_dofs_on_nodes.dofFamily(), "Solver");
+  if (options()->solveReportFile.isPresent())
+    m_linear_system.setSolveReportFileName(options()->solveReportFile());
   // Test for adding parameters for PETSc.
   // This is only used for the first call.
   {
@@ -117,6 +138,12 @@ startInit()
   //if (m_queue.isAcceleratorPolicy())
   //m_queue.setMemoryRessource(eMemoryRessource::Device);
 
+  // The DoFs have to be created before the BSR sparsity which follows their numbering
+  TimeStart = platform::getRealTime();
+  m_dofs_on_nodes.initialize(mesh(), 1, FemDoFsOnNodes::renumberingFromName(options()->nodeRenumbering()));
+  m_dof_family = m_dofs_on_nodes.dofFamily();
+  info() << "[ArcaneFem-Timer] Time to initialize DOFs = " << (platform::getRealTime() - TimeStart);
+
   {
     IMesh* mesh = defaultMesh();
     if (mesh->dimension() == 3) {
@@ -139,18 +166,19 @@ startInit()
       info() << "Number of edge: nb_edge=" << m_nb_edge;
     }
 
-    if (options()->bsr || options()->bsrAtomicFree()) {
-      bool use_csr_in_linear_system = options()->linearSystem.serviceName() == "HypreLinearSystem";
-      m_bsr_format.initialize(mesh, use_csr_in_linear_system, options()->bsrAtomicFree);
+    if (options()->bsr || options()->bsrAtomicFree() || options()->bsrColored()) {
+      String linear_system_name = options()->linearSystem.serviceName();
+      bool use_csr_in_linear_system = linear_system_name == "HypreLinearSystem" || linear_system_name == "AlephLinearSystem" || linear_system_name == "NativeLinearSystem";
+      auto assembly_strategy = eBSRAssemblyStrategy::Atomic;
+      if (options()->bsrColored())
+        assembly_strategy = eBSRAssemblyStrategy::Colored;
+      else if (options()->bsrAtomicFree())
+        assembly_strategy = (options()->bsrElementCache()) ? eBSRAssemblyStrategy::AtomicFreeCached : eBSRAssemblyStrategy::AtomicFree;
+      m_bsr_format.initialize(mesh, use_csr_in_linear_system, assembly_strategy);
       m_bsr_format.computeSparsity();
     }
   }
 
-  TimeStart = platform::getRealTime();
-  m_dofs_on_nodes.initialize(mesh(), 1);
-  m_dof_family = m_dofs_on_nodes.dofFamily();
-  info() << "[ArcaneFem-Timer] Time to initialize DOFs = " << (platform::getRealTime() - TimeStart);
-
   _handleFlags();
 
   TimeStart = platform::getRealTime();
@@ -250,6 +278,10 @@ _handleFlags()
     m_use_bsr_atomic_free = true;
     m_use_legacy = false;
   }
+  if (options()->bsrColored()) {
+    m_use_bsr_colored = true;
+    m_use_legacy = false;
+  }
   info() << "-----------------------------------------------------------------------------------------";
 }
 
@@ -293,16 +325,34 @@ _doStationarySolve()
 
   auto dim = mesh()->dimension();
 
-  if (m_use_bsr || m_use_bsr_atomic_free) {
+  if (m_use_bsr || m_use_bsr_atomic_free || m_use_bsr_colored) {
     UnstructuredMeshConnectivityView m_connectivity_view(mesh());
     auto cn_cv = m_connectivity_view.cellNode();
     auto command = makeCommand(m_queue);
     auto in_node_coord = ax::viewIn(command, m_node_coord);
 
-    if (dim == 2)
-      m_bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return computeElementMatrixTria3(cell_lid, cn_cv, in_node_coord); });
-    else
-      m_bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return computeElementMatrixTetra4(cell_lid, cn_cv, in_node_coord); });
+    String timer_name = "AssembleBilinearOperator_Bsr";
+    if (m_use_bsr_colored)
+      timer_name = "AssembleBilinearOperator_BsrColored";
+    else if (m_use_bsr_atomic_free)
+      timer_name = "AssembleBilinearOperator_BsrAtomicFree";
+
+    auto assemble_bsr = [&]() {
+      Timer::Action timer_bili(m_time_stats, timer_name);
+      m_bsr_format.resetMatrixValues();
+      if (dim == 2)
+        m_bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return computeElementMatrixTria3(cell_lid, cn_cv, in_node_coord); });
+      else
+        m_bsr_format.assembleBilinear([=] ARCCORE_HOST_DEVICE(CellLocalId cell_lid) { return computeElementMatrixTetra4(cell_lid, cn_cv, in_node_coord); });
+    };
+    assemble_bsr();
+    if (m_cache_warming != 1)
+      m_time_stats->resetStats(timer_name);
+    for (auto i = 1; i < m_cache_warming; ++i)
+      assemble_bsr();
+
+    if (options()->bsrSpmvBenchmark() > 0)
+      _benchmarkBsrSpmv(options()->bsrSpmvBenchmark());
 
     _assembleLinearOperator(&(m_bsr_format.matrix()));
     m_bsr_format.toLinearSystem(m_linear_system);
@@ -1886,6 +1936,46 @@ _build()
 /*---------------------------------------------------------------------------*/
 /*---------------------------------------------------------------------------*/
 
+/*!
+ * \brief Benchmark the product of the assembled BSR matrix by a vector.
+ *
+ * The bandwidth is computed from the minimal number of bytes moved by
+ * one product (see BSRMatrix::spmvNbTransferredByte()).
+ */
+void FemModule::
+_benchmarkBsrSpmv(Int32 nb_product)
+{
+  BSRMatrix<1>& bsr_matrix = m_bsr_format.matrix();
+  Int32 nb_dof = bsr_matrix.nbRow();
+
+  NumArray<Real, MDDim1> x(m_queue.memoryRessource());
+  x.resize(nb_dof);
+  x.fill(1.0, &m_queue);
+  NumArray<Real, MDDim1> y(m_queue.memoryRessource());
+  y.resize(nb_dof);
+
+  // First product is not timed (memory allocation and kernel loading)
+  bsr_matrix.spmv(x.to1DSpan(), y.to1DSpan());
+  m_queue.barrier();
+
+  Real start_time = platform::getRealTime();
+  {
+    Timer::Action timer_spmv(m_time_stats, "SpmvBsr");
+    for (Int32 i = 0; i < nb_product; ++i)
+      bsr_matrix.spmv(x.to1DSpan(), y.to1DSpan());
+    m_queue.barrier();
+  }
+  Real elapsed_time = platform::getRealTime() - start_time;
+
+  Real nb_byte = static_cast<Real>(bsr_matrix.spmvNbTransferredByte()) * nb_product;
+  m_spmv_bandwidth = (elapsed_time > 0.0) ? nb_byte / (elapsed_time * 1.0e9) : 0.0;
+  info() << "[ArcaneFem-Info] BSR SpMV: nb_product=" << nb_product << " time=" << elapsed_time
+         << " bandwidth=" << m_spmv_bandwidth << " GB/s";
+}
+
+/*---------------------------------------------------------------------------*/
+/*---------------------------------------------------------------------------*/
+
 void FemModule::
 _checkResultFile()
 {
@@ -174,9 +174,12 @@ class FemModule
   bool m_use_legacy = true;
   bool m_use_bsr = false;
   bool m_use_bsr_atomic_free = false;
+  bool m_use_bsr_colored = false;
   bool m_running_on_gpu = false;
   bool m_solve_linear_system = true;
   bool m_cross_validation = true;
+  //! Bandwidth in GB/s reached by the BSR SpMV benchmark (0 if not done)
+  Real m_spmv_bandwidth = 0.0;
 
   ITimeStats* m_time_stats;
 
@@ -219,6 +222,7 @@ class FemModule
   void _applyDirichletBoundaryConditions();
   void _checkResultFile();
   void _dumpTimeStats();
+  void _benchmarkBsrSpmv(Int32 nb_product);
   FixedMatrix<3, 3> _computeElementMatrixTRIA3(Cell cell);
   FixedMatrix<4, 4> _computeElementMatrixTETRA4(Cell cell);
   Real _computeAreaTriangle3(Cell cell);
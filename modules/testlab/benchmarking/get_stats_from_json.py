@@ -31,10 +31,11 @@ def load_metrics(config_path):
         sys.exit(1)
 
 def main(file_path, metrics=None, config_path=None):
-    formats = ["legacy", "coo", "coo-sorting", "coo-gpu", "coo-sorting-gpu", "csr", "csr-gpu", "nwcsr", "blcsr"]
+    formats = ["legacy", "coo", "coo-sorting", "coo-gpu", "coo-sorting-gpu", "csr", "csr-gpu", "nwcsr", "blcsr", "bsr", "bsr-atomic-free", "bsr-colored"]
     formats_maj = [
         "Legacy", "Coo", "CooSort", "Coo_Gpu", "CooSort_Gpu", 
-        "Csr", "Csr_Gpu", "CsrNodeWise", "CsrBuildLess"
+        "Csr", "Csr_Gpu", "CsrNodeWise", "CsrBuildLess",
+        "Bsr", "BsrAtomicFree", "BsrColored"
     ]
 
     """If there is a format in the metrics given by the user, we only
@@ -94,6 +95,10 @@ def main(file_path, metrics=None, config_path=None):
 
             output.append('') # newline between formats
 
+    if 'spmvBandwidthGBs' in obj:
+        output.append('{0: <50}'.format("SpmvBsr bandwidth (GB/s):") + f"{obj['spmvBandwidthGBs']}")
+        output.append('')
+
     output.pop() # remove last newline
 
     for line in output:
@@ -19,6 +19,9 @@ CPU_FORMATS=("legacy" "coo" "csr")
 MPI_N_ACCELERATED=(1 2 4 8)
 GPU_FORMATS=("coo-gpu" "csr-gpu" "nwcsr" "blcsr")
 
+# BSR formats use their own assembly and solve so each one is run in a separate test
+BSR_FORMATS=("bsr" "bsr-atomic-free" "bsr-colored")
+
 DIMENSIONS=(2 3)
 TEMPLATE_FILENAMES=("$(pwd)/TEST_TEMPLATE_2D.xml" "$(pwd)/TEST_TEMPLATE_3D.xml")
 SIZES=("small" "medium" "large")
@@ -49,6 +52,7 @@ SRUN_ARGS_TO_ADD_IF_ACCELERATED="--gpus=1"
 
 ALL_CPU_FORMATS=("legacy" "coo" "coo-sorting" "csr")
 ALL_GPU_FORMATS=("coo-gpu" "coo-sorting-gpu" "csr-gpu" "blcsr" "nwcsr")
+ALL_BSR_FORMATS=("bsr" "bsr-atomic-free" "bsr-colored")
 
 error_exit() {
     echo -e "\e[31m$1\e[0m"
@@ -95,7 +99,7 @@ run_test() {
 process_results() {
     local brief_file="$1" res_file="$2"; shift; shift
     formats=("$@")
-    local line=$(grep "Element" "$brief_file" | awk '{print $2}')
+    local line=$(grep -m1 "Element" "$brief_file" | awk '{print $2}')
     for format in "${formats[@]}"; do
         local time=$(grep "AssembleBilinearOperator_${format}:" "$brief_file" | awk '{print $2}')
         line+="\t${time:-NaN}"
@@ -139,6 +143,7 @@ log_configuration() {
         echo "MPI Accelerated Configurations: ${MPI_N_ACCELERATED[*]}"
         echo "CPU Formats: ${CPU_FORMATS[*]}"
         echo "GPU Formats: ${GPU_FORMATS[*]}"
+        echo "BSR Formats: ${BSR_FORMATS[*]}"
         echo "Dimensions: ${DIMENSIONS[*]}"
         echo "Mesh Sizes: ${SIZES[*]}"
         echo "Adastra Configuration: $IS_ADASTRA"
@@ -183,11 +188,11 @@ for dim in "${DIMENSIONS[@]}"; do
     if $accelerated; then
       mpi_array=("${MPI_N_ACCELERATED[@]}")
       format_array=("${GPU_FORMATS[@]}")
-      all_format_array=("${ALL_GPU_FORMATS[@]}")
+      all_format_array=("${ALL_GPU_FORMATS[@]}" "${ALL_BSR_FORMATS[@]}")
     else
       mpi_array=("${MPI_N[@]}")
       format_array=("${CPU_FORMATS[@]}" "${GPU_FORMATS[@]}")
-      all_format_array=("${ALL_CPU_FORMATS[@]}" "${ALL_GPU_FORMATS[@]}")
+      all_format_array=("${ALL_CPU_FORMATS[@]}" "${ALL_GPU_FORMATS[@]}" "${ALL_BSR_FORMATS[@]}")
     fi
 
     for mpi_n in "${mpi_array[@]}"; do
@@ -221,6 +226,18 @@ for dim in "${DIMENSIONS[@]}"; do
         run_test "$EXECUTABLE" "$test_file" "$mpi_n" $accelerated "$CACHE_WARMING" || error_exit "\nTest $test_file failed."
         mv "./output/listing/time_stats.json" "./"
         python "$PYTHON_SCRIPT" "./time_stats.json" "BuildMatrix,AddAndCompute" > "brief.txt" || error_exit "An error occured in ${PYTHON_SCRIPT}."
+        clear_output
+
+        for bsr_format in "${BSR_FORMATS[@]}"; do
+          bsr_test_file="${test_name}.${bsr_format}.arc"
+          replace_placeholders "${!template_var}" "$mesh_file" "$bsr_test_file"
+          append_formats "$bsr_test_file" "$bsr_format"
+          run_test "$EXECUTABLE" "$bsr_test_file" "$mpi_n" $accelerated "$CACHE_WARMING" || error_exit "\nTest $bsr_test_file failed."
+          mv "./output/listing/time_stats.json" "./time_stats.${bsr_format}.json"
+          python "$PYTHON_SCRIPT" "./time_stats.${bsr_format}.json" "BuildMatrix,AddAndCompute" >> "brief.txt" || error_exit "An error occured in ${PYTHON_SCRIPT}."
+          clear_output
+        done
+
         process_results "./brief.txt" "../$res_file" "${all_format_array[@]}"
         clear_output
         echo "Done"